@@ -1,6 +1,7 @@
 import org.gradle.api.tasks.testing.logging.TestExceptionFormat
 import org.gradle.api.tasks.testing.logging.TestLogEvent
 import org.jetbrains.kotlin.gradle.ExperimentalKotlinGradlePluginApi
+import org.jetbrains.kotlin.gradle.targets.native.tasks.KotlinNativeTest
 
 plugins {
     id("kotlin-common")
@@ -19,6 +20,27 @@ kotlin {
         }
     }
 
+    linuxX64 {
+        binaries {
+            executable {
+                entryPoint = "main"
+            }
+            // Native executables, the test one included, read built-in headers from the 'compot-includes' directory next to them.
+            all {
+                val includes = project(":compot").file("src/commonMain/resources/compot-includes")
+                val installDir = outputDirectory.resolve("compot-includes")
+                linkTaskProvider.configure {
+                    doLast {
+                        copy {
+                            from(includes)
+                            into(installDir)
+                        }
+                    }
+                }
+            }
+        }
+    }
+
     sourceSets {
         commonTest {
             dependencies {
@@ -60,6 +82,12 @@ tasks.withType(Test::class.java).all {
     }
 }
 
+tasks.withType(KotlinNativeTest::class.java).all {
+    workingDir = projectDir.absolutePath
+    mkdir("test-results")
+    environment("TEST_RESULT_DIR", "test-results")
+}
+
 task("makeDist") {
     group = "distribution"
     dependsOn("allTests")
@@ -2,6 +2,10 @@ import startup.*
 
 
 fun main(args: Array<String>) {
+    if (runServiceMode(args)) {
+        return
+    }
+
     val cli = CompotCommandLineParser.parse(args) ?: return
     CompotDriver(cli).run()
-}
\ No newline at end of file
+}
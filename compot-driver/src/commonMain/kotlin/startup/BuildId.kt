@@ -0,0 +1,8 @@
+package startup
+
+
+/**
+ * Hash of the compiler binaries. Cached objects are keyed by it, so a rebuilt compiler never reuses
+ * objects generated by another build.
+ */
+internal expect fun compilerBuildId(): String
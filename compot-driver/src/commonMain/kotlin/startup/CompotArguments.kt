@@ -1,7 +1,9 @@
 package startup
 
 import common.Extension
+import common.FileUtils
 import common.ProcessedFile
+import ir.platform.x64.MArch
 import logging.CommonLogger
 
 enum class LinkageType {
@@ -10,7 +12,13 @@ enum class LinkageType {
 }
 
 
-class CompotArguments {
+/**
+ * @param workingDirectory directory relative paths are resolved against,
+ * the compiler process working directory is used when null.
+ * @param environment environment of the assembler and the linker,
+ * the compiler process environment is used when null.
+ */
+class CompotArguments(private val workingDirectory: String? = null, private val environment: Map<String, String>? = null) {
     private val includeDirectories = hashSetOf<String>()
     private val defines = hashMapOf<String, String>()
     private var preprocessOnly = false
@@ -20,23 +28,57 @@ class CompotArguments {
     private val libraryDirectories = hashSetOf<String>()
     private var inputs = arrayListOf<ProcessedFile>()
     private var pic = false
+    private var inBlockCalls = false
+    private var omitFramePointer = false
+    private var optimizeSiblingCalls = false
+    private var verboseAsm = false
+    private var march = MArch.DEFAULT
+    private var parserMemoization = false
+    private var streamFunctions = false
+    private var lto = false
     private var linkage: LinkageType? = null
     private val extraLDFlags = arrayListOf<String>()
 
     private var dumpIrDirectoryOutput: String? = null
+    private var cacheDirectory: String? = null
+    private var cacheMaxSize = ObjectFileCache.DEFAULT_MAX_SIZE
     private var optimizationLevel = 0
-    private var outFilename = DEFAULT_OUTPUT
+    private var outFilename: ProcessedFile? = null
+
+    private fun resolve(path: String): String {
+        if (workingDirectory == null) {
+            return path
+        }
+
+        return FileUtils.resolve(workingDirectory, path)
+    }
 
     fun inputs(): List<ProcessedFile> = inputs
 
+    fun workingDirectory(): String? = workingDirectory
+
+    fun environment(): Map<String, String>? = environment
+
     fun setDumpIrDirectory(out: String) {
-        dumpIrDirectoryOutput = out
+        dumpIrDirectoryOutput = resolve(out)
     }
 
     fun getDumpIrDirectory(): String? = dumpIrDirectoryOutput
 
+    fun setCacheDirectory(directory: String) {
+        cacheDirectory = resolve(directory)
+    }
+
+    fun getCacheDirectory(): String? = cacheDirectory
+
+    fun setCacheMaxSize(size: Long) {
+        cacheMaxSize = size
+    }
+
+    fun getCacheMaxSize(): Long = cacheMaxSize
+
     fun setOutputFilename(name: String) {
-        outFilename = ProcessedFile.fromFilename(name)
+        outFilename = ProcessedFile.fromFilename(resolve(name))
     }
 
     fun setOptLevel(level: Int) {
@@ -45,7 +87,9 @@ class CompotArguments {
 
     fun getOptLevel(): Int = optimizationLevel
 
-    fun getOutputFilename(): ProcessedFile = outFilename
+    fun getOutputFilename(): ProcessedFile = outFilename ?: ProcessedFile.fromFilename(resolve(DEFAULT_OUTPUT.filename))
+
+    fun hasOutputFilename(): Boolean = outFilename != null
 
     fun setDumpDefines(dumpDefines: Boolean) {
         this.dumpDefines = dumpDefines
@@ -62,14 +106,14 @@ class CompotArguments {
     }
 
     fun setInputFileName(executableFileName: String) {
-        inputs.add(ProcessedFile.fromFilename(executableFileName))
+        inputs.add(ProcessedFile.fromFilename(resolve(executableFileName)))
     }
 
     fun isPreprocessOnly(): Boolean = preprocessOnly
     fun isDumpDefines(): Boolean = dumpDefines
 
     fun addIncludeDirectory(directory: String) {
-        includeDirectories.add(directory)
+        includeDirectories.add(resolve(directory))
     }
 
     fun addDefine(name: String, value: String) {
@@ -87,7 +131,7 @@ class CompotArguments {
     fun getDynamicLibraries(): Set<String> = dynamicLibraries
 
     fun addLibraryDirectory(directory: String) {
-        libraryDirectories.add(directory)
+        libraryDirectories.add("-L" + resolve(directory))
     }
 
     fun getLibraryDirectories(): Set<String> = libraryDirectories
@@ -100,6 +144,70 @@ class CompotArguments {
         this.pic = pic
     }
 
+    fun inBlockCalls(): Boolean {
+        return inBlockCalls
+    }
+
+    fun setInBlockCalls(enabled: Boolean) {
+        inBlockCalls = enabled
+    }
+
+    fun omitFramePointer(): Boolean {
+        return omitFramePointer
+    }
+
+    fun setOmitFramePointer(enabled: Boolean) {
+        omitFramePointer = enabled
+    }
+
+    fun optimizeSiblingCalls(): Boolean {
+        return optimizeSiblingCalls
+    }
+
+    fun setOptimizeSiblingCalls(enabled: Boolean) {
+        optimizeSiblingCalls = enabled
+    }
+
+    fun verboseAsm(): Boolean {
+        return verboseAsm
+    }
+
+    fun setVerboseAsm(enabled: Boolean) {
+        verboseAsm = enabled
+    }
+
+    fun march(): MArch {
+        return march
+    }
+
+    fun setMArch(march: MArch) {
+        this.march = march
+    }
+
+    fun parserMemoization(): Boolean {
+        return parserMemoization
+    }
+
+    fun setParserMemoization(enabled: Boolean) {
+        parserMemoization = enabled
+    }
+
+    fun streamFunctions(): Boolean {
+        return streamFunctions
+    }
+
+    fun setStreamFunctions(enabled: Boolean) {
+        streamFunctions = enabled
+    }
+
+    fun lto(): Boolean {
+        return lto
+    }
+
+    fun setLto(enabled: Boolean) {
+        lto = enabled
+    }
+
     fun linkage(): LinkageType? {
         return linkage
     }
@@ -108,6 +216,9 @@ class CompotArguments {
         this.linkage = linkage
     }
 
+    /**
+     * Paths in [flags] are relative to [workingDirectory], the linker runs there.
+     */
     fun addExtraLDFlags(flags: List<String>) {
         extraLDFlags.addAll(flags)
     }
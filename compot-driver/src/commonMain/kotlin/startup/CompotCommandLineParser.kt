@@ -1,11 +1,13 @@
 package startup
 
+import ir.platform.x64.MArch
+
 
 object CompotCommandLineParser {
-    private fun loop(args: Array<String>): CompotArguments? {
+    private fun loop(args: Array<String>, workingDirectory: String?, environment: Map<String, String>?): CompotArguments? {
         var cursor = 0
 
-        val commandLineArguments = CompotArguments()
+        val commandLineArguments = CompotArguments(workingDirectory, environment)
         while (cursor < args.size) {
             when (val arg = args[cursor]) {
                 "-h", "--help" -> {
@@ -22,6 +24,23 @@ object CompotCommandLineParser {
                     cursor++
                     commandLineArguments.setDumpIrDirectory(args[cursor])
                 }
+                "--cache-dir" -> {
+                    if (cursor + 1 >= args.size) {
+                        println("Expected cache directory after --cache-dir")
+                        return null
+                    }
+                    cursor++
+                    commandLineArguments.setCacheDirectory(args[cursor])
+                }
+                "--cache-max-size" -> {
+                    val size = args.getOrNull(cursor + 1)?.toLongOrNull()
+                    if (size == null || size < 0) {
+                        println("Expected size in bytes after --cache-max-size")
+                        return null
+                    }
+                    cursor++
+                    commandLineArguments.setCacheMaxSize(size)
+                }
                 "-o" -> {
                     if (cursor + 1 >= args.size) {
                         println("Expected output filename after -o")
@@ -32,12 +51,28 @@ object CompotCommandLineParser {
                 }
                 "-static" -> commandLineArguments.setLinkage(LinkageType.STATIC)
                 "-fPIC" -> commandLineArguments.setPic(true)
+                "--in-block-calls" -> commandLineArguments.setInBlockCalls(true)
+                "-fomit-frame-pointer" -> commandLineArguments.setOmitFramePointer(true)
+                "-fno-omit-frame-pointer" -> commandLineArguments.setOmitFramePointer(false)
+                "-foptimize-sibling-calls" -> commandLineArguments.setOptimizeSiblingCalls(true)
+                "-fno-optimize-sibling-calls" -> commandLineArguments.setOptimizeSiblingCalls(false)
+                "-fverbose-asm" -> commandLineArguments.setVerboseAsm(true)
+                "-flto" -> commandLineArguments.setLto(true)
+                "-fno-lto" -> commandLineArguments.setLto(false)
                 "-E" -> commandLineArguments.setPreprocessOnly(true)
+                "--parser-memoization" -> commandLineArguments.setParserMemoization(true)
+                "--stream-functions" -> commandLineArguments.setStreamFunctions(true)
                 else -> parseOption(commandLineArguments, arg)
             }
             cursor++
         }
 
+        if (commandLineArguments.lto() && commandLineArguments.isCompile()) {
+            // Objects carry no IR, so separately compiled files can't be merged into one module later.
+            ignoreOption("-flto")
+            commandLineArguments.setLto(false)
+        }
+
         return commandLineArguments
     }
 
@@ -61,7 +96,15 @@ object CompotCommandLineParser {
             cli.addLibrary(arg)
 
         } else if (arg.startsWith("-L")) {
-            cli.addLibraryDirectory(arg)
+            cli.addLibraryDirectory(arg.substring(2))
+
+        } else if (arg.startsWith("-march=")) {
+            val march = MArch.of(arg.substring("-march=".length))
+            if (march != null) {
+                cli.setMArch(march)
+            } else {
+                ignoreOption(arg)
+            }
 
         } else if (arg.startsWith("-Wl,")) {
             val linkerOption = arg.substring(4).split(",")
@@ -82,8 +125,7 @@ object CompotCommandLineParser {
         if (arg.startsWith("-f") ||
             arg.startsWith("-fno-") ||
             arg.startsWith("-std=") ||
-            arg.startsWith("-W") ||
-            arg.startsWith("-march=")) {
+            arg.startsWith("-W")) {
             return true
         }
 
@@ -94,13 +136,13 @@ object CompotCommandLineParser {
         println("Ignoring option: $arg")
     }
 
-    fun parse(args: Array<String>): CompotArguments? {
+    fun parse(args: Array<String>, workingDirectory: String? = null, environment: Map<String, String>? = null): CompotArguments? {
         if (args.isEmpty()) {
             printHelp()
             return null
         }
 
-        return loop(args)
+        return loop(args, workingDirectory, environment)
     }
 
     private fun parseDefine(cli: CompotArguments, define: String) {
@@ -130,12 +172,24 @@ object CompotCommandLineParser {
         println("  -O0                       Disable optimizations")
         println("  -O1                       Enable optimizations")
         println("  --dump-ir                 Dump IR to files")
+        println("  --cache-dir <directory>   Reuse object files of previously compiled identical inputs")
+        println("  --cache-max-size <bytes>  Evict least recently used objects above the size, 512 MiB by default")
+        println("  --in-block-calls          Don't split basic blocks on calls after lowering")
+        println("  -fomit-frame-pointer      Don't keep the frame pointer in leaf functions")
+        println("  -foptimize-sibling-calls  Replace calls in tail position by jumps")
+        println("  -fverbose-asm             Annotate generated assembly with IR instructions")
+        println("  -flto                     Optimize all C inputs as a single module when linking")
+        println("  -march=<arch>             Generate code for the given architecture, e.g. x86-64-v3")
         println("  -o <filename>             Specify output filename")
         println("  -I <directory>            Add include directory")
         println("  -D <macro>                Predefine name as a macro, with definition 1.")
         println("  -D <macro>=<value>        Predefine name as a macro, with definition value.")
         println("  -h, --help                Print this help message")
         println("  -E                        Preprocess only; do not compile, assemble or link")
+        println("  --parser-memoization      Memoize backtracking-prone parser rules")
+        println("  --stream-functions        Compile each function as soon as it is parsed")
+        println("  --daemon [socket]         Serve compilation requests on a Unix socket")
+        println("  --connect <socket> ...    Forward the remaining arguments to a compiler daemon")
     }
 
     private val IGNORED_OPTIONS = hashSetOf(
@@ -5,25 +5,31 @@ import common.Extension
 import common.FileUtils
 import common.GNULdRunner
 import common.ProcessedFile
+import common.copyFile
+import common.readTextFile
 import preprocess.*
+import ir.link.ModuleLinker
 import ir.module.Module
 import ir.module.SSAModule
 import tokenizer.CTokenizer
+import tokenizer.SymbolTable
 import parser.CProgramParser
 import preprocess.macros.MacroReplacement
 import tokenizer.TokenList
 import tokenizer.TokenPrinter
-import java.io.FileInputStream
-import java.nio.file.Path
 import kotlin.collections.iterator
-import kotlin.io.path.copyTo
 import kotlin.random.Random
 
 
-class CompotDriver(private val cli: CompotArguments) {
+/**
+ * Preprocessed tokens of a translation unit with the symbol table they were interned in.
+ */
+private class PreprocessedUnit(val tokens: TokenList, val symbols: SymbolTable)
+
+class CompotDriver(private val cli: CompotArguments, private val headerCache: HeaderCache? = null) {
     private fun definedMacros(ctx: PreprocessorContext) {
         for ((name, value) in cli.getDefines()) {
-            val tokens      = CTokenizer.apply(value, "<input>")
+            val tokens      = CTokenizer.apply(value, "<input>", ctx.symbols())
             val replacement = MacroReplacement(name, tokens)
             ctx.define(replacement)
         }
@@ -33,20 +39,18 @@ class CompotDriver(private val cli: CompotArguments) {
         val usrDir = SystemConfig.systemHeadersPaths()
         val includeDirectories = cli.getIncludeDirectories() + usrDir
         val workingDirectory   = FileUtils.getDirName(filename)
-        val headerHolder       = FileHeaderHolder(includeDirectories + workingDirectory)
+        val headerHolder       = FileHeaderHolder(includeDirectories + workingDirectory, headerCache)
 
         val ctx = PreprocessorContext.create(headerHolder)
         definedMacros(ctx)
         return ctx
     }
 
-    private fun preprocess(filename: String): TokenList? {
-        val source = FileInputStream(filename).use { inputStream ->
-            inputStream.readBytes().decodeToString()
-        }
+    private fun preprocess(filename: String): PreprocessedUnit? {
+        val source = readTextFile(filename)
         val ctx = initializePreprocessorContext(filename)
 
-        val tokens              = CTokenizer.apply(source, filename)
+        val tokens              = CTokenizer.apply(source, filename, ctx.symbols())
         val preprocessor        = CProgramPreprocessor.create(filename, tokens, ctx)
         val postProcessedTokens = preprocessor.preprocess()
 
@@ -65,7 +69,7 @@ class CompotDriver(private val cli: CompotArguments) {
             println(TokenPrinter.print(postProcessedTokens))
             return null
         } else {
-            return postProcessedTokens
+            return PreprocessedUnit(postProcessedTokens, ctx.symbols())
         }
     }
 
@@ -75,20 +79,39 @@ class CompotDriver(private val cli: CompotArguments) {
             .setFilename(inputFilename.withExtension(Extension.IR))
             .setOptLevel(cli.getOptLevel())
             .setDumpIrDirectory(cli.getDumpIrDirectory())
-            .setOutputFilename(ProcessedFile.fromFilename(file.toString()))
+            .setOutputFilename(ProcessedFile.fromFilename(file))
             .setPic(cli.pic())
+            .setInBlockCalls(cli.inBlockCalls())
+            .setOmitFramePointer(cli.omitFramePointer())
+            .setOptimizeSiblingCalls(cli.optimizeSiblingCalls())
+            .setVerboseAsm(cli.verboseAsm())
+            .setMArch(cli.march())
+            .setWorkingDirectory(cli.workingDirectory())
+            .setEnvironment(cli.environment())
     }
 
-    private fun compile(filename: String): SSAModule? {
-        val postProcessedTokens = preprocess(filename)?: return null
-
-        val parser     = CProgramParser.build(filename, postProcessedTokens)
+    private fun compile(filename: String, unit: PreprocessedUnit): SSAModule {
+        val parser     = CProgramParser.build(filename, unit.tokens, unit.symbols, cli.parserMemoization())
         val program    = parser.translation_unit()
         val typeHolder = parser.globalTypeHolder()
         return GenerateIR.apply(typeHolder, program)
     }
 
-    private fun runLD(out: ProcessedFile, compiledFiles: List<ProcessedFile>, crtObjs: List<String>) {
+    private fun compileStreaming(input: ProcessedFile, unit: PreprocessedUnit): ProcessedFile? {
+        val parser   = CProgramParser.build(input.filename, unit.tokens, unit.symbols, cli.parserMemoization())
+        val irStream = GenerateIR.stream(parser.globalTypeHolder())
+        return OptDriver.compileStreaming(makeOptCLIArguments(input)) { emit ->
+            parser.translation_unit { node ->
+                val module = irStream.generate(node)
+                if (module != null) {
+                    emit(module)
+                }
+            }
+            irStream.finish()
+        }
+    }
+
+    private fun runLD(out: ProcessedFile, compiledFiles: List<ProcessedFile>, crtObjs: List<String>): Int {
         logDebug { "Linking files: $compiledFiles" }
         val result = GNULdRunner(out)
             .libs(SystemConfig.runtimeLibraries() + cli.getDynamicLibraries())
@@ -99,11 +122,35 @@ class CompotDriver(private val cli: CompotArguments) {
             .crtObjects(crtObjs)
             .objs(compiledFiles)
             .dynamicLinker(SystemConfig.dynamicLinker())
+            .workingDirectory(cli.workingDirectory())
+            .environment(cli.environment())
             .execute()
 
         if (result.exitCode != 0) {
             println("Error: ${result.error}")
         }
+        return result.exitCode
+    }
+
+    /**
+     * The cache is bypassed when IR is dumped, because a cache hit skips the IR generation.
+     */
+    private fun objectFileCache(): ObjectFileCache? {
+        val directory = cli.getCacheDirectory() ?: return null
+        if (cli.getDumpIrDirectory() != null) {
+            return null
+        }
+
+        return ObjectFileCache(directory, cli.getCacheMaxSize())
+    }
+
+    private fun compileTokens(input: ProcessedFile, unit: PreprocessedUnit): ProcessedFile? {
+        return if (cli.streamFunctions()) {
+            compileStreaming(input, unit)
+        } else {
+            val module = compile(input.filename, unit)
+            OptDriver.compile(makeOptCLIArguments(input), module)
+        }
     }
 
     private fun compileCFile(input: ProcessedFile): ProcessedFile? {
@@ -111,26 +158,67 @@ class CompotDriver(private val cli: CompotArguments) {
             "Compiling file: $input"
         }
 
-        val module = compile(input.filename) ?: return null
-        val cli = makeOptCLIArguments(input)
-        val objFile = OptDriver.compile(cli, module)
+        val unit = preprocess(input.filename) ?: return null
+        val cache = objectFileCache()
+        if (cache == null) {
+            val objFile = compileTokens(input, unit) ?: return null
+            logDebug {
+                "Compiled file: $objFile"
+            }
+            return objFile
+        }
+
+        val key = cache.key(unit.tokens, cli)
+        val cached = cache.lookup(key, input)
+        if (cached != null) {
+            logDebug {
+                "Reused cached object: $key"
+            }
+            return cached
+        }
+
+        val objFile = compileTokens(input, unit) ?: return null
+        cache.store(key, objFile)
+        logDebug {
+            "Compiled file: $objFile, cached as: $key"
+        }
+        return objFile
+    }
+
+    /**
+     * Compiles C inputs as a single module, so that optimizations see across translation units.
+     * Only `main` stays visible when the executable is linked from C files alone.
+     */
+    private fun compileWholeProgram(inputs: List<ProcessedFile>, otherInputs: List<ProcessedFile>): ProcessedFile? {
+        val modules = arrayListOf<SSAModule>()
+        for (input in inputs) {
+            logDebug {
+                "Compiling file: $input"
+            }
+
+            val unit = preprocess(input.filename) ?: return null
+            modules.add(compile(input.filename, unit))
+        }
+
+        val out = cli.getOutputFilename()
+        val exported = if (out.extension == Extension.EXE && otherInputs.isEmpty()) setOf("main") else null
+        val module = ModuleLinker.link(modules, exported)
+        val objFile = OptDriver.compile(makeOptCLIArguments(out), module)
         logDebug {
-            "Compiled file: $objFile"
+            "Compiled files: $inputs to $objFile"
         }
         return objFile
     }
 
     private fun compileCFiles(compiled: List<ProcessedFile>) {
         val output = cli.getOutputFilename()
-        if (output != CompotArguments.DEFAULT_OUTPUT) {
+        if (cli.hasOutputFilename()) {
             val src = compiled.first()
             logDebug {
                 "Copying file: $src to $output"
             }
 
-            val srsPath = Path.of(src.filename)
-            val dstPath = Path.of(output.filename)
-            srsPath.copyTo(dstPath, overwrite = true)
+            copyFile(src.filename, output.filename)
             return
         }
 
@@ -147,20 +235,28 @@ class CompotDriver(private val cli: CompotArguments) {
                 "Copying file: $src to $dst"
             }
 
-            val srsPath = Path.of(src)
-            val dstPath = Path.of(dst.filename)
-            srsPath.copyTo(dstPath, overwrite = true)
+            copyFile(src, dst.filename)
         }
     }
 
-    fun run() { //TODo: move some actions to separate class LDDriver
+    /**
+     * Returns the exit code of the compilation: non-zero when the linker fails.
+     * Compilation errors are reported by exceptions.
+     */
+    fun run(): Int { //TODo: move some actions to separate class LDDriver
         val processedFiles = arrayListOf<ProcessedFile>()
         val compiled = arrayListOf<ProcessedFile>()
+        val wholeProgram = arrayListOf<ProcessedFile>()
         for (input in cli.inputs()) {
             when (input.extension) {
                 Extension.AR -> processedFiles.add(input)
                 Extension.OBJ -> processedFiles.add(input)
                 Extension.C -> {
+                    if (cli.lto()) {
+                        wholeProgram.add(input)
+                        continue
+                    }
+
                     val objFile = compileCFile(input) ?: continue
                     compiled.add(objFile)
                 }
@@ -168,9 +264,13 @@ class CompotDriver(private val cli: CompotArguments) {
             }
         }
 
+        if (wholeProgram.isNotEmpty()) {
+            compiled.add(compileWholeProgram(wholeProgram, processedFiles) ?: return 0)
+        }
+
         if (cli.isCompile()) {
             compileCFiles(compiled)
-            return
+            return 0
         }
 
         val out = cli.getOutputFilename()
@@ -184,7 +284,7 @@ class CompotDriver(private val cli: CompotArguments) {
             else -> throw IllegalStateException("Invalid output file extension: $out")
         }
 
-        runLD(out, compiled + processedFiles, crt)
+        return runLD(out, compiled + processedFiles, crt)
     }
 
     fun logDebug(message: () -> String) {
@@ -0,0 +1,103 @@
+package startup
+
+import common.FileUtils
+import common.ProcessedFile
+import common.Sha256
+import common.copyFile
+import common.createDirectories
+import common.createTempFile
+import common.deleteFile
+import common.fileExists
+import common.fileSize
+import common.lastModified
+import common.listDirectory
+import common.renameFile
+import common.touchFile
+import tokenizer.TokenList
+import tokenizer.TokenPrinter
+import kotlin.random.Random
+
+
+/**
+ * Object files of the compiled translation units, addressed by the hash of the compiler build, the preprocessed
+ * tokens and the options affecting code generation.
+ * Entries are published by renaming a completed file, so concurrent compilations never observe partial objects.
+ * Least recently used entries are evicted when the total size exceeds [maxSize].
+ */
+class ObjectFileCache(private val directory: String, private val maxSize: Long = DEFAULT_MAX_SIZE) {
+    init {
+        createDirectories(directory)
+    }
+
+    private fun entry(key: String): String = FileUtils.resolve(directory, "$key$ENTRY_SUFFIX")
+
+    fun key(tokens: TokenList, cli: CompotArguments): String {
+        return Sha256()
+            .update(compilerBuildId())
+            .update("\u0000O${cli.getOptLevel()}")
+            .update("\u0000pic=${cli.pic()}")
+            .update("\u0000inBlockCalls=${cli.inBlockCalls()}")
+            .update("\u0000omitFramePointer=${cli.omitFramePointer()}")
+            .update("\u0000optimizeSiblingCalls=${cli.optimizeSiblingCalls()}")
+            .update("\u0000verboseAsm=${cli.verboseAsm()}")
+            .update("\u0000march=${cli.march()}")
+            .update("\u0000streamFunctions=${cli.streamFunctions()}")
+            .update("\u0000")
+            .update(TokenPrinter.print(tokens))
+            .hexDigest()
+    }
+
+    /**
+     * Returns a private copy of the cached object, or null on a miss.
+     */
+    fun lookup(key: String, input: ProcessedFile): ProcessedFile? {
+        val cached = entry(key)
+        if (!fileExists(cached)) {
+            return null
+        }
+
+        val objFile = createTempFile(input.basename() + Random.nextInt() + ".o")
+        try {
+            copyFile(cached, objFile)
+        } catch (e: Exception) {
+            // The entry has been evicted by a concurrent compilation.
+            deleteFile(objFile)
+            return null
+        }
+
+        touchFile(cached)
+        return ProcessedFile.fromFilename(objFile)
+    }
+
+    fun store(key: String, objFile: ProcessedFile) {
+        val tmp = FileUtils.resolve(directory, "$key${Random.nextInt().toUInt()}$TMP_SUFFIX")
+        copyFile(objFile.filename, tmp)
+        renameFile(tmp, entry(key))
+        evict()
+    }
+
+    private fun evict() {
+        val entries = listDirectory(directory).filter { it.endsWith(ENTRY_SUFFIX) }
+        var totalSize = entries.sumOf { fileSize(it) }
+        if (totalSize <= maxSize) {
+            return
+        }
+
+        for (entry in entries.sortedBy { lastModified(it) }) {
+            if (totalSize <= maxSize) {
+                break
+            }
+
+            val size = fileSize(entry)
+            if (deleteFile(entry)) {
+                totalSize -= size
+            }
+        }
+    }
+
+    companion object {
+        const val DEFAULT_MAX_SIZE = 512L * 1024 * 1024
+        private const val ENTRY_SUFFIX = ".o"
+        private const val TMP_SUFFIX = ".tmp"
+    }
+}
@@ -0,0 +1,8 @@
+package startup
+
+
+/**
+ * Handles `--daemon` and `--connect` modes of the compiler.
+ * Returns false if [args] describe an ordinary compilation.
+ */
+internal expect fun runServiceMode(args: Array<String>): Boolean
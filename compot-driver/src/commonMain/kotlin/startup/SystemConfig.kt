@@ -1,8 +1,7 @@
 package startup
 
-import java.nio.file.Path
-import kotlin.io.path.exists
-import kotlin.io.path.listDirectoryEntries
+import common.fileExists
+import common.listDirectory
 
 
 // Mini FAQ about the misc libc/gcc crt files.
@@ -10,13 +9,11 @@ import kotlin.io.path.listDirectoryEntries
 internal object SystemConfig {
     fun systemHeadersPaths(): List<String> {
         val paths = arrayListOf<String>()
-        val usrIncludeGNUPath = Path.of(USR_INCLUDE_GNU_LINUX_PATH)
-        if (usrIncludeGNUPath.exists()) {
+        if (fileExists(USR_INCLUDE_GNU_LINUX_PATH)) {
             paths.add(USR_INCLUDE_GNU_LINUX_PATH)
         }
 
-        val usrIncludePath = Path.of(USR_INCLUDE_PATH)
-        if (usrIncludePath.exists()) {
+        if (fileExists(USR_INCLUDE_PATH)) {
             paths.add(USR_INCLUDE_PATH)
         }
 
@@ -24,14 +21,12 @@ internal object SystemConfig {
     }
 
     private fun findCrtStaticObjectPaths(path: String): List<String>? {
-        val crtObjectPathRh = Path.of(path)
-        if (!crtObjectPathRh.exists()) {
+        if (!fileExists(path)) {
             return null
         }
 
         val objs = crtCommonStaticObjects.map { "$path$it" }
-        val first = Path.of(objs.first())
-        if (!first.exists()) {
+        if (!fileExists(objs.first())) {
             return null
         }
 
@@ -62,14 +57,12 @@ internal object SystemConfig {
     }
 
     private fun findCrtSharedObjectPaths(path: String): List<String>? {
-        val crtObjectPathRh = Path.of(path)
-        if (!crtObjectPathRh.exists()) {
+        if (!fileExists(path)) {
             return null
         }
 
         val objs = crtCommonSharedObjects.map { "$path$it" }
-        val first = Path.of(objs.first())
-        if (!first.exists()) {
+        if (!fileExists(objs.first())) {
             return null
         }
 
@@ -88,16 +81,11 @@ internal object SystemConfig {
     }
 
     private fun findCrtPath(path: String): String? {
-        val crtObjectPath = Path.of(path)
-        if (!crtObjectPath.exists()) {
+        if (!fileExists(path)) {
             return null
         }
 
-        val crtPath = crtObjectPath
-            .listDirectoryEntries()
-            .first()
-
-        return crtPath.toString()
+        return listDirectory(path).first()
     }
 
     private fun crtPath(): String {
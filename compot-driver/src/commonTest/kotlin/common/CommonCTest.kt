@@ -2,7 +2,6 @@ package common
 
 import startup.CompotDriver
 import startup.CompotCommandLineParser
-import java.io.FileInputStream
 import kotlin.random.Random
 
 
@@ -31,9 +30,7 @@ abstract class CommonCTest: CommonTest() {
 
     protected fun readExpectedOutput(filename: String): String {
         val path = "$TESTCASES_DIR/expected_out/$filename"
-        return FileInputStream(path).use { inputStream ->
-            inputStream.readBytes().decodeToString()
-        }
+        return readTextFile(path)
     }
 
     private fun compileObject(filename: String, basename: String, optOptions: List<String>, runtimeLib: List<String>) {
@@ -336,4 +336,8 @@ class AgoTestsO1: AlgoTests() {
 
 class AlgoTestO1fPIC: AlgoTests() {
     override fun options(): List<String> = listOf("-O1", "-fPIC")
-}
\ No newline at end of file
+}
+
+class AlgoTestsO1StreamFunctions: AlgoTests() {
+    override fun options(): List<String> = listOf("-O1", "--stream-functions")
+}
@@ -0,0 +1,33 @@
+package compot
+
+import common.CommonCTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+
+abstract class BuiltinTest: CommonCTest() {
+    @Test
+    fun testBitManipulation() {
+        val result = runCTest("compot/builtin/builtin1", listOf(), options())
+        assertEquals("8 4 16\n9 0 0\n44332211 1000000000000ff bbaa\n", result.output)
+        assertReturnCode(result, 0)
+    }
+
+    @Test
+    fun testMemoryAndExpect() {
+        val result = runCTest("compot/builtin/builtin2", listOf(), options())
+        assertEquals("0 7 0 10 -1\n" + "a".repeat(39) + "\n", result.output)
+        assertReturnCode(result, 0)
+    }
+}
+
+class BuiltinTestsO0: BuiltinTest() {
+    override fun options(): List<String> = listOf()
+}
+
+class BuiltinTestsO1: BuiltinTest() {
+    override fun options(): List<String> = listOf("-O1")
+}
+
+class BuiltinTestsPopcntO1: BuiltinTest() {
+    override fun options(): List<String> = listOf("-O1", "-march=x86-64-v2")
+}
@@ -0,0 +1,75 @@
+package compot
+
+import common.CommonCTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+
+
+abstract class CallTests: CommonCTest() {
+    @Test
+    fun testRecursive() {
+        val result = runCTest("compot/calls/recursive", listOf(), options())
+        assertEquals("21 1 1 6765\n", result.output)
+        assertReturnCode(result, 0)
+    }
+
+    @Test
+    fun testVariadic() {
+        val result = runCTest("compot/calls/variadic", listOf(), options())
+        assertEquals("sum: 10\n8 chars\n1.5 2\n", result.output)
+        assertReturnCode(result, 6)
+    }
+
+    @Test
+    fun testStackArguments() {
+        val result = runCTest("compot/calls/stackArguments", listOf(), options())
+        assertEquals("36 43 51 -972\n", result.output)
+        assertReturnCode(result, 0)
+    }
+
+    @Test
+    fun testResultUsed() {
+        val result = runCTest("compot/calls/resultUsed", listOf(), options())
+        assertEquals("49 2402 21 0.75 19\n", result.output)
+        assertReturnCode(result, 14)
+    }
+
+    @Test
+    fun testSpills() {
+        val result = runCTest("compot/calls/spills", listOf(), options())
+        assertEquals("507988 49\n", result.output)
+        assertReturnCode(result, 0)
+    }
+}
+
+class CallTestsO0: CallTests() {
+    override fun options(): List<String> = listOf()
+}
+
+class CallTestsO1: CallTests() {
+    override fun options(): List<String> = listOf("-O1")
+}
+
+class CallTestsO1InBlockCalls: CallTests() {
+    override fun options(): List<String> = listOf("-O1", "--in-block-calls")
+}
+
+class CallTestsO0OmitFramePointer: CallTests() {
+    override fun options(): List<String> = listOf("-fomit-frame-pointer")
+}
+
+class CallTestsO1OmitFramePointer: CallTests() {
+    override fun options(): List<String> = listOf("-O1", "-fomit-frame-pointer")
+}
+
+class CallTestsO0SiblingCalls: CallTests() {
+    override fun options(): List<String> = listOf("-foptimize-sibling-calls")
+}
+
+class CallTestsO1SiblingCalls: CallTests() {
+    override fun options(): List<String> = listOf("-O1", "-foptimize-sibling-calls")
+}
+
+class CallTestsO1AllCallOptions: CallTests() {
+    override fun options(): List<String> = listOf("-O1", "--in-block-calls", "-fomit-frame-pointer", "-foptimize-sibling-calls")
+}
\ No newline at end of file
@@ -769,4 +769,16 @@ class FunTestsO1: FunTests() {
 
 class FunTestsO1fPIC: FunTests() {
     override fun options(): List<String> = listOf("-O1", "-fPIC")
+}
+
+class FunTestsO1InBlockCalls: FunTests() {
+    override fun options(): List<String> = listOf("-O1", "--in-block-calls")
+}
+
+class FunTestsO1OmitFramePointer: FunTests() {
+    override fun options(): List<String> = listOf("-O1", "-fomit-frame-pointer")
+}
+
+class FunTestsO1SiblingCalls: FunTests() {
+    override fun options(): List<String> = listOf("-O1", "-foptimize-sibling-calls")
 }
\ No newline at end of file
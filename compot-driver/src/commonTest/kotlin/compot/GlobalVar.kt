@@ -171,4 +171,8 @@ class GlobalVarO0: GlobalVar() {
 
 class GlobalVarO1: GlobalVar() {
     override fun options(): List<String> = listOf("-O1")
-}
\ No newline at end of file
+}
+
+class GlobalVarO1StreamFunctions: GlobalVar() {
+    override fun options(): List<String> = listOf("-O1", "--stream-functions")
+}
@@ -0,0 +1,48 @@
+package compot
+
+import common.CommonTest
+import common.runCommand
+import startup.CompotCommandLineParser
+import startup.CompotDriver
+import kotlin.random.Random
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFalse
+
+
+abstract class LtoTests: CommonTest() {
+    abstract fun options(): List<String>
+
+    private fun parse(args: List<String>) = CompotCommandLineParser.parse(args.toTypedArray())
+        ?: throw RuntimeException("Failed to parse arguments: $args")
+
+    private fun link(sources: List<String>): String {
+        val output = "$TEST_OUTPUT_DIR/lto${Random.nextInt()}.out"
+        val args = sources.map { "$TESTCASES_DIR/compot/lto/$it.c" } + options() + listOf("-flto", "-o", output)
+
+        assertEquals(0, CompotDriver(parse(args)).run())
+        return output
+    }
+
+    @Test
+    fun testStaticAndExternAcrossFiles() {
+        val output = link(listOf("main", "helper"))
+        val result = runCommand("./$output", listOf(), null)
+        assertEquals("41 42 420 helper main\n", result.output)
+        assertEquals(10, result.exitCode)
+    }
+
+    @Test
+    fun testIgnoredWithCompile() {
+        val cli = parse(listOf("-c", "-flto", "$TESTCASES_DIR/compot/lto/helper.c"))
+        assertFalse(cli.lto())
+    }
+}
+
+class LtoTestsO0: LtoTests() {
+    override fun options(): List<String> = listOf()
+}
+
+class LtoTestsO1: LtoTests() {
+    override fun options(): List<String> = listOf("-O1")
+}
\ No newline at end of file
@@ -61,4 +61,16 @@ class ManyArgumentsTestO0: ManyArgumentsTest() {
 
 class ManyArgumentsTestO1: ManyArgumentsTest() {
     override fun options(): List<String> = listOf("-O1")
+}
+
+class ManyArgumentsTestO1InBlockCalls: ManyArgumentsTest() {
+    override fun options(): List<String> = listOf("-O1", "--in-block-calls")
+}
+
+class ManyArgumentsTestO1OmitFramePointer: ManyArgumentsTest() {
+    override fun options(): List<String> = listOf("-O1", "-fomit-frame-pointer")
+}
+
+class ManyArgumentsTestO1SiblingCalls: ManyArgumentsTest() {
+    override fun options(): List<String> = listOf("-O1", "-foptimize-sibling-calls")
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+package compot
+
+import common.CommonTest
+import common.listDirectory
+import common.readBinaryFile
+import common.runCommand
+import common.writeBinaryFile
+import startup.CompotCommandLineParser
+import startup.CompotDriver
+import kotlin.random.Random
+import kotlin.test.Test
+import kotlin.test.assertContentEquals
+import kotlin.test.assertEquals
+
+
+class ObjectFileCacheTest: CommonTest() {
+    private fun compileObject(output: String, cacheOptions: List<String>) {
+        val args = arrayOf("-c", "$TESTCASES_DIR/compot/hello_world/hello_world.c") +
+                cacheOptions +
+                listOf("-o", "$output.o")
+
+        val cli = CompotCommandLineParser.parse(args) ?: throw RuntimeException("Failed to parse arguments: $args")
+        CompotDriver(cli).run()
+    }
+
+    @Test
+    fun testReuseCachedObject() {
+        val cacheDir = "$TEST_OUTPUT_DIR/object_cache${Random.nextInt()}"
+        val first = "$TEST_OUTPUT_DIR/hello_world_cache${Random.nextInt()}"
+        val second = "$TEST_OUTPUT_DIR/hello_world_cache${Random.nextInt()}"
+
+        compileObject(first, listOf("--cache-dir", cacheDir))
+        compileObject(second, listOf("--cache-dir", cacheDir))
+        assertEquals(1, listDirectory(cacheDir).size)
+        assertContentEquals(readBinaryFile("$first.o"), readBinaryFile("$second.o"))
+
+        runGCC(second, listOf())
+        val result = runCommand("./$second.out", listOf(), null)
+        assertEquals("Hello, World!\n", result.output)
+        assertEquals(0, result.exitCode)
+    }
+
+    @Test
+    fun testCacheHitSkipsCompilation() {
+        val cacheDir = "$TEST_OUTPUT_DIR/object_cache${Random.nextInt()}"
+        val first = "$TEST_OUTPUT_DIR/hello_world_cache${Random.nextInt()}"
+        val second = "$TEST_OUTPUT_DIR/hello_world_cache${Random.nextInt()}"
+
+        compileObject(first, listOf("--cache-dir", cacheDir))
+        // A compiled object never has this content, so the second output can only come from the cache.
+        val marker = "cached object".encodeToByteArray()
+        writeBinaryFile(listDirectory(cacheDir).single(), marker)
+
+        compileObject(second, listOf("--cache-dir", cacheDir))
+        assertContentEquals(marker, readBinaryFile("$second.o"))
+    }
+
+    @Test
+    fun testEvictAboveMaxSize() {
+        val cacheDir = "$TEST_OUTPUT_DIR/object_cache${Random.nextInt()}"
+        val output = "$TEST_OUTPUT_DIR/hello_world_cache${Random.nextInt()}"
+
+        compileObject(output, listOf("--cache-dir", cacheDir, "--cache-max-size", "0"))
+        assertEquals(0, listDirectory(cacheDir).size)
+
+        runGCC(output, listOf())
+        val result = runCommand("./$output.out", listOf(), null)
+        assertEquals("Hello, World!\n", result.output)
+    }
+}
@@ -124,4 +124,16 @@ class VarArgsTestsO0: VarArgsTests() {
 
 class VarArgsTestsO1: VarArgsTests() {
     override fun options(): List<String> = listOf("-O1")
+}
+
+class VarArgsTestsO1InBlockCalls: VarArgsTests() {
+    override fun options(): List<String> = listOf("-O1", "--in-block-calls")
+}
+
+class VarArgsTestsO1OmitFramePointer: VarArgsTests() {
+    override fun options(): List<String> = listOf("-O1", "-fomit-frame-pointer")
+}
+
+class VarArgsTestsO1SiblingCalls: VarArgsTests() {
+    override fun options(): List<String> = listOf("-O1", "-foptimize-sibling-calls")
 }
\ No newline at end of file
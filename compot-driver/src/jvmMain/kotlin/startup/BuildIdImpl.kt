@@ -0,0 +1,26 @@
+package startup
+
+import codegen.GenerateIR
+import common.Sha256
+import ir.module.SSAModule
+import java.io.File
+
+
+// Code generation lives in these modules, the stdlib and the test classes don't affect the objects.
+private val buildId: String by lazy {
+    val modules = listOf(CompotDriver::class.java, OptDriver::class.java, GenerateIR::class.java, SSAModule::class.java)
+    val sha = Sha256()
+    for (location in modules.mapNotNull { it.protectionDomain.codeSource?.location }.distinct()) {
+        // A jar in the distribution, a class directory when running from the build tree.
+        val root = File(location.toURI())
+        for (file in root.walkTopDown().filter { it.isFile }.sortedBy { it.path }) {
+            sha.update(file.relativeTo(root).path)
+                .update("\u0000")
+                .update(file.readBytes())
+        }
+    }
+
+    sha.hexDigest()
+}
+
+internal actual fun compilerBuildId(): String = buildId
@@ -0,0 +1,42 @@
+package startup
+
+import common.pwd
+import java.io.BufferedInputStream
+import java.io.BufferedOutputStream
+import java.io.DataInputStream
+import java.io.DataOutputStream
+import java.net.UnixDomainSocketAddress
+import java.nio.channels.Channels
+import java.nio.channels.SocketChannel
+import java.nio.file.Path
+
+
+/**
+ * Thin client of [CompotDaemon]: forwards arguments, the working directory and the environment,
+ * prints the compiler output and returns the exit code of the compilation.
+ */
+object CompotClient {
+    fun run(socketPath: Path, args: List<String>): Int {
+        SocketChannel.open(UnixDomainSocketAddress.of(socketPath)).use { channel ->
+            val output = DataOutputStream(BufferedOutputStream(Channels.newOutputStream(channel)))
+            CompotRequest(Path.of(pwd()).normalize().toString(), System.getenv(), args).write(output)
+            output.flush()
+
+            val input = DataInputStream(BufferedInputStream(Channels.newInputStream(channel)))
+            while (true) {
+                when (input.readByte()) {
+                    DaemonProtocol.OUTPUT_FRAME -> {
+                        val bytes = ByteArray(input.readInt())
+                        input.readFully(bytes)
+                        System.out.write(bytes)
+                    }
+                    DaemonProtocol.EXIT_FRAME -> {
+                        System.out.flush()
+                        return input.readInt()
+                    }
+                    else -> throw IllegalStateException("Malformed daemon response")
+                }
+            }
+        }
+    }
+}
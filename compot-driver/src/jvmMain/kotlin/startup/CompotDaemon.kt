@@ -0,0 +1,127 @@
+package startup
+
+import preprocess.HeaderCache
+import java.io.*
+import java.net.StandardProtocolFamily
+import java.net.UnixDomainSocketAddress
+import java.nio.channels.AsynchronousCloseException
+import java.nio.channels.Channels
+import java.nio.channels.ServerSocketChannel
+import java.nio.channels.SocketChannel
+import java.nio.file.Files
+import java.nio.file.Path
+import java.util.concurrent.ExecutorService
+import java.util.concurrent.Executors
+
+
+/**
+ * Long-living compiler process serving [CompotClient] requests on a Unix domain socket.
+ * It keeps JIT-compiled code and the header cache warm between compilations.
+ * Every request is compiled on its own thread with its own [CompotArguments] and [CompotDriver],
+ * its output is redirected to the requesting client.
+ */
+class CompotDaemon private constructor(private val socketPath: Path, private val server: ServerSocketChannel) {
+    private val executor: ExecutorService = Executors.newCachedThreadPool()
+    private val headerCache = HeaderCache()
+
+    fun serve() {
+        try {
+            while (true) {
+                val channel = server.accept()
+                executor.execute { handle(channel) }
+            }
+        } catch (e: AsynchronousCloseException) {
+            // Daemon is closed.
+        } finally {
+            executor.shutdown()
+            Files.deleteIfExists(socketPath)
+        }
+    }
+
+    fun close() {
+        server.close()
+    }
+
+    private fun handle(channel: SocketChannel) = channel.use {
+        val input  = DataInputStream(BufferedInputStream(Channels.newInputStream(channel)))
+        val output = DataOutputStream(BufferedOutputStream(Channels.newOutputStream(channel)))
+
+        val request  = CompotRequest.read(input)
+        val exitCode = RequestOutput.redirect(PrintStream(OutputFrameStream(output), true)) {
+            compile(request)
+        }
+
+        output.writeByte(DaemonProtocol.EXIT_FRAME.toInt())
+        output.writeInt(exitCode)
+        output.flush()
+    }
+
+    /**
+     * Arguments the parser rejects or that request no compilation, such as `--help`, fail the request,
+     * so that the client never treats a missing output file as a success.
+     */
+    private fun compile(request: CompotRequest): Int {
+        return try {
+            val cli = CompotCommandLineParser.parse(request.args.toTypedArray(), request.workingDirectory, request.environment) ?: return 1
+            CompotDriver(cli, headerCache).run()
+        } catch (e: Throwable) {
+            e.printStackTrace(System.out)
+            1
+        }
+    }
+
+    companion object {
+        fun create(socketPath: Path): CompotDaemon {
+            Files.deleteIfExists(socketPath)
+            val server = ServerSocketChannel.open(StandardProtocolFamily.UNIX)
+            server.bind(UnixDomainSocketAddress.of(socketPath))
+            RequestOutput.install()
+            return CompotDaemon(socketPath, server)
+        }
+    }
+}
+
+/**
+ * Compiler reports diagnostics with plain println. The daemon replaces [System.out] with a stream
+ * that forwards output of a request thread to the client of that request.
+ */
+private object RequestOutput {
+    private val current = ThreadLocal<PrintStream>()
+    private val default = System.out
+
+    private val dispatcher = object : OutputStream() {
+        private fun target(): PrintStream = current.get() ?: default
+
+        override fun write(b: Int) {
+            target().write(b)
+        }
+
+        override fun write(b: ByteArray, off: Int, len: Int) {
+            target().write(b, off, len)
+        }
+
+        override fun flush() {
+            target().flush()
+        }
+    }
+
+    @Synchronized
+    fun install() {
+        if (System.out !== default) {
+            return
+        }
+
+        System.setOut(PrintStream(dispatcher, true))
+    }
+
+    fun <T> redirect(out: PrintStream, block: () -> T): T {
+        current.set(out)
+        try {
+            return block()
+        } finally {
+            System.out.flush()
+            out.flush()
+            current.remove()
+        }
+    }
+}
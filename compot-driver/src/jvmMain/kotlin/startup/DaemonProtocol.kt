@@ -0,0 +1,81 @@
+package startup
+
+import java.io.DataInputStream
+import java.io.DataOutputStream
+import java.io.OutputStream
+import java.nio.file.Path
+
+
+// Wire format of the compiler daemon.
+//
+// Request:  working directory, variable count, environment variables as name/value pairs,
+//           argument count, arguments; all strings are modified UTF-8.
+// Response: sequence of frames, each one starts with a tag byte:
+//   OUTPUT_FRAME <length: Int> <bytes> - chunk of the compiler output
+//   EXIT_FRAME   <code: Int>           - compilation is finished, always the last frame
+internal object DaemonProtocol {
+    const val OUTPUT_FRAME: Byte = 1
+    const val EXIT_FRAME: Byte   = 2
+
+    fun defaultSocketPath(): Path {
+        val user = System.getProperty("user.name") ?: "user"
+        return Path.of(System.getProperty("java.io.tmpdir"), "compot-$user.sock")
+    }
+}
+
+internal class CompotRequest(val workingDirectory: String, val environment: Map<String, String>, val args: List<String>) {
+    fun write(out: DataOutputStream) {
+        out.writeUTF(workingDirectory)
+        out.writeInt(environment.size)
+        for ((name, value) in environment) {
+            out.writeUTF(name)
+            out.writeUTF(value)
+        }
+        out.writeInt(args.size)
+        for (arg in args) {
+            out.writeUTF(arg)
+        }
+    }
+
+    companion object {
+        fun read(input: DataInputStream): CompotRequest {
+            val workingDirectory = input.readUTF()
+            val variables = input.readInt()
+            val environment = linkedMapOf<String, String>()
+            repeat(variables) {
+                environment[input.readUTF()] = input.readUTF()
+            }
+
+            val size = input.readInt()
+            val args = arrayListOf<String>()
+            repeat(size) {
+                args.add(input.readUTF())
+            }
+
+            return CompotRequest(workingDirectory, environment, args)
+        }
+    }
+}
+
+/**
+ * Wraps everything written into it in output frames of the daemon response.
+ */
+internal class OutputFrameStream(private val out: DataOutputStream): OutputStream() {
+    override fun write(b: Int) {
+        write(byteArrayOf(b.toByte()), 0, 1)
+    }
+
+    override fun write(b: ByteArray, off: Int, len: Int) {
+        if (len == 0) {
+            return
+        }
+
+        out.writeByte(DaemonProtocol.OUTPUT_FRAME.toInt())
+        out.writeInt(len)
+        out.write(b, off, len)
+    }
+
+    override fun flush() {
+        out.flush()
+    }
+}
@@ -0,0 +1,24 @@
+package startup
+
+import java.nio.file.Path
+import kotlin.system.exitProcess
+
+
+internal actual fun runServiceMode(args: Array<String>): Boolean {
+    when (args.firstOrNull()) {
+        "--daemon" -> {
+            val socketPath = args.getOrNull(1)?.let { Path.of(it) } ?: DaemonProtocol.defaultSocketPath()
+            CompotDaemon.create(socketPath).serve()
+        }
+        "--connect" -> {
+            if (args.size < 2) {
+                println("Expected daemon socket after --connect")
+                return true
+            }
+            exitProcess(CompotClient.run(Path.of(args[1]), args.drop(2)))
+        }
+        else -> return false
+    }
+
+    return true
+}
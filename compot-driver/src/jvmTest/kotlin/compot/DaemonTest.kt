@@ -0,0 +1,53 @@
+package compot
+
+import common.CommonTest
+import common.FileUtils
+import common.runCommand
+import startup.CompotClient
+import startup.CompotDaemon
+import startup.CompotRequest
+import java.io.ByteArrayInputStream
+import java.io.ByteArrayOutputStream
+import java.io.DataInputStream
+import java.io.DataOutputStream
+import java.nio.file.Path
+import kotlin.random.Random
+import kotlin.test.Test
+import kotlin.test.assertEquals
+
+
+class DaemonTest: CommonTest() {
+    @Test
+    fun testCompileThroughDaemon() {
+        val socketPath = Path.of(FileUtils.createTempFile("compot-daemon"))
+        val daemon = CompotDaemon.create(socketPath)
+        val server = Thread { daemon.serve() }
+        server.start()
+
+        try {
+            val output = "$TEST_OUTPUT_DIR/hello_world_daemon${Random.nextInt()}"
+            val args = listOf("-c", "${TESTCASES_DIR}compot/hello_world/hello_world.c", "-o", "$output.o")
+            assertEquals(0, CompotClient.run(socketPath, args))
+
+            runGCC(output, listOf())
+            val result = runCommand("./$output.out", listOf(), null)
+            assertEquals("Hello, World!\n", result.output)
+            assertEquals(0, result.exitCode)
+        } finally {
+            daemon.close()
+            server.join()
+        }
+    }
+
+    @Test
+    fun testRequestCarriesEnvironment() {
+        val bytes = ByteArrayOutputStream()
+        val environment = mapOf("PATH" to "/usr/bin:/bin", "LIBRARY_PATH" to "lib")
+        CompotRequest("/work", environment, listOf("-c", "a.c")).write(DataOutputStream(bytes))
+
+        val request = CompotRequest.read(DataInputStream(ByteArrayInputStream(bytes.toByteArray())))
+        assertEquals("/work", request.workingDirectory)
+        assertEquals(environment, request.environment)
+        assertEquals(listOf("-c", "a.c"), request.args)
+    }
+}
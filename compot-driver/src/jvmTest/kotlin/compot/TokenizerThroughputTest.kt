@@ -0,0 +1,55 @@
+package compot
+
+import common.CommonTest
+import tokenizer.CTokenizer
+import tokenizer.SymbolTable
+import java.io.File
+import kotlin.test.Test
+import kotlin.test.assertTrue
+
+
+/**
+ * Prints tokens per second of [CTokenizer] on the algo and lacc test corpora.
+ */
+class TokenizerThroughputTest: CommonTest() {
+    private fun sources(dir: String): List<Pair<String, String>> {
+        val files = File("$TESTCASES_DIR/$dir").listFiles { file -> file.extension == "c" } ?: return listOf()
+        return files.sortedBy { it.name }.map { it.path to it.readText() }
+    }
+
+    private fun tokenizeAll(sources: List<Pair<String, String>>): Long {
+        var count = 0L
+        for ((filename, source) in sources) {
+            count += CTokenizer.apply(source, filename, SymbolTable()).size
+        }
+        return count
+    }
+
+    private fun measure(dir: String) {
+        val sources = sources(dir)
+        repeat(WARMUP_ROUNDS) { tokenizeAll(sources) }
+
+        var tokens = 0L
+        val start = System.nanoTime()
+        repeat(ROUNDS) { tokens += tokenizeAll(sources) }
+        val elapsed = System.nanoTime() - start
+
+        assertTrue(tokens > 0, "No tokens in $dir")
+        println("$dir: ${sources.size} files, ${tokens * 1_000_000_000L / elapsed} tokens/s")
+    }
+
+    @Test
+    fun testAlgoThroughput() {
+        measure("compot/algo")
+    }
+
+    @Test
+    fun testLaccThroughput() {
+        measure("compot/lacc")
+    }
+
+    companion object {
+        private const val WARMUP_ROUNDS = 20
+        private const val ROUNDS = 50
+    }
+}
@@ -0,0 +1,11 @@
+package startup
+
+import common.Sha256
+import common.readBinaryFile
+
+
+private val buildId: String by lazy {
+    Sha256().update(readBinaryFile("/proc/self/exe")).hexDigest()
+}
+
+internal actual fun compilerBuildId(): String = buildId
@@ -0,0 +1,11 @@
+package startup
+
+
+internal actual fun runServiceMode(args: Array<String>): Boolean {
+    when (args.firstOrNull()) {
+        "--daemon", "--connect" -> println("${args.first()} is supported only by the JVM build of the compiler")
+        else -> return false
+    }
+
+    return true
+}
@@ -0,0 +1,10 @@
+#include <stdio.h>
+
+int main() {
+    unsigned int a = 0xF0F0u;
+    unsigned long b = 0xFF00000000000001ul;
+    printf("%d %d %d\n", __builtin_popcount(a), __builtin_ctz(a), __builtin_clz(a));
+    printf("%d %d %d\n", __builtin_popcountl(b), __builtin_ctzl(b), __builtin_clzl(b));
+    printf("%x %lx %x\n", __builtin_bswap32(0x11223344u), __builtin_bswap64(b), __builtin_bswap16(0xAABB));
+    return 0;
+}
@@ -0,0 +1,31 @@
+#include <stdio.h>
+
+struct Point {
+    int x;
+    int y;
+    int z;
+};
+
+static int check(int v) {
+    if (__builtin_expect(v < 0, 0)) {
+        return -1;
+    }
+    return v * 2;
+}
+
+int main() {
+    struct Point p;
+    struct Point q;
+    char buf[40];
+    int n = 40;
+
+    __builtin_memset(&p, 0, sizeof(p));
+    p.y = 7;
+    __builtin_memcpy(&q, &p, sizeof(p));
+    __builtin_memset(buf, 'a', n - 1);
+    buf[n - 1] = 0;
+
+    printf("%d %d %d %d %d\n", q.x, q.y, q.z, check(5), check(-3));
+    printf("%s\n", buf);
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include <stdio.h>
+
+static int gcd(int a, int b) {
+    if (b == 0) {
+        return a;
+    }
+    return gcd(b, a % b);
+}
+
+static int isOdd(int n);
+
+static int isEven(int n) {
+    if (n == 0) {
+        return 1;
+    }
+    return isOdd(n - 1);
+}
+
+static int isOdd(int n) {
+    if (n == 0) {
+        return 0;
+    }
+    return isEven(n - 1);
+}
+
+static long fib(int n) {
+    if (n < 2) {
+        return n;
+    }
+    return fib(n - 1) + fib(n - 2);
+}
+
+int main() {
+    printf("%d %d %d %ld\n", gcd(1071, 462), isEven(10000), isOdd(7), fib(20));
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include <stdio.h>
+
+struct Pair {
+    long first;
+    long second;
+};
+
+static int square(int x) {
+    return x * x;
+}
+
+static int inc(int x) {
+    return square(x) + 1;
+}
+
+static struct Pair makePair(long a, long b) {
+    struct Pair p;
+    p.first = a;
+    p.second = b;
+    return p;
+}
+
+static long swapSum(long a, long b) {
+    struct Pair p = makePair(b, a);
+    return p.first * 10 + p.second;
+}
+
+static double half(double x) {
+    return x / 2;
+}
+
+static double quarter(double x) {
+    return half(half(x));
+}
+
+static int loop(int n) {
+    int total = 0;
+    for (int i = 0; i < n; i++) {
+        total += square(i);
+        total -= inc(i) - 1;
+        total += square(i) % 7;
+    }
+    return total;
+}
+
+int main() {
+    int sq = square(7);
+    printf("%d %d %ld %.2f %d\n", sq, inc(sq), swapSum(1, 2), quarter(3.0), loop(10));
+    return square(3) + inc(2);
+}
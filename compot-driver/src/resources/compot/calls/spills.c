@@ -0,0 +1,98 @@
+#include <stdio.h>
+
+static long spill(long a, long b) {
+    long x0 = a * 1 + b * 1;
+    long x1 = a * 2 + b * 8;
+    long x2 = a * 3 + b * 4;
+    long x3 = a * 4 + b * 11;
+    long x4 = a * 5 + b * 7;
+    long x5 = a * 6 + b * 3;
+    long x6 = a * 7 + b * 10;
+    long x7 = a * 8 + b * 6;
+    long x8 = a * 9 + b * 2;
+    long x9 = a * 10 + b * 9;
+    long x10 = a * 11 + b * 5;
+    long x11 = a * 12 + b * 1;
+    long x12 = a * 13 + b * 8;
+    long x13 = a * 14 + b * 4;
+    long x14 = a * 15 + b * 11;
+    long x15 = a * 16 + b * 7;
+    long x16 = a * 17 + b * 3;
+    long x17 = a * 18 + b * 10;
+    long x18 = a * 19 + b * 6;
+    long x19 = a * 20 + b * 2;
+    long x20 = a * 21 + b * 9;
+    long x21 = a * 22 + b * 5;
+    long x22 = a * 23 + b * 1;
+    long x23 = a * 24 + b * 8;
+    long x24 = a * 25 + b * 4;
+    long x25 = a * 26 + b * 11;
+    long x26 = a * 27 + b * 7;
+    long x27 = a * 28 + b * 3;
+    long x28 = a * 29 + b * 10;
+    long x29 = a * 30 + b * 6;
+    long x30 = a * 31 + b * 2;
+    long x31 = a * 32 + b * 9;
+    long x32 = a * 33 + b * 5;
+    long x33 = a * 34 + b * 1;
+    long x34 = a * 35 + b * 8;
+    long x35 = a * 36 + b * 4;
+    long x36 = a * 37 + b * 11;
+    long x37 = a * 38 + b * 7;
+    long x38 = a * 39 + b * 3;
+    long x39 = a * 40 + b * 10;
+    long r = 0;
+    r = (r * 3 + x39) % 1000003;
+    r = (r * 3 + x38) % 1000003;
+    r = (r * 3 + x37) % 1000003;
+    r = (r * 3 + x36) % 1000003;
+    r = (r * 3 + x35) % 1000003;
+    r = (r * 3 + x34) % 1000003;
+    r = (r * 3 + x33) % 1000003;
+    r = (r * 3 + x32) % 1000003;
+    r = (r * 3 + x31) % 1000003;
+    r = (r * 3 + x30) % 1000003;
+    r = (r * 3 + x29) % 1000003;
+    r = (r * 3 + x28) % 1000003;
+    r = (r * 3 + x27) % 1000003;
+    r = (r * 3 + x26) % 1000003;
+    r = (r * 3 + x25) % 1000003;
+    r = (r * 3 + x24) % 1000003;
+    r = (r * 3 + x23) % 1000003;
+    r = (r * 3 + x22) % 1000003;
+    r = (r * 3 + x21) % 1000003;
+    r = (r * 3 + x20) % 1000003;
+    r = (r * 3 + x19) % 1000003;
+    r = (r * 3 + x18) % 1000003;
+    r = (r * 3 + x17) % 1000003;
+    r = (r * 3 + x16) % 1000003;
+    r = (r * 3 + x15) % 1000003;
+    r = (r * 3 + x14) % 1000003;
+    r = (r * 3 + x13) % 1000003;
+    r = (r * 3 + x12) % 1000003;
+    r = (r * 3 + x11) % 1000003;
+    r = (r * 3 + x10) % 1000003;
+    r = (r * 3 + x9) % 1000003;
+    r = (r * 3 + x8) % 1000003;
+    r = (r * 3 + x7) % 1000003;
+    r = (r * 3 + x6) % 1000003;
+    r = (r * 3 + x5) % 1000003;
+    r = (r * 3 + x4) % 1000003;
+    r = (r * 3 + x3) % 1000003;
+    r = (r * 3 + x2) % 1000003;
+    r = (r * 3 + x1) % 1000003;
+    r = (r * 3 + x0) % 1000003;
+    return r;
+}
+
+static long few(long a, long b) {
+    long x0 = a + b;
+    long x1 = a - b;
+    long x2 = x0 * x1;
+    return x2 + x0 - x1;
+}
+
+int main() {
+    printf("%ld %ld\n", spill(3, 5), few(7, 2));
+    return 0;
+}
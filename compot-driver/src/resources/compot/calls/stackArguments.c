@@ -0,0 +1,37 @@
+#include <stdio.h>
+
+static long sum8(long a0, long a1, long a2, long a3, long a4, long a5, long a6, long a7) {
+    return a0 + a1 + a2 + a3 + a4 + a5 + a6 + a7;
+}
+
+static long shift8(long a0, long a1, long a2, long a3, long a4, long a5, long a6, long a7) {
+    return sum8(a7, a0, a1, a2, a3, a4, a5, a6 * 2);
+}
+
+static long widen(long a0, long a1, long a2, long a3, long a4, long a5) {
+    return sum8(a0, a1, a2, a3, a4, a5, a0 * 10, a1 * 10);
+}
+
+static long mix(long a, long b, long c, long d, long e, long f) {
+    long x0 = a * b;
+    long x1 = b * c;
+    long x2 = c * d;
+    long x3 = d * e;
+    long x4 = e * f;
+    long x5 = f * a;
+    long x6 = x0 + x1;
+    long x7 = x2 + x3;
+    long x8 = x4 + x5;
+    long x9 = x0 - x5;
+    long x10 = x1 - x4;
+    long x11 = x2 - x3;
+    long x12 = x6 * x9;
+    long x13 = x7 * x10;
+    long x14 = x8 * x11;
+    return x0 + x1 + x2 + x3 + x4 + x5 + x6 + x7 + x8 + x9 + x10 + x11 + x12 + x13 + x14;
+}
+
+int main() {
+    printf("%ld %ld %ld %ld\n", sum8(1, 2, 3, 4, 5, 6, 7, 8), shift8(1, 2, 3, 4, 5, 6, 7, 8), widen(1, 2, 3, 4, 5, 6), mix(1, 2, 3, 4, 5, 6));
+    return 0;
+}
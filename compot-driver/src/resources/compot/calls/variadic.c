@@ -0,0 +1,38 @@
+#include <stdio.h>
+
+static int report(const char* name, int total) {
+    return printf("%s: %d\n", name, total);
+}
+
+static int sum(const char* name, int count, ...) {
+    __builtin_va_list args;
+    int total = 0;
+    __builtin_va_start(args, count);
+    for (int i = 0; i < count; i++) {
+        total += __builtin_va_arg(args, int);
+    }
+    __builtin_va_end(args);
+    return report(name, total);
+}
+
+static int forward(const char* fmt, __builtin_va_list args) {
+    return vprintf(fmt, args);
+}
+
+static int print(const char* fmt, ...) {
+    __builtin_va_list args;
+    __builtin_va_start(args, fmt);
+    int n = forward(fmt, args);
+    __builtin_va_end(args);
+    return n;
+}
+
+static int show(double x, int y) {
+    return printf("%.1f %d\n", x, y);
+}
+
+int main() {
+    int n = sum("sum", 4, 1, 2, 3, 4);
+    print("%d %s\n", n, "chars");
+    return show(1.5, 2);
+}
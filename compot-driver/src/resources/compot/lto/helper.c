@@ -0,0 +1,18 @@
+int counter = 40;
+
+static int scale(int x) {
+    return x + 1;
+}
+
+static const char* location(void) {
+    return "helper";
+}
+
+int next(void) {
+    counter = scale(counter);
+    return counter;
+}
+
+const char* name(void) {
+    return location();
+}
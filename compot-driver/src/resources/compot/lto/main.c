@@ -0,0 +1,21 @@
+#include <stdio.h>
+
+extern int counter;
+
+int next(void);
+const char* name(void);
+
+static int scale(int x) {
+    return x * 10;
+}
+
+static const char* location(void) {
+    return "main";
+}
+
+int main() {
+    int a = next();
+    int b = next();
+    printf("%d %d %d %s %s\n", a, b, scale(counter), name(), location());
+    return scale(1);
+}
@@ -11,6 +11,7 @@ version = "1.0-SNAPSHOT"
 
 kotlin {
     jvm()
+    linuxX64()
 
     sourceSets {
         commonMain {
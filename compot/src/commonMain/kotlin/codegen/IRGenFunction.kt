@@ -17,6 +17,7 @@ import codegen.consteval.CommonConstEvalContext
 import codegen.consteval.ConstEvalExpression
 import codegen.consteval.TryConstEvalExpressionInt
 import intrinsic.VaInit
+import intrinsic.Builtins
 import intrinsic.VaStart
 import ir.Definitions.QWORD_SIZE
 import ir.Definitions.WORD_SIZE
@@ -84,6 +85,46 @@ private class IrGenFunction(moduleBuilder: ModuleBuilder,
         }
     }
 
+    /**
+     * Returns condition of 'if (__builtin_expect(condition, 0))'.
+     */
+    private fun unlikelyCondition(condition: Expression): Expression? {
+        if (condition !is FunctionCall) {
+            return null
+        }
+        val primary = condition.primary
+        if (primary !is VarNode || primary.name() != Builtins.EXPECT || condition.args.size != 2) {
+            return null
+        }
+        val expected = constEvalExpression0(condition.args[1]) ?: return null
+        if (expected.toLong() != 0L) {
+            return null
+        }
+
+        return condition.args[0]
+    }
+
+    private fun branchOnCondition(condition: Expression, onTrue: Label, onFalse: Label) {
+        val unlikely = unlikelyCondition(condition)
+        if (unlikely == null) {
+            ir.branchCond(makeConditionFromExpression(condition), onTrue, onFalse)
+            return
+        }
+
+        // Code generator places the first successor of the branch right after it,
+        // so the branch is inverted to keep the expected path as a fall-through.
+        var value = visitExpression(unlikely, true)
+        if (value.type() == FlagType) {
+            value = ir.convertRVToType(value, I8Type)
+        }
+        val isZero = when (val type = value.type()) {
+            is IntegerType -> ir.icmp(value, IntPredicate.Eq, IntegerConstant.of(type.asType(), 0))
+            is PtrType     -> ir.icmp(value, IntPredicate.Eq, NullValue)
+            else -> throw IRCodeGenError("Unexpected '${Builtins.EXPECT}' argument type: $type", condition.begin())
+        }
+        ir.branchCond(isZero, onFalse, onTrue)
+    }
+
     private fun makeConditionFromExpression(condition: Expression): Value {
         val conditionExpr = visitExpression(condition, true)
 
@@ -686,11 +727,95 @@ private class IrGenFunction(moduleBuilder: ModuleBuilder,
         }
     }
 
+    private fun builtinArguments(functionCall: FunctionCall, expected: Int): List<Expression> {
+        if (functionCall.args.size != expected) {
+            throw IRCodeGenError("'${LineAgnosticAstPrinter.print(functionCall.primary)}' expects $expected arguments, but got ${functionCall.args.size}", functionCall.begin())
+        }
+
+        return functionCall.args
+    }
+
+    private fun visitBitOp(functionCall: FunctionCall, op: BitOpType, argType: IntegerType): Value {
+        val args = builtinArguments(functionCall, 1)
+        val value = ir.convertLVToType(visitExpression(args[0], true), argType)
+        val bitop = ir.bitop(op, value)
+        val retType = mb.toIRType<IntegerType>(sema.typeHolder, functionCall.accept(sema))
+        return ir.convertLVToType(bitop, retType)
+    }
+
+    private fun findOrCreateLibcFunction(name: String, returnType: Type, arguments: List<NonTrivialType>): DirectFunctionPrototype {
+        return mb.findFunction(name) ?: mb.createExternFunction(name, returnType, arguments, hashSetOf())
+    }
+
+    private fun visitBuiltinMemcpy(functionCall: FunctionCall): Value {
+        val args = builtinArguments(functionCall, 3)
+        val dst = ir.convertLVToType(visitExpression(args[0], true), PtrType)
+        val src = ir.convertLVToType(visitExpression(args[1], true), PtrType)
+        val length = constEvalExpression0(args[2])?.toLong()
+        if (length != null && length > 0) {
+            ir.memcpy(dst, src, U64Value.of(length))
+            return dst
+        }
+
+        val memcpy = findOrCreateLibcFunction("memcpy", PtrType, listOf(PtrType, PtrType, U64Type))
+        val size = ir.convertLVToType(visitExpression(args[2], true), U64Type)
+        val cont = ir.createLabel()
+        val call = ir.call(memcpy, listOf(dst, src, size), hashSetOf(), cont)
+        ir.switchLabel(cont)
+        return call
+    }
+
+    private fun visitBuiltinMemset(functionCall: FunctionCall): Value {
+        val args = builtinArguments(functionCall, 3)
+        val dst = ir.convertLVToType(visitExpression(args[0], true), PtrType)
+        val fill = constEvalExpression0(args[1])?.toLong()
+        val length = constEvalExpression0(args[2])?.toLong()
+        if (fill != null && length != null && length > 0) {
+            ir.memset(dst, U8Value.of(fill.toUByte()), U64Value.of(length))
+            return dst
+        }
+
+        val memset = findOrCreateLibcFunction("memset", PtrType, listOf(PtrType, I32Type, U64Type))
+        val value = ir.convertLVToType(visitExpression(args[1], true), I32Type)
+        val size = ir.convertLVToType(visitExpression(args[2], true), U64Type)
+        val cont = ir.createLabel()
+        val call = ir.call(memset, listOf(dst, value, size), hashSetOf(), cont)
+        ir.switchLabel(cont)
+        return call
+    }
+
+    private fun visitBuiltinCall(name: String, functionCall: FunctionCall): Value = when (name) {
+        Builtins.POPCOUNT                       -> visitBitOp(functionCall, BitOpType.Popcount, U32Type)
+        Builtins.POPCOUNTL, Builtins.POPCOUNTLL -> visitBitOp(functionCall, BitOpType.Popcount, U64Type)
+        Builtins.CTZ                            -> visitBitOp(functionCall, BitOpType.CountTrailingZeros, U32Type)
+        Builtins.CTZL, Builtins.CTZLL           -> visitBitOp(functionCall, BitOpType.CountTrailingZeros, U64Type)
+        Builtins.CLZ                            -> visitBitOp(functionCall, BitOpType.CountLeadingZeros, U32Type)
+        Builtins.CLZL, Builtins.CLZLL           -> visitBitOp(functionCall, BitOpType.CountLeadingZeros, U64Type)
+        Builtins.BSWAP16                        -> visitBitOp(functionCall, BitOpType.ByteSwap, U16Type)
+        Builtins.BSWAP32                        -> visitBitOp(functionCall, BitOpType.ByteSwap, U32Type)
+        Builtins.BSWAP64                        -> visitBitOp(functionCall, BitOpType.ByteSwap, U64Type)
+        Builtins.MEMCPY                         -> visitBuiltinMemcpy(functionCall)
+        Builtins.MEMSET                         -> visitBuiltinMemset(functionCall)
+        Builtins.EXPECT -> {
+            // The hint itself is consumed by branch generation, see 'unlikelyCondition'
+            val args = builtinArguments(functionCall, 2)
+            ir.convertLVToType(visitExpression(args[0], true), I64Type)
+        }
+        Builtins.UNREACHABLE -> {
+            builtinArguments(functionCall, 0)
+            UndefValue
+        }
+        else -> throw IRCodeGenError("Unknown builtin '$name'", functionCall.begin())
+    }
+
     private fun visitFunctionCall(functionCall: FunctionCall): Value {
         val primary = functionCall.primary
         if (primary !is VarNode) {
             return visitFunPointerCall(functionCall)
         }
+        if (Builtins.isBuiltin(primary.name())) {
+            return visitBuiltinCall(primary.name(), functionCall)
+        }
         val functionType = functionCall.accept(sema)
         val function = mb.findFunction(primary.name()) ?: return visitFunPointerCall(functionCall)
         val argInfo = convertFunctionArgs(function, functionType, functionCall.args)
@@ -1604,11 +1729,10 @@ private class IrGenFunction(moduleBuilder: ModuleBuilder,
         if (ir.last() is TerminateInstruction) {
             return@scoped
         }
-        val condition = makeConditionFromExpression(ifElseStatement.condition)
         val thenBlock = ir.createLabel()
 
         val elseBlock = ir.createLabel()
-        ir.branchCond(condition, thenBlock, elseBlock)
+        branchOnCondition(ifElseStatement.condition, thenBlock, elseBlock)
         // then
         ir.switchLabel(thenBlock)
         visitStatement(ifElseStatement.then)
@@ -1637,11 +1761,10 @@ private class IrGenFunction(moduleBuilder: ModuleBuilder,
         if (ir.last() is TerminateInstruction) {
             return@scoped
         }
-        val condition = makeConditionFromExpression(ifStatement.condition)
         val thenBlock = ir.createLabel()
 
         val endBlock = ir.createLabel()
-        ir.branchCond(condition, thenBlock, endBlock)
+        branchOnCondition(ifStatement.condition, thenBlock, endBlock)
         ir.switchLabel(thenBlock)
         visitStatement(ifStatement.then)
         if (ir.last() !is TerminateInstruction) {
@@ -1804,60 +1927,35 @@ private class IrGenFunction(moduleBuilder: ModuleBuilder,
         return rvalueAdr
     }
 
-    private fun zeroMemory(address: Value, type: StructType, range: IntRange) {
-        for (i in range) {
-            val elementAdr = ir.gfp(address, type, I64Value.of(i))
-            when (val f = type.field(i)) {
-                is PrimitiveType -> ir.store(elementAdr, PrimitiveConstant.of(f, 0))
-                is StructType -> zeroMemory(elementAdr, f)
-                is ArrayType -> zeroMemory(elementAdr, f)
-            }
+    private fun zeroMemory(address: Value, offset: Int, size: Int) {
+        if (size == 0) {
+            return
         }
-    }
 
-    private fun zeroMemory(address: Value, type: StructType) {
-        zeroMemory(address, type, type.fields.indices)
+        val start = if (offset == 0) {
+            address
+        } else {
+            ir.gep(address, I8Type, I64Value.of(offset.toLong()))
+        }
+        ir.memset(start, U8Value.of(0u), U64Value.of(size.toLong()))
     }
 
-    private fun zeroMemory(address: Value, type: ArrayType, range: IntRange) = when (val elementType = type.elementType()) {
-        is PrimitiveType -> {
-            for (i in range) {
-                val elementAdr = ir.gep(address, elementType, I64Value.of(i))
-                ir.store(elementAdr, PrimitiveConstant.of(elementType, 0))
-            }
-        }
-        is ArrayType -> {
-            for (i in range) {
-                val elementAdr = ir.gep(address, elementType, I64Value.of(i))
-                zeroMemory(elementAdr, elementType)
-            }
-        }
-        is StructType -> {
-            for (i in range) {
-                val elementAdr = ir.gep(address, elementType, I64Value.of(i))
-                zeroMemory(elementAdr, elementType)
-            }
+    private fun zeroMemory(address: Value, type: AggregateType, range: IntRange) {
+        if (range.isEmpty()) {
+            return
         }
-    }
 
-    private fun zeroMemory(address: Value, type: ArrayType) {
-        zeroMemory(address, type, 0 until type.length)
+        // Fields in the range are contiguous in memory, so they are zeroed by single memset including padding between them
+        val begin = type.offset(range.first)
+        val end = type.offset(range.last) + type.field(range.last).sizeOf()
+        zeroMemory(address, begin, end - begin)
     }
 
-    private fun zeroingGaps(value: Value, type: AggregateType, filledPositions: List<Int>) = when (type) {
-        is StructType -> {
-            for ((left, right) in filledPositions.windowed(2)) {
-                if (right - left == 1) continue
-
-                zeroMemory(value, type, left + 1 until right)
-            }
-        }
-        is ArrayType -> {
-            for ((left, right) in filledPositions.windowed(2)) {
-                if (right - left == 1) continue
+    private fun zeroingGaps(value: Value, type: AggregateType, filledPositions: List<Int>) {
+        for ((left, right) in filledPositions.windowed(2)) {
+            if (right - left == 1) continue
 
-                zeroMemory(value, type, left + 1 until right)
-            }
+            zeroMemory(value, type, left + 1 until right)
         }
     }
 
@@ -2013,8 +2111,7 @@ private class IrGenFunction(moduleBuilder: ModuleBuilder,
                     ir.memcpy(lvalueAdr, rvalueResult, U64Value.of(irRvalueType.sizeOf().toLong()))
 
                     if (rvalueType.size() < type.size()) {
-                        val start = ir.gep(lvalueAdr, I8Type, U64Value.of(rvalueType.size().toLong()))
-                        zeroMemory(start, ArrayType(I8Type, type.size() - rvalueType.size()))
+                        zeroMemory(lvalueAdr, rvalueType.size(), type.size() - rvalueType.size())
                     }
                 }
                 else -> {
@@ -16,18 +16,60 @@ object GenerateIR {
     fun apply(typeHolder: TypeHolder, node: ProgramNode): SSAModule {
         return IRGen.apply(typeHolder, node)
     }
+
+    fun stream(typeHolder: TypeHolder): IRGenStream {
+        return IRGenStream(typeHolder)
+    }
+}
+
+/**
+ * Generates IR of a translation unit one external declaration at a time.
+ * Each function definition is built into its own module right away, so its AST and IR
+ * don't outlive it. Globals and constants are accumulated until [finish].
+ */
+class IRGenStream internal constructor(typeHolder: TypeHolder) {
+    private val irGen = IRGen(typeHolder)
+
+    init {
+        irGen.begin()
+    }
+
+    /**
+     * Returns module with the function if [node] is a function definition, null otherwise.
+     */
+    fun generate(node: ExternalDeclaration): SSAModule? {
+        irGen.generate(node)
+        if (node !is FunctionDeclarationNode) {
+            return null
+        }
+
+        return irGen.buildPendingFunctions()
+    }
+
+    fun finish(): SSAModule {
+        irGen.end()
+        return irGen.buildPendingFunctions()
+    }
 }
 
-private class IRGen private constructor(typeHolder: TypeHolder): AbstractIRGenerator(ModuleBuilder.create(), SemanticAnalysis(typeHolder), VarStack(), NameGenerator()) {
+private class IRGen(typeHolder: TypeHolder): AbstractIRGenerator(ModuleBuilder.create(), SemanticAnalysis(typeHolder), VarStack(), NameGenerator()) {
     fun visit(programNode: ProgramNode) = vregStack.scoped {
         for (node in programNode.nodes) {
-            when (node) {
-                is FunctionDeclarationNode -> generateFunction(node.function)
-                is GlobalDeclaration -> generateDeclaration(node.declaration)
-            }
+            generate(node)
         }
     }
 
+    fun begin() = vregStack.enter()
+
+    fun end() = vregStack.leave()
+
+    fun buildPendingFunctions(): SSAModule = verify { mb.buildPendingFunctions() }
+
+    fun generate(node: ExternalDeclaration) = when (node) {
+        is FunctionDeclarationNode -> generateFunction(node.function)
+        is GlobalDeclaration -> generateDeclaration(node.declaration)
+    }
+
     private fun generateFunction(node: FunctionNode) {
         val gen = FunGenInitializer(mb, node, vregStack, nameGenerator)
         gen.generate()
@@ -57,8 +99,12 @@ private class IRGen private constructor(typeHolder: TypeHolder): AbstractIRGener
         fun apply(typeHolder: TypeHolder, node: ProgramNode): SSAModule {
             val irGen = IRGen(typeHolder)
             irGen.visit(node)
+            return verify { irGen.mb.build() }
+        }
+
+        inline fun verify(build: () -> SSAModule): SSAModule {
             try {
-                return irGen.mb.build()
+                return build()
             } catch (e: ValidateSSAErrorException) {
                 println("Error: ${e.message}")
                 println("Function:\n${e.functionData}")
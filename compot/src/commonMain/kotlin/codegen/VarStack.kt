@@ -2,8 +2,15 @@ package codegen
 
 import typedesc.Scope
 
-class VarStack<V>: Scope, Iterable<V> {
+/**
+ * Stack of lexical scopes. May be layered over a [parent] stack, which is only read:
+ * the lookup falls through to the parent when the name isn't found in the own scopes.
+ */
+class VarStack<V> private constructor(private val parent: VarStack<V>?): Scope, Iterable<V> {
     private val stack = mutableListOf<MutableMap<String, V>>(hashMapOf())
+    private var changes = 0
+
+    constructor(): this(null)
 
     override fun enter() {
         stack.add(hashMapOf())
@@ -11,10 +18,20 @@ class VarStack<V>: Scope, Iterable<V> {
 
     override fun leave() {
         stack.removeLast()
+        changes++
     }
 
     operator fun set(name: String, type: V) {
         stack.last()[name] = type
+        changes++
+    }
+
+    /**
+     * Count of changes of this stack and its parent. It only grows,
+     * so an unchanged version means the same names are visible.
+     */
+    fun version(): Int {
+        return changes + (parent?.version() ?: 0)
     }
 
     operator fun get(name: String): V? {
@@ -24,27 +41,33 @@ class VarStack<V>: Scope, Iterable<V> {
                 return type
             }
         }
-        return null
+        return parent?.get(name)
     }
 
     override fun iterator(): Iterator<V> {
-        return VarStackIterator(stack)
+        return VarStackIterator(stack, parent?.iterator())
     }
 
-    fun copy(): VarStack<V> {
-        val newStack = VarStack<V>()
-        for (i in stack.indices) {
-            newStack.stack[i] = HashMap(stack[i])
-        }
-
-        return newStack
+    /**
+     * Creates a stack layered over this one. Nothing is copied, so the cost is O(1)
+     * and the new stack observes later changes of this one.
+     */
+    fun overlay(): VarStack<V> {
+        return VarStack(this)
     }
 
-    private class VarStackIterator<V>(private val stack: List<MutableMap<String, V>>) : Iterator<V> {
+    private class VarStackIterator<V>(private val stack: List<MutableMap<String, V>>, private var parentIterator: Iterator<V>?) : Iterator<V> {
         private var index = 0
         private var iterator: Iterator<V>? = null
 
         override fun hasNext(): Boolean {
+            val parent = parentIterator
+            if (parent != null) {
+                if (parent.hasNext()) {
+                    return true
+                }
+                parentIterator = null
+            }
             while (index < stack.size) {
                 if (iterator == null) {
                     iterator = stack[index].values.iterator()
@@ -62,6 +85,10 @@ class VarStack<V>: Scope, Iterable<V> {
             if (!hasNext()) {
                 throw NoSuchElementException()
             }
+            val parent = parentIterator
+            if (parent != null) {
+                return parent.next()
+            }
             return iterator!!.next()
         }
     }
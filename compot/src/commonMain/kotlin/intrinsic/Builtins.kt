@@ -0,0 +1,61 @@
+package intrinsic
+
+import types.*
+import typedesc.*
+
+
+// Reference: https://gcc.gnu.org/onlinedocs/gcc/Other-Builtins.html
+object Builtins {
+    const val POPCOUNT    = "__builtin_popcount"
+    const val POPCOUNTL   = "__builtin_popcountl"
+    const val POPCOUNTLL  = "__builtin_popcountll"
+    const val CTZ         = "__builtin_ctz"
+    const val CTZL        = "__builtin_ctzl"
+    const val CTZLL       = "__builtin_ctzll"
+    const val CLZ         = "__builtin_clz"
+    const val CLZL        = "__builtin_clzl"
+    const val CLZLL       = "__builtin_clzll"
+    const val BSWAP16     = "__builtin_bswap16"
+    const val BSWAP32     = "__builtin_bswap32"
+    const val BSWAP64     = "__builtin_bswap64"
+    const val EXPECT      = "__builtin_expect"
+    const val MEMCPY      = "__builtin_memcpy"
+    const val MEMSET      = "__builtin_memset"
+    const val UNREACHABLE = "__builtin_unreachable"
+
+    private val voidPtr = CPointer(VOID)
+
+    private val prototypes = linkedMapOf(
+        POPCOUNT    to function(INT, UINT),
+        POPCOUNTL   to function(INT, ULONG),
+        POPCOUNTLL  to function(INT, ULONG),
+        CTZ         to function(INT, UINT),
+        CTZL        to function(INT, ULONG),
+        CTZLL       to function(INT, ULONG),
+        CLZ         to function(INT, UINT),
+        CLZL        to function(INT, ULONG),
+        CLZLL       to function(INT, ULONG),
+        BSWAP16     to function(USHORT, USHORT),
+        BSWAP32     to function(UINT, UINT),
+        BSWAP64     to function(ULONG, ULONG),
+        EXPECT      to function(LONG, LONG, LONG),
+        MEMCPY      to function(voidPtr, voidPtr, voidPtr, ULONG),
+        MEMSET      to function(voidPtr, voidPtr, INT, ULONG),
+        UNREACHABLE to function(VOID),
+    )
+
+    private fun function(retType: CompletedType, vararg args: CompletedType): CFunctionType {
+        return CFunctionType(TypeDesc.from(retType), args.map { TypeDesc.from(it) }, false)
+    }
+
+    fun isBuiltin(name: String): Boolean = prototypes.containsKey(name)
+
+    /**
+     * Builtins are implicitly declared in every translation unit, as GCC does.
+     */
+    fun declare(typeHolder: TypeHolder) {
+        for ((name, prototype) in prototypes) {
+            typeHolder.addVar(VarDescriptor(name, prototype, listOf(), StorageClass.EXTERN))
+        }
+    }
+}
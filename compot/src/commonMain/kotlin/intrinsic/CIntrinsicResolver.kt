@@ -0,0 +1,16 @@
+package intrinsic
+
+import ir.intrinsic.IntrinsicProvider
+import ir.intrinsic.IntrinsicResolver
+
+
+/**
+ * Restores intrinsics emitted by the C front end when the module is read from the binary IR.
+ */
+object CIntrinsicResolver: IntrinsicResolver {
+    override fun resolve(name: String, parameters: IntArray): IntrinsicProvider? = when (name) {
+        VaStart.NAME -> VaStart.fromParameters(parameters)
+        VaInit.NAME  -> VaInit.fromParameters(parameters)
+        else -> null
+    }
+}
@@ -13,7 +13,11 @@ import ir.platform.x64.codegen.X64MacroAssembler
 import typedesc.TypeDesc
 
 
-class VaInit(private val firstArgType: CType): IntrinsicProvider("va_init") { //TODO consume all arguments
+class VaInit private constructor(private val isGPOperand: Boolean): IntrinsicProvider(NAME) { //TODO consume all arguments
+    constructor(firstArgType: CType): this(isGPOperand(firstArgType))
+
+    override fun parameters(): IntArray = intArrayOf(if (isGPOperand) 1 else 0)
+
     override fun <Masm : MacroAssembler> implement(masm: Masm, inputs: List<VReg>) {
         assertion(inputs.size == 1) { "va_init must have 1 arguments" }
 
@@ -35,7 +39,6 @@ class VaInit(private val firstArgType: CType): IntrinsicProvider("va_init") { //
             test(Definitions.BYTE_SIZE, rax, rax)
             jcc(CondFlagType.EQ, gprBlock)
 
-            val isGPOperand = isGPOperand(firstArgType)
             if (isGPOperand) {
                 movf(QWORD_SIZE, xmm0, Address.from(vaInit.base, vaInit.offset + 6 * QWORD_SIZE))
             }
@@ -61,6 +64,16 @@ class VaInit(private val firstArgType: CType): IntrinsicProvider("va_init") { //
     }
 
     companion object {
+        const val NAME = "va_init"
+
+        fun fromParameters(parameters: IntArray): VaInit? {
+            if (parameters.size != 1) {
+                return null
+            }
+
+            return VaInit(parameters[0] != 0)
+        }
+
         fun isGPOperand(type: CType): Boolean = when (type) {
             is BOOL, is AnyCInteger, is CPointer, is CEnumType -> true
             else -> false
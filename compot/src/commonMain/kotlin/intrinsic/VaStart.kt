@@ -19,14 +19,13 @@ import ir.platform.x64.codegen.X64MacroAssembler
 import typedesc.TypeDesc
 
 
-class VaStart(arguments: List<TypeDesc>) : IntrinsicProvider("va_start") {
-    private val numberOfGPArgs = arguments.count { isGPOperand(it.cType()) }
-    private val numberOfFPArgs = arguments.count { isFPOperand(it.cType()) }
-
-    init {
+class VaStart private constructor(private val numberOfGPArgs: Int, private val numberOfFPArgs: Int) : IntrinsicProvider(NAME) {
+    constructor(arguments: List<TypeDesc>): this(arguments.count { isGPOperand(it.cType()) }, arguments.count { isFPOperand(it.cType()) }) {
         require(arguments.isNotEmpty()) { "va_start must have 2 arguments" }
     }
 
+    override fun parameters(): IntArray = intArrayOf(numberOfGPArgs, numberOfFPArgs)
+
     override fun <Masm : MacroAssembler> implement(masm: Masm, inputs: List<VReg>) {
         assertion(inputs.size == 2) { "va_start must have 2 arguments" }
 
@@ -77,6 +76,8 @@ class VaStart(arguments: List<TypeDesc>) : IntrinsicProvider("va_start") {
     }
 
     companion object {
+        const val NAME = "va_start"
+
         const val REG_SAVE_AREA_SIZE    = 40
         const val FP_REG_SAVE_AREA_SIZE = 56
 
@@ -95,5 +96,13 @@ class VaStart(arguments: List<TypeDesc>) : IntrinsicProvider("va_start") {
         val FP_OFFSET_OFFSET         = vaList.offset(FP_OFFSET_IDX)
         val OVERFLOW_ARG_AREA_OFFSET = vaList.offset(OVERFLOW_ARG_AREA_IDX)
         val REG_SAVE_AREA_OFFSET     = vaList.offset(REG_SAVE_AREA_IDX)
+
+        fun fromParameters(parameters: IntArray): VaStart? {
+            if (parameters.size != 2) {
+                return null
+            }
+
+            return VaStart(parameters[0], parameters[1])
+        }
     }
 }
\ No newline at end of file
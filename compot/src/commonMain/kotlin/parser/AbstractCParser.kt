@@ -1,6 +1,7 @@
 package parser
 
 import tokenizer.*
+import intrinsic.Builtins
 import typedesc.TypeHolder
 import tokenizer.tokens.*
 import typedesc.VarDescriptor
@@ -8,10 +9,10 @@ import typedesc.VarDescriptor
 class FunctionCtx(val funcName: VarDescriptor?, val labelResolver: LabelResolver, val typeHolder: TypeHolder)
 
 
-sealed class AbstractCParser(val filename: String, tokens: TokenList) {
+sealed class AbstractCParser(val filename: String, protected val tokens: TokenBuffer, protected val memoization: Boolean) {
     private var anonymousCounter = 0
-    protected var current: AnyToken? = tokens.firstOrNull()
-    protected val globalTypeHolder = TypeHolder.default()
+    protected var current: Int = 0
+    protected val globalTypeHolder = TypeHolder.default().also { Builtins.declare(it) }
     protected var funcCtx: FunctionCtx? = FunctionCtx(null, LabelResolver.default(), globalTypeHolder)
 
     fun globalTypeHolder(): TypeHolder = globalTypeHolder
@@ -29,51 +30,45 @@ sealed class AbstractCParser(val filename: String, tokens: TokenList) {
     }
 
     protected fun eof(): Boolean {
-        skipSpaces()
-        return current == null
-    }
-
-    protected fun skipSpaces() {
-        while (current != null && current !is CToken) {
-            current = current!!.next()
-        }
+        return current >= tokens.size()
     }
 
     protected fun eat(): CToken {
-        skipSpaces()
         if (eof()) {
             throw ParserException(EndOfFile(filename))
         }
-        val token = current as CToken
-        current = current!!.next()
-        return token
+        return tokens[current++]
     }
 
     protected inline fun <reified T : CToken> peak(): T {
-        skipSpaces()
         if (eof()) {
             throw ParserException(EndOfFile(filename))
         }
-        if (current !is T) {
-            throw ParserException(InvalidToken("Unexpected token $current", current!!))
+        val token = tokens[current]
+        if (token !is T) {
+            throw ParserException(InvalidToken("Unexpected token $token", token))
         }
-        return current as T
+        return token
     }
 
-    protected fun check(s: String): Boolean {
-        skipSpaces()
+    /**
+     * Checks the spelling of the current token, [spelling] is a predefined id from [Spelling].
+     */
+    protected fun check(spelling: Int): Boolean {
         if (eof()) {
             return false
         }
-        return current!!.str() == s
+        return tokens.isSpelling(current, spelling)
     }
 
-    protected inline fun<reified T> check(): Boolean {
-        skipSpaces()
+    /**
+     * Checks the kind of the current token, [kindMask] is a union of [TokenBuffer] kinds.
+     */
+    protected fun checkKind(kindMask: Int): Boolean {
         if (eof()) {
             return false
         }
-        return current is T
+        return tokens.isKind(current, kindMask)
     }
 
     protected inline fun<reified T> rule(fn: () -> T?): T? {
@@ -85,8 +80,32 @@ sealed class AbstractCParser(val filename: String, tokens: TokenList) {
         return result
     }
 
+    /**
+     * Same as [rule], but with packrat memoization of the result by start token index
+     * when [memoization] is enabled. The result is replayed only in the same scope with the same typedefs
+     * as at the start of the production, so a production that declares a typedef is parsed again.
+     * Use it for backtracking-prone productions that don't change other parser state.
+     */
+    protected inline fun<reified T> memoRule(table: MemoTable<T>, fn: () -> T?): T? {
+        if (!memoization) {
+            return rule(fn)
+        }
+        val start = current
+        val scope = typeHolder()
+        val entry = table.find(start, scope)
+        if (entry != null) {
+            current = entry.end
+            return entry.result
+        }
+
+        val typedefVersion = scope.typedefVersion()
+        val result = rule(fn)
+        table[start] = MemoTable.Entry(result, current, scope, typedefVersion)
+        return result
+    }
+
     protected inline fun<reified T> funcRule(funcName: VarDescriptor?, fn: () -> T?): T? {
-        funcCtx = FunctionCtx(funcName, LabelResolver.default(), globalTypeHolder.copy())
+        funcCtx = FunctionCtx(funcName, LabelResolver.default(), globalTypeHolder.overlay())
         val result = rule(fn)
         funcCtx!!.labelResolver.resolveAll()
         funcCtx = null
@@ -16,8 +16,17 @@ data class ParserException(val info: ProgramMessage) : Exception(info.toString()
 // Grammar:
 // https://cs.wmich.edu/~gupta/teaching/cs4850/sumII06/The%20syntax%20of%20C%20in%20Backus-Naur%20form.htm
 //
-class CProgramParser private constructor(filename: String, iterator: TokenList): AbstractCParser(filename, iterator) {
+class CProgramParser private constructor(filename: String, tokens: TokenBuffer, memoization: Boolean): AbstractCParser(filename, tokens, memoization) {
     private val fabric = NodeFabric()
+    private val declarationSpecifiersMemo = MemoTable<DeclarationSpecifier>()
+    private val castExpressionMemo = MemoTable<Expression>()
+    private val typeNameMemo = MemoTable<TypeName>()
+
+    private fun clearMemo() {
+        declarationSpecifiersMemo.clear()
+        castExpressionMemo.clear()
+        typeNameMemo.clear()
+    }
 
     // translation_unit
     //	: external_declaration
@@ -25,18 +34,26 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	;
     fun translation_unit(): ProgramNode {
         val nodes = arrayListOf<ExternalDeclaration>()
+        translation_unit { node -> nodes.add(node) }
+        return ProgramNode(filename, nodes)
+    }
+
+    /**
+     * Passes each external declaration to [consumer] as soon as it is parsed.
+     */
+    fun translation_unit(consumer: (ExternalDeclaration) -> Unit) {
         while (!eof()) {
-            if (check(";")) {
+            if (check(Spelling.SEMICOLON)) {
                 eat()
                 continue
             }
 
             val node = external_declaration()?:
                 throw ParserException(InvalidToken("Expected external declaration", peak()))
-            nodes.add(node)
+            // Parser never backtracks over a parsed external declaration.
+            clearMemo()
+            consumer(node)
         }
-
-        return ProgramNode(filename, nodes)
     }
 
     //  function-definition:
@@ -88,36 +105,36 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //                   | break ;
     //                   | return {<expression>}? ;
     fun jump_statement(): Statement? = rule {
-        if (check("goto")) {
+        if (check(Spelling.GOTO)) {
             eat()
             val ident = peak<Identifier>()
             eat()
-            if (check(";")) {
+            if (check(Spelling.SEMICOLON)) {
                 eat()
                 return@rule labelResolver().addGoto(fabric.newGotoStatement(ident))
             }
             throw ParserException(InvalidToken("Expected ';'", peak()))
         }
-        if (check("continue")) {
+        if (check(Spelling.CONTINUE)) {
             val contKeyWord = eat() as Keyword
-            if (check(";")) {
+            if (check(Spelling.SEMICOLON)) {
                 eat()
                 return@rule fabric.newContinueStatement(contKeyWord)
             }
             throw ParserException(InvalidToken("Expected ';'", peak()))
         }
-        if (check("break")) {
+        if (check(Spelling.BREAK)) {
             val breakKeyword = eat().asToken<Keyword>()
-            if (check(";")) {
+            if (check(Spelling.SEMICOLON)) {
                 eat()
                 return@rule fabric.newBreakStatement(breakKeyword)
             }
             throw ParserException(InvalidToken("Expected ';'", peak()))
         }
-        if (check("return")) {
+        if (check(Spelling.RETURN)) {
             val retKeyword = eat()
             val expr = expression()
-            if (check(";")) {
+            if (check(Spelling.SEMICOLON)) {
                 val tok = eat()
                 val returnExpr = expr ?: fabric.newEmptyExpression(tok.position())
                 return@rule fabric.newReturnStatement(retKeyword.asToken(), returnExpr)
@@ -133,29 +150,29 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //                      | case <constant-expression> : <statement>
     //                      | default : <statement>
     fun labeled_statement(): Statement? = rule {
-        if (check<Identifier>()) {
+        if (checkKind(TokenBuffer.IDENTIFIER)) {
             val ident = peak<Identifier>()
             eat()
-            if (!check(":")) {
+            if (!check(Spelling.COLON)) {
                 return@rule null
             }
             eat()
             val stmt = statement() ?: throw ParserException(InvalidToken("Expected statement", peak()))
             return@rule labelResolver().addLabel(fabric.newLabeledStatement(ident, stmt))
         }
-        if (check("case")) {
+        if (check(Spelling.CASE)) {
             val caseKeyword = eat()
             val expr = constant_expression() ?: throw ParserException(InvalidToken("Expected constant expression", peak()))
-            if (!check(":")) {
+            if (!check(Spelling.COLON)) {
                 throw ParserException(InvalidToken("Expected ':'", peak()))
             }
             eat()
             val stmt = statement() ?: throw ParserException(InvalidToken("Expected statement", peak()))
             return@rule fabric.newCaseStatement(caseKeyword.asToken(), expr, stmt)
         }
-        if (check("default")) {
+        if (check(Spelling.DEFAULT)) {
             val defaultKeyword = eat()
-            if (!check(":")) {
+            if (!check(Spelling.COLON)) {
                 throw ParserException(InvalidToken("Expected ':'", peak()))
             }
             eat()
@@ -169,12 +186,12 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //
     // <expression-statement> ::= {<expression>}? ;
     fun expression_statement(): Statement? = rule {
-        if (check(";")) {
+        if (check(Spelling.SEMICOLON)) {
             val tok = eat()
             return@rule fabric.newEmptyStatement(tok.position())
         }
         val expr = expression() ?: return@rule null
-        if (check(";")) {
+        if (check(Spelling.SEMICOLON)) {
             eat()
             return@rule fabric.newExprStatement(expr)
         }
@@ -185,33 +202,33 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //                        | if ( <expression> ) <statement> else <statement>
     //                        | switch ( <expression> ) <statement>
     fun selection_statement(): Statement? = rule {
-        if (check("if")) {
+        if (check(Spelling.IF)) {
             val ifKeyword = eat()
-            if (!check("(")) {
+            if (!check(Spelling.LPAREN)) {
                 throw ParserException(InvalidToken("Expected '('", peak()))
             }
             eat()
             val expr = expression() ?: throw ParserException(InvalidToken("Expected expression", peak()))
-            if (!check(")")) {
+            if (!check(Spelling.RPAREN)) {
                 throw ParserException(InvalidToken("Expected ')'", peak()))
             }
             eat()
             val then = statement() ?: throw ParserException(InvalidToken("Expected statement", peak()))
-            if (!check("else")) {
+            if (!check(Spelling.ELSE)) {
                 return@rule fabric.newIfStatement(ifKeyword.asToken(), expr, then)
             }
             eat()
             val els = statement() ?: throw ParserException(InvalidToken("Expected statement", peak()))
             return@rule fabric.newIfElseStatement(ifKeyword.asToken(), expr, then, els)
         }
-        if (check("switch")) {
+        if (check(Spelling.SWITCH)) {
             val switchKeyword = eat()
-            if (!check("(")) {
+            if (!check(Spelling.LPAREN)) {
                 throw ParserException(InvalidToken("Expected '('", peak()))
             }
             eat()
             val expr = expression() ?: throw ParserException(InvalidToken("Expected expression", peak()))
-            if (!check(")")) {
+            if (!check(Spelling.RPAREN)) {
                 throw ParserException(InvalidToken("Expected ')'", peak()))
             }
             eat()
@@ -227,48 +244,48 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //                        | for ( <declaration> {<expression>}? ; {<expression>}? ) <statement>
     //                        ;
     fun iteration_statement(): Statement? = rule {
-        if (check("while")) {
+        if (check(Spelling.WHILE)) {
             val whileKeyword = eat()
-            if (!check("(")) {
+            if (!check(Spelling.LPAREN)) {
                 throw ParserException(InvalidToken("Expected '('", peak()))
             }
             eat()
             val condition = expression() ?: throw ParserException(
                 InvalidToken("Expected conditional expression", peak())
             )
-            if (!check(")")) {
+            if (!check(Spelling.RPAREN)) {
                 throw ParserException(InvalidToken("Expected ')'", peak()))
             }
             eat()
             val body = statement() ?: throw ParserException(InvalidToken("Expected statement", peak()))
             return fabric.newWhileStatement(whileKeyword.asToken(), condition, body)
         }
-        if (check("do")) {
+        if (check(Spelling.DO)) {
             val doKeyword = eat()
             val body = statement()?: throw ParserException(InvalidToken("Expected statement", peak()))
-            if (!check("while")) {
+            if (!check(Spelling.WHILE)) {
                 throw ParserException(InvalidToken("Expected 'while'", peak()))
             }
             eat()
-            if (!check("(")) {
+            if (!check(Spelling.LPAREN)) {
                 throw ParserException(InvalidToken("Expected '('", peak()))
             }
             eat()
             val condition = expression()
                 ?: throw ParserException(InvalidToken("Expected conditional expression", peak()))
-            if (!check(")")) {
+            if (!check(Spelling.RPAREN)) {
                 throw ParserException(InvalidToken("Expected ')'", peak()))
             }
             eat()
-            if (!check(";")) {
+            if (!check(Spelling.SEMICOLON)) {
                 throw ParserException(InvalidToken("Expected ';'", peak()))
             }
             eat()
             return fabric.newDoWhileStatement(doKeyword.asToken(), body, condition)
         }
-        if (check("for")) {
+        if (check(Spelling.FOR)) {
             val forKeyword = eat()
-            if (!check("(")) {
+            if (!check(Spelling.LPAREN)) {
                 throw ParserException(InvalidToken("Expected '('", peak()))
             }
             val cond = eat()
@@ -283,12 +300,12 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
             }
 
             val condition = expression() ?: fabric.newEmptyExpression(cond.position())
-            if (!check(";")) {
+            if (!check(Spelling.SEMICOLON)) {
                 throw ParserException(InvalidToken("Expected ';'", peak()))
             }
             val expr = eat()
             val update = expression() ?: fabric.newEmptyExpression(expr.position())
-            if (!check(")")) {
+            if (!check(Spelling.RPAREN)) {
                 throw ParserException(InvalidToken("Expected ')'", peak()))
             }
             eat()
@@ -304,17 +321,17 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	| '{' initializer_list ',' '}'
     //	;
     fun initializer(): Initializer? = rule {
-        if (!check("{")) {
+        if (!check(Spelling.LBRACE)) {
             val expr = assignment_expression() ?: return@rule null
             return@rule ExpressionInitializer(expr)
         }
         val brace = eat()
         val begin = brace.position()
         val list = initializer_list() ?: InitializerList(begin, listOf())
-        if (check(",")) {
+        if (check(Spelling.COMMA)) {
             eat()
         }
-        if (check("}")) {
+        if (check(Spelling.RBRACE)) {
             eat()
             return@rule InitializerListInitializer(list)
         } else {
@@ -336,16 +353,16 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //   | statement
     //   ;
     fun compound_statement(): CompoundStatement ? = rule {
-        if (!check("{")) {
+        if (!check(Spelling.LBRACE)) {
             return@rule null
         }
         eat()
-        if (check("}")) {
+        if (check(Spelling.RBRACE)) {
             val tok = eat()
             return@rule fabric.newCompoundStatement(listOf())
         }
         val statements = mutableListOf<CompoundStmtItem>()
-        while (!check("}")) {
+        while (!check(Spelling.RBRACE)) {
             val decl = declaration()
             if (decl != null) {
                 statements.add(CompoundStmtDeclaration(decl))
@@ -368,7 +385,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	;
     fun expression(): Expression? = rule {
         val assign = assignment_expression()?: return@rule null
-        if (!check(",")) {
+        if (!check(Spelling.COMMA)) {
             return@rule assign
         }
         eat()
@@ -380,47 +397,47 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //           | "<<=" | ">>="
     //           ;
     fun assign_op(): BinaryOpType? = rule {
-        if (check("=")) {
+        if (check(Spelling.ASSIGN)) {
             eat()
             return@rule BinaryOpType.ASSIGN
         }
-        if (check("+=")) {
+        if (check(Spelling.PLUS_ASSIGN)) {
             eat()
             return@rule BinaryOpType.ADD_ASSIGN
         }
-        if (check("-=")) {
+        if (check(Spelling.MINUS_ASSIGN)) {
             eat()
             return@rule BinaryOpType.SUB_ASSIGN
         }
-        if (check("*=")) {
+        if (check(Spelling.STAR_ASSIGN)) {
             eat()
             return@rule BinaryOpType.MUL_ASSIGN
         }
-        if (check("/=")) {
+        if (check(Spelling.SLASH_ASSIGN)) {
             eat()
             return@rule BinaryOpType.DIV_ASSIGN
         }
-        if (check("%=")) {
+        if (check(Spelling.PERCENT_ASSIGN)) {
             eat()
             return@rule BinaryOpType.MOD_ASSIGN
         }
-        if (check("&=")) {
+        if (check(Spelling.AND_ASSIGN)) {
             eat()
             return@rule BinaryOpType.BIT_AND_ASSIGN
         }
-        if (check("|=")) {
+        if (check(Spelling.OR_ASSIGN)) {
             eat()
             return@rule BinaryOpType.BIT_OR_ASSIGN
         }
-        if (check("^=")) {
+        if (check(Spelling.XOR_ASSIGN)) {
             eat()
             return@rule BinaryOpType.BIT_XOR_ASSIGN
         }
-        if (check("<<=")) {
+        if (check(Spelling.SHL_ASSIGN)) {
             eat()
             return@rule BinaryOpType.SHL_ASSIGN
         }
-        if (check(">>=")) {
+        if (check(Spelling.SHR_ASSIGN)) {
             eat()
             return@rule BinaryOpType.SHR_ASSIGN
         }
@@ -443,27 +460,27 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	| REGISTER
     //	;
     fun storage_class_specifier(): StorageClassSpecifier? = rule {
-        if (check("typedef")) {
+        if (check(Spelling.TYPEDEF)) {
             val tok = peak<Keyword>()
             eat()
             return@rule StorageClassSpecifier(tok)
         }
-        if (check("extern")) {
+        if (check(Spelling.EXTERN)) {
             val tok = peak<Keyword>()
             eat()
             return@rule StorageClassSpecifier(tok)
         }
-        if (check("static")) {
+        if (check(Spelling.STATIC)) {
             val tok = peak<Keyword>()
             eat()
             return@rule StorageClassSpecifier(tok)
         }
-        if (check("auto")) {
+        if (check(Spelling.AUTO)) {
             val tok = peak<Keyword>()
             eat()
             return@rule StorageClassSpecifier(tok)
         }
-        if (check("register")) {
+        if (check(Spelling.REGISTER)) {
             val tok = peak<Keyword>()
             eat()
             return@rule StorageClassSpecifier(tok)
@@ -476,7 +493,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	              ;
     fun init_declarator(): AnyDeclarator? = rule {
         val declarator = declarator()?: return@rule null
-        if (!check("=")) {
+        if (!check(Spelling.ASSIGN)) {
             return@rule declarator
         }
         eat()
@@ -490,10 +507,10 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	;
     fun init_declarator_list(): List<AnyDeclarator> {
         val initDeclarators = mutableListOf<AnyDeclarator>()
-        while (check<CToken>()) {
+        while (!eof()) {
             val initDeclarator = init_declarator() ?: return initDeclarators
             initDeclarators.add(initDeclarator)
-            if (check(",")) {
+            if (check(Spelling.COMMA)) {
                 eat()
             } else {
                 return initDeclarators
@@ -508,12 +525,12 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	;
     fun declaration(): Declaration? = rule {
         val declarationSpecifiers = declaration_specifiers() ?: return@rule null
-        if (check(";")) {
+        if (check(Spelling.SEMICOLON)) {
             eat()
             return@rule Declaration.create(typeHolder(), declarationSpecifiers, listOf())
         }
         val initDeclaratorList = init_declarator_list()
-        if (check(";")) {
+        if (check(Spelling.SEMICOLON)) {
             eat()
             return@rule Declaration.create(typeHolder(), declarationSpecifiers, initDeclaratorList)
         }
@@ -529,7 +546,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
         if (parameters.isEmpty()) {
             return@rule null
         }
-        if (check(",")) {
+        if (check(Spelling.COMMA)) {
             eat()
             val varArg = peak<CToken>()
             if (varArg.str() != "...") {
@@ -553,7 +570,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
         }
         while (!eof()) {
             val paramDecl = rule {
-                if (!check(",")) {
+                if (!check(Spelling.COMMA)) {
                     return@rule null
                 }
                 eat()
@@ -573,13 +590,13 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	| declarator ':' constant_expression
     //	;
     fun struct_declarator(): StructDeclarator? = rule {
-        if (check(":")) {
+        if (check(Spelling.COLON)) {
             val doubleDot = eat()
             val expr = constant_expression() ?: throw ParserException(InvalidToken("Expected constant expression", peak()))
             return@rule StructDeclarator(EmptyStructDeclaratorItem(anonymousName("field"), doubleDot.position()), expr)
         }
         val declarator = declarator()?: return@rule null
-        if (check(":")) {
+        if (check(Spelling.COLON)) {
             eat()
             val expr = constant_expression() ?: throw ParserException(InvalidToken("Expected constant expression", peak()))
             return@rule StructDeclarator(StructDeclaratorItem(declarator), expr)
@@ -596,7 +613,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
         while (true) {
             val declarator = struct_declarator()?: return declarators
             declarators.add(declarator)
-            if (check(",")) {
+            if (check(Spelling.COMMA)) {
                 eat()
             } else {
                 return declarators
@@ -610,7 +627,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     fun struct_declaration(): StructField? = rule {
         val declspec = specifier_qualifier_list()?: return@rule null
         val declarators = struct_declarator_list()
-        if (!check(";")) {
+        if (!check(Spelling.SEMICOLON)) {
             throw ParserException(InvalidToken("Expected ';'", peak()))
         }
         eat()
@@ -626,7 +643,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
         while (true) {
             val field = struct_declaration() ?: return fields
             fields.add(field)
-            if (check("}")) {
+            if (check(Spelling.RBRACE)) {
                 return fields
             }
         }
@@ -638,26 +655,26 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	| struct_or_union IDENTIFIER
     //	;
     fun struct_or_union_specifier(): AnyTypeNode? = rule {
-        if (check("struct")) {
+        if (check(Spelling.STRUCT)) {
             eat()
-            if (check("{")) {
+            if (check(Spelling.LBRACE)) {
                 eat()
                 val fields = struct_declaration_list()
-                if (!check("}")) {
+                if (!check(Spelling.RBRACE)) {
                     throw ParserException(InvalidToken("Expected '}'", peak()))
                 }
                 val brace = eat()
                 return@rule StructSpecifier(Identifier.unknown(anonymousName("struct"), brace.position()), fields)
             }
-            if (check<Identifier>()) {
+            if (checkKind(TokenBuffer.IDENTIFIER)) {
                 val name = peak<Identifier>()
                 eat()
-                if (!check("{")) {
+                if (!check(Spelling.LBRACE)) {
                     return@rule StructDeclaration(name)
                 }
                 eat()
                 val fields = struct_declaration_list()
-                if (!check("}")) {
+                if (!check(Spelling.RBRACE)) {
                     throw ParserException(InvalidToken("Expected '}'", peak()))
                 }
                 eat()
@@ -665,26 +682,26 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
             }
             throw ParserException(InvalidToken("Expected identifier", peak()))
         }
-        if (check("union")) {
+        if (check(Spelling.UNION)) {
             eat()
-            if (check("{")) {
+            if (check(Spelling.LBRACE)) {
                 eat()
                 val fields = struct_declaration_list()
-                if (!check("}")) {
+                if (!check(Spelling.RBRACE)) {
                     throw ParserException(InvalidToken("Expected '}'", peak()))
                 }
                 val brace = eat()
                 return@rule UnionSpecifier(Identifier.unknown(anonymousName("union"), brace.position()), fields)
             }
-            if (check<Identifier>()) {
+            if (checkKind(TokenBuffer.IDENTIFIER)) {
                 val name = peak<Identifier>()
                 eat()
-                if (!check("{")) {
+                if (!check(Spelling.LBRACE)) {
                     return@rule UnionDeclaration(name)
                 }
                 eat()
                 val fields = struct_declaration_list()
-                if (check("}")) {
+                if (check(Spelling.RBRACE)) {
                     eat()
                     return@rule UnionSpecifier(name, fields)
                 }
@@ -700,12 +717,12 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	| IDENTIFIER '=' constant_expression
     //	;
     fun enumerator(): Enumerator? = rule {
-        if (!check<Identifier>()) {
+        if (!checkKind(TokenBuffer.IDENTIFIER)) {
             return@rule null
         }
         val name = peak<Identifier>()
         val eq = eat()
-        if (!check("=")) {
+        if (!check(Spelling.ASSIGN)) {
             return@rule Enumerator(name, fabric.newEmptyExpression(eq.position()))
         }
         eat()
@@ -722,7 +739,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
         while (true) {
             val enumerator = enumerator()?: return enumerators
             enumerators.add(enumerator)
-            if (check(",")) {
+            if (check(Spelling.COMMA)) {
                 eat()
             } else {
                 return enumerators
@@ -736,28 +753,28 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	| 'enum' IDENTIFIER
     //	;
     fun enum_specifier(): AnyTypeNode? = rule {
-        if (!check("enum")) {
+        if (!check(Spelling.ENUM)) {
             return@rule null
         }
         eat()
-        if (check("{")) {
+        if (check(Spelling.LBRACE)) {
             eat()
             val enumerators = enumerator_list()
-            if (!check("}")) {
+            if (!check(Spelling.RBRACE)) {
                 throw ParserException(InvalidToken("Expected '}'", peak()))
             }
             val brace = eat()
             return@rule EnumSpecifier(Identifier.unknown(anonymousName("enum"), brace.position()), enumerators)
         }
-        if (check<Identifier>()) {
+        if (checkKind(TokenBuffer.IDENTIFIER)) {
             val name = peak<Identifier>()
             eat()
-            if (!check("{")) {
+            if (!check(Spelling.LBRACE)) {
                 return@rule EnumDeclaration(name)
             }
             eat()
             val enumerators = enumerator_list()
-            if (!check("}")) {
+            if (!check(Spelling.RBRACE)) {
                 throw ParserException(InvalidToken("Expected '}'", peak()))
             }
             eat()
@@ -782,57 +799,57 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	| TYPE_NAME
     //	;
     fun type_specifier(): AnyTypeNode? = rule {
-        if (check("void")) {
+        if (check(Spelling.VOID)) {
             val tok = peak<Keyword>()
             eat()
             return@rule TypeNode(tok)
         }
-        if (check("char")) {
+        if (check(Spelling.CHAR)) {
             val tok = peak<Keyword>()
             eat()
             return@rule TypeNode(tok)
         }
-        if (check("short")) {
+        if (check(Spelling.SHORT)) {
             val tok = peak<Keyword>()
             eat()
             return@rule TypeNode(tok)
         }
-        if (check("int")) {
+        if (check(Spelling.INT)) {
             val tok = peak<Keyword>()
             eat()
             return@rule TypeNode(tok)
         }
-        if (check("long")) {
+        if (check(Spelling.LONG)) {
             val tok = peak<Keyword>()
             eat()
             return@rule TypeNode(tok)
         }
-        if (check("float")) {
+        if (check(Spelling.FLOAT)) {
             val tok = peak<Keyword>()
             eat()
             return@rule TypeNode(tok)
         }
-        if (check("double")) {
+        if (check(Spelling.DOUBLE)) {
             val tok = peak<Keyword>()
             eat()
             return@rule TypeNode(tok)
         }
-        if (check("signed")) {
+        if (check(Spelling.SIGNED)) {
             val tok = peak<Keyword>()
             eat()
             return@rule TypeNode(tok)
         }
-        if (check("unsigned")) {
+        if (check(Spelling.UNSIGNED)) {
             val tok = peak<Keyword>()
             eat()
             return@rule TypeNode(tok)
         }
-        if (check("_Bool")) {
+        if (check(Spelling.BOOL)) {
             val tok = peak<Keyword>()
             eat()
             return@rule TypeNode(tok)
         }
-        if (check("__builtin_va_list")) {
+        if (check(Spelling.BUILTIN_VA_LIST)) {
             val tok = peak<Identifier>()
             eat()
             return@rule TypeNode(tok)
@@ -842,7 +859,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
             return@rule structOrEnum
         }
 
-        if (check<Identifier>()) {
+        if (checkKind(TokenBuffer.IDENTIFIER)) {
             val tok = peak<Identifier>()
             if (typeHolder().getTypedefOrNull(tok.str()) != null) {
                 eat()
@@ -858,17 +875,17 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //  | RESTRICT
     //	;
     fun type_qualifier(): TypeQualifierNode? = rule {
-        if (check("const")) {
+        if (check(Spelling.CONST)) {
             val tok = peak<Keyword>()
             eat()
             return@rule TypeQualifierNode(tok)
         }
-        if (check("volatile")) {
+        if (check(Spelling.VOLATILE)) {
             val tok = peak<Keyword>()
             eat()
             return@rule TypeQualifierNode(tok)
         }
-        if (check("restrict")) {
+        if (check(Spelling.RESTRICT)) {
             val tok = peak<Keyword>()
             eat()
             return@rule TypeQualifierNode(tok)
@@ -884,12 +901,12 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //  | _Noreturn
     //  ;
     fun function_specifier(): FunctionSpecifierNode? = rule {
-        if (check("inline")) {
+        if (check(Spelling.INLINE)) {
             val tok = peak<Keyword>()
             eat()
             return@rule FunctionSpecifierNode(tok)
         }
-        if (check("_Noreturn")) {
+        if (check(Spelling.NORETURN)) {
             val tok = peak<Keyword>()
             eat()
             return@rule FunctionSpecifierNode(tok)
@@ -907,7 +924,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //  | function-specifier
     //  | function-specifier declaration_specifiers
     //	;
-    fun declaration_specifiers(): DeclarationSpecifier? = rule {
+    fun declaration_specifiers(): DeclarationSpecifier? = memoRule(declarationSpecifiersMemo) {
         val specifiers = mutableListOf<AnyTypeNode>()
         while (true) {
             val storageClass = storage_class_specifier()
@@ -933,7 +950,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
             break
         }
 
-        return@rule if (specifiers.isEmpty()) {
+        return@memoRule if (specifiers.isEmpty()) {
             null
         } else {
             fabric.newDeclarationSpecifier(specifiers)
@@ -965,15 +982,15 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	| direct_declarator '(' identifier_list ')'
     //	| direct_declarator '(' ')'
     fun direct_declarator(): DirectDeclarator? = rule {
-        if (check<Identifier>()) {
+        if (checkKind(TokenBuffer.IDENTIFIER)) {
             val ident = peak<Identifier>()
             eat()
             return@rule DirectDeclarator(DirectVarDeclarator(ident), declarator_list())
         }
-        if (check("(")) {
+        if (check(Spelling.LPAREN)) {
             eat()
             val declarator = declarator() ?: return@rule null
-            if (!check(")")) {
+            if (!check(Spelling.RPAREN)) {
                 throw ParserException(InvalidToken("Expected ')'", peak()))
             }
             eat()
@@ -986,16 +1003,16 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     private fun declarator_list(): List<DirectDeclaratorParam> {
         val declarators = mutableListOf<DirectDeclaratorParam>()
         while (true) {
-            if (check("(")) {
+            if (check(Spelling.LPAREN)) {
                 eat()
-                if (check(")")) {
+                if (check(Spelling.RPAREN)) {
                     val paren = eat()
                     declarators.add(ParameterTypeList(paren.position(), listOf()))
                     continue
                 }
                 val declspec = parameter_type_list()
                 if (declspec != null) {
-                    if (check(")")) {
+                    if (check(Spelling.RPAREN)) {
                         val paren = eat()
                         declarators.add(ParameterTypeList(paren.position(), declspec))
                         continue
@@ -1004,7 +1021,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
                 }
                 val identifiers = identifier_list()
                 if (identifiers != null) {
-                    if (check(")")) {
+                    if (check(Spelling.RPAREN)) {
                         eat()
                         declarators.add(identifiers)
                         continue
@@ -1014,15 +1031,15 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
 
                 throw ParserException(InvalidToken("Expected ')'", peak()))
             }
-            if (check("[")) {
+            if (check(Spelling.LBRACKET)) {
                 eat()
-                if (check("]")) {
+                if (check(Spelling.RBRACKET)) {
                     val br = eat()
                     declarators.add(ArrayDeclarator(fabric.newEmptyExpression(br.position())))
                     continue
                 }
                 val size = constant_expression()?: throw ParserException(InvalidToken("Expected constant expression", peak()))
-                if (check("]")) {
+                if (check(Spelling.RBRACKET)) {
                     eat()
                     declarators.add(ArrayDeclarator(size))
                     continue
@@ -1048,13 +1065,13 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     fun identifier_list(): IdentifierList? = rule {
         val identifiers = mutableListOf<IdentNode>()
         while (true) {
-            if (!check<Identifier>()) {
+            if (!checkKind(TokenBuffer.IDENTIFIER)) {
                 return@rule null
             }
             val ident = peak<Identifier>()
             eat()
             identifiers.add(fabric.newIdentifier(ident))
-            if (check(",")) {
+            if (check(Spelling.COMMA)) {
                 eat()
             } else {
                 break
@@ -1076,7 +1093,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //
     fun pointer(): List<NodePointer>? = rule {
         val pointers = mutableListOf<NodePointer>()
-        while (check("*")) {
+        while (check(Spelling.STAR)) {
             val ptr = eat()
             val position = ptr.position()
             val qualifiers = type_qualifier_list()
@@ -1131,9 +1148,9 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     fun direct_abstract_declarator(): List<AbstractDirectDeclaratorParam>? = rule {
         val abstractDeclarators = mutableListOf<AbstractDirectDeclaratorParam>()
         while (true) {
-            if (check("(")) {
+            if (check(Spelling.LPAREN)) {
                 eat()
-                if (check(")")) {
+                if (check(Spelling.RPAREN)) {
                     val paren = eat()
                     abstractDeclarators.add(ParameterTypeList(paren.position(),listOf()))
                     continue
@@ -1141,7 +1158,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
 
                 val parameters = parameter_type_list()
                 if (parameters != null) {
-                    if (check(")")) {
+                    if (check(Spelling.RPAREN)) {
                         val paren = eat()
                         abstractDeclarators.add(ParameterTypeList(paren.position(), parameters))
                         continue
@@ -1150,7 +1167,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
                 }
                 val declarator = abstract_declarator()
                 if (declarator != null) {
-                    if (check(")")) {
+                    if (check(Spelling.RPAREN)) {
                         eat()
                         abstractDeclarators.add(declarator)
                         continue
@@ -1159,15 +1176,15 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
                 }
                 throw ParserException(InvalidToken("Expected ')'", peak()))
             }
-            if (check("[")) {
+            if (check(Spelling.LBRACKET)) {
                 eat()
-                if (check("]")) {
+                if (check(Spelling.RBRACKET)) {
                     val br = eat()
                     abstractDeclarators.add(ArrayDeclarator(fabric.newEmptyExpression(br.position())))
                     continue
                 }
                 val size = constant_expression()?: throw ParserException(InvalidToken("Expected constant expression", peak()))
-                if (check("]")) {
+                if (check(Spelling.RBRACKET)) {
                     eat()
                     abstractDeclarators.add(ArrayDeclarator(size))
                     continue
@@ -1190,12 +1207,12 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     fun conditional_expression(): Expression? = rule {
         var logor = logical_or_expression()?: return@rule null
         while (true) {
-            if (!check("?")) {
+            if (!check(Spelling.QUESTION)) {
                 break
             }
             eat()
             val then = expression()?: throw ParserException(InvalidToken("Expected expression", peak()))
-            if (!check(":")) {
+            if (!check(Spelling.COLON)) {
                 throw ParserException(InvalidToken("Expected ':'", peak()))
             }
             eat()
@@ -1213,7 +1230,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     fun logical_or_expression(): Expression? = rule {
         var logand = logical_and_expression()?: return@rule null
         while (true) {
-            if (!check("||")) {
+            if (!check(Spelling.OR_OR)) {
                 break
             }
             eat()
@@ -1230,7 +1247,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     fun logical_and_expression(): Expression? = rule {
         var bitor = inclusive_or_expression()?: return@rule null
         while (true) {
-            if (!check("&&")) {
+            if (!check(Spelling.AND_AND)) {
                 break
             }
             eat()
@@ -1247,7 +1264,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     fun inclusive_or_expression(): Expression? = rule {
         var bitxor = exclusive_or_expression()?: return@rule null
         while (true) {
-            if (!check("|")) {
+            if (!check(Spelling.OR)) {
                 break
             }
             eat()
@@ -1264,7 +1281,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     fun exclusive_or_expression(): Expression? = rule {
         var bitand = and_expression()?: return@rule null
         while (true) {
-            if (!check("^")) {
+            if (!check(Spelling.XOR)) {
                 break
             }
             eat()
@@ -1281,7 +1298,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     fun and_expression(): Expression? = rule {
         var equality = equality_expression()?: return@rule null
         while (true) {
-            if (!check("&")) {
+            if (!check(Spelling.AMPERSAND)) {
                 break
             }
             eat()
@@ -1299,13 +1316,13 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     fun equality_expression(): Expression? = rule {
         var relational = relational_expression()?: return@rule null
         while (true) {
-            if (check("==")) {
+            if (check(Spelling.EQ)) {
                 eat()
                 val equal = relational_expression()?: throw ParserException(InvalidToken("Expected relational expression", peak()))
                 relational = fabric.newBinaryOp(relational, equal, BinaryOpType.EQ)
                 continue
             }
-            if (check("!=")) {
+            if (check(Spelling.NE)) {
                 eat()
                 val notEqual = relational_expression()?: throw ParserException(InvalidToken("Expected relational expression", peak()))
                 relational = fabric.newBinaryOp(relational, notEqual, BinaryOpType.NE)
@@ -1326,25 +1343,25 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     fun relational_expression(): Expression? = rule {
         var shift = shift_expression()?: return@rule null
         while (true) {
-            if (check("<")) {
+            if (check(Spelling.LT)) {
                 eat()
                 val less = shift_expression()?: throw ParserException(InvalidToken("Expected shift expression", peak()))
                 shift = fabric.newBinaryOp(shift, less, BinaryOpType.LT)
                 continue
             }
-            if (check(">")) {
+            if (check(Spelling.GT)) {
                 eat()
                 val greater = shift_expression()?: throw ParserException(InvalidToken("Expected shift expression", peak()))
                 shift = fabric.newBinaryOp(shift, greater, BinaryOpType.GT)
                 continue
             }
-            if (check("<=")) {
+            if (check(Spelling.LE)) {
                 eat()
                 val lessEq = shift_expression()?: throw ParserException(InvalidToken("Expected shift expression", peak()))
                 shift = fabric.newBinaryOp(shift, lessEq, BinaryOpType.LE)
                 continue
             }
-            if (check(">=")) {
+            if (check(Spelling.GE)) {
                 eat()
                 val greaterEq = shift_expression()?: throw ParserException(InvalidToken("Expected shift expression", peak()))
                 shift = fabric.newBinaryOp(shift, greaterEq, BinaryOpType.GE)
@@ -1363,13 +1380,13 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     fun shift_expression(): Expression? = rule {
         var additive = additive_expression()?: return@rule null
         while (true) {
-            if (check("<<")) {
+            if (check(Spelling.SHL)) {
                 eat()
                 val shift = additive_expression()?: throw ParserException(InvalidToken("Expected shift expression", peak()))
                 additive = fabric.newBinaryOp(additive, shift, BinaryOpType.SHL)
                 continue
             }
-            if (check(">>")) {
+            if (check(Spelling.SHR)) {
                 eat()
                 val shift = additive_expression()?: throw ParserException(InvalidToken("Expected shift expression", peak()))
                 additive = fabric.newBinaryOp(additive, shift, BinaryOpType.SHR)
@@ -1388,13 +1405,13 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     fun additive_expression(): Expression? = rule {
         var mult = multiplicative_expression()?: return@rule null
         while (true) {
-            if (check("+")) {
+            if (check(Spelling.PLUS)) {
                 eat()
                 val add = multiplicative_expression()?: throw ParserException(InvalidToken("Expected additive expression", peak()))
                 mult = fabric.newBinaryOp(mult, add, BinaryOpType.ADD)
                 continue
             }
-            if (check("-")) {
+            if (check(Spelling.MINUS)) {
                 eat()
                 val add = multiplicative_expression()?: throw ParserException(InvalidToken("Expected additive expression", peak()))
                 mult = fabric.newBinaryOp(mult, add, BinaryOpType.SUB)
@@ -1414,19 +1431,19 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     fun multiplicative_expression(): Expression? = rule {
         var cast = cast_expression() ?: return@rule null
         while (true) {
-            if (check("*")) {
+            if (check(Spelling.STAR)) {
                 eat()
                 val mul = cast_expression() ?: throw ParserException(InvalidToken("Expected multiplicative expression", peak()))
                 cast = fabric.newBinaryOp(cast, mul, BinaryOpType.MUL)
                 continue
             }
-            if (check("/")) {
+            if (check(Spelling.SLASH)) {
                 eat()
                 val mul = cast_expression() ?: throw ParserException(InvalidToken("Expected multiplicative expression", peak()))
                 cast = fabric.newBinaryOp(cast, mul, BinaryOpType.DIV)
                 continue
             }
-            if (check("%")) {
+            if (check(Spelling.PERCENT)) {
                 eat()
                 val mul = cast_expression() ?: throw ParserException(InvalidToken("Expected multiplicative expression", peak()))
                 cast = fabric.newBinaryOp(cast, mul, BinaryOpType.MOD)
@@ -1441,32 +1458,32 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	: unary_expression
     //	| '(' type_name ')' cast_expression
     //	;
-    fun cast_expression(): Expression? = rule {
+    fun cast_expression(): Expression? = memoRule(castExpressionMemo) {
         val unary = unary_expression()
         if (unary != null) {
-            return@cast_expression unary
+            return@memoRule unary
         }
-        if (!check("(")) {
-            return@rule null
+        if (!check(Spelling.LPAREN)) {
+            return@memoRule null
         }
         eat()
         val typeName = type_name()?: throw ParserException(InvalidToken("Expected type name", peak()))
-        if (!check(")")) {
+        if (!check(Spelling.RPAREN)) {
             throw ParserException(InvalidToken("Expected ')'", peak()))
         }
         eat()
         val cast = cast_expression()?: throw ParserException(InvalidToken("Expected cast expression", peak()))
-        return@cast_expression fabric.newCast(typeName, cast)
+        return@memoRule fabric.newCast(typeName, cast)
     }
 
     // type_name
     //	: specifier_qualifier_list
     //	| specifier_qualifier_list abstract_declarator
     //	;
-    fun type_name(): TypeName? = rule {
-        val specifierQualifierList = specifier_qualifier_list()?: return@rule null
+    fun type_name(): TypeName? = memoRule(typeNameMemo) {
+        val specifierQualifierList = specifier_qualifier_list()?: return@memoRule null
         val abstractDeclarator = abstract_declarator()
-        return@rule fabric.newTypeName(specifierQualifierList, abstractDeclarator)
+        return@memoRule fabric.newTypeName(specifierQualifierList, abstractDeclarator)
     }
 
     // specifier_qualifier_list
@@ -1506,27 +1523,27 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	| '!'
     //	;
     fun unary_operator(): PrefixUnaryOpType? = rule {
-        if (check("&")) {
+        if (check(Spelling.AMPERSAND)) {
             eat()
             return@rule PrefixUnaryOpType.ADDRESS
         }
-        if (check("*")) {
+        if (check(Spelling.STAR)) {
             eat()
             return@rule PrefixUnaryOpType.DEREF
         }
-        if (check("+")) {
+        if (check(Spelling.PLUS)) {
             eat()
             return@rule PrefixUnaryOpType.PLUS
         }
-        if (check("-")) {
+        if (check(Spelling.MINUS)) {
             eat()
             return@rule PrefixUnaryOpType.NEG
         }
-        if (check("~")) {
+        if (check(Spelling.TILDE)) {
             eat()
             return@rule PrefixUnaryOpType.BIT_NOT
         }
-        if (check("!")) {
+        if (check(Spelling.NOT)) {
             eat()
             return@rule PrefixUnaryOpType.NOT
         }
@@ -1546,12 +1563,12 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
         if (postfix != null) {
             return@rule postfix
         }
-        if (check("++")) {
+        if (check(Spelling.INC)) {
             eat()
             val unary = unary_expression() ?: throw ParserException(InvalidToken("Expected unary expression", peak()))
             return@rule fabric.newUnaryOp(unary, PrefixUnaryOpType.INC)
         }
-        if (check("--")) {
+        if (check(Spelling.DEC)) {
             eat()
             val unary = unary_expression() ?: throw ParserException(InvalidToken("Expected unary expression", peak()))
             return@rule fabric.newUnaryOp(unary, PrefixUnaryOpType.DEC)
@@ -1561,18 +1578,18 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
             val cast = cast_expression() ?: throw ParserException(InvalidToken("Expected cast expression", peak()))
             return@rule fabric.newUnaryOp(cast, op)
         }
-        if (check("sizeof")) {
+        if (check(Spelling.SIZEOF)) {
             eat()
             val expr = unary_expression()
             if (expr != null) {
                 return@rule fabric.newSizeOf(SizeOfExpr(expr))
             }
-            if (!check("(")) {
+            if (!check(Spelling.LPAREN)) {
                 throw ParserException(InvalidToken("Expected unary expression", peak()))
             }
             eat()
             val type = type_name() ?: return@rule null
-            if (!check(")")) {
+            if (!check(Spelling.RPAREN)) {
                 throw ParserException(InvalidToken("Expected ')'", peak()))
             }
             eat()
@@ -1592,16 +1609,16 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
         }
         eat()
         val type = type_name() ?: throw ParserException(InvalidToken("Expected type name", peak()))
-        if (!check(")")) {
+        if (!check(Spelling.RPAREN)) {
             throw ParserException(InvalidToken("Expected ')'", peak()))
         }
         eat()
-        if (!check("{")) {
+        if (!check(Spelling.LBRACE)) {
             return@rule null
         }
         val start = eat()
         val initList = initializer_list()
-        if (!check("}")) {
+        if (!check(Spelling.RBRACE)) {
             throw ParserException(InvalidToken("Expected '}'", peak()))
         }
         eat()
@@ -1627,10 +1644,10 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     fun postfix_expression(): Expression? = rule {
         var primary: Expression = primary_expression() ?: return@rule compound_literal()
         while (true) {
-            if (check("[")) {
+            if (check(Spelling.LBRACKET)) {
                 eat()
                 val expr = expression() ?: throw ParserException(InvalidToken("Expected expression", peak()))
-                if (check("]")) {
+                if (check(Spelling.RBRACKET)) {
                     eat()
                     primary = fabric.newArrayAccess(primary, expr)
                 } else {
@@ -1638,10 +1655,10 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
                 }
                 continue
             }
-            if (check("(")) {
+            if (check(Spelling.LPAREN)) {
                 eat()
                 val args = argument_expression_list()
-                if (check(")")) {
+                if (check(Spelling.RPAREN)) {
                     eat()
                     primary = fabric.newFunctionCall(primary, args)
                 } else {
@@ -1649,26 +1666,26 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
                 }
                 continue
             }
-            if (check(".")) {
+            if (check(Spelling.DOT)) {
                 eat()
                 val ident = peak<Identifier>()
                 eat()
                 primary = fabric.newMemberAccess(primary, ident)
                 continue
             }
-            if (check("->")) {
+            if (check(Spelling.ARROW)) {
                 eat()
                 val ident = peak<Identifier>()
                 eat()
                 primary = fabric.newArrowMemberAccess(primary, ident)
                 continue
             }
-            if (check("++")) {
+            if (check(Spelling.INC)) {
                 eat()
                 primary = fabric.newUnaryOp(primary, PostfixUnaryOpType.INC)
                 continue
             }
-            if (check("--")) {
+            if (check(Spelling.DEC)) {
                 eat()
                 primary = fabric.newUnaryOp(primary, PostfixUnaryOpType.DEC)
                 continue
@@ -1688,7 +1705,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
         while (true) {
             val expr = assignment_expression()?: return arguments
             arguments.add(expr)
-            if (check(",")) {
+            if (check(Spelling.COMMA)) {
                 eat()
             } else {
                 return arguments
@@ -1719,7 +1736,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
                 }
                 initializers.add(SingleInitializer(init))
             }
-            if (check(",")) {
+            if (check(Spelling.COMMA)) {
                 eat()
             } else {
                 break
@@ -1737,7 +1754,7 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	;
     fun designation(): Designation? = rule {
         val designators = designator_list() ?: return@rule null
-        if (check("=")) {
+        if (check(Spelling.ASSIGN)) {
             eat()
             return Designation(designators)
         }
@@ -1766,16 +1783,16 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	| '.' IDENTIFIER
     //	;
     fun designator(): Designator? = rule {
-        if (check("[")) {
+        if (check(Spelling.LBRACKET)) {
             eat()
             val expr = constant_expression() ?: return@rule null
-            if (check("]")) {
+            if (check(Spelling.RBRACKET)) {
                 eat()
                 return@rule ArrayDesignator(expr)
             }
             throw ParserException(InvalidToken("Expected ']'", peak()))
         }
-        if (check(".")) {
+        if (check(Spelling.DOT)) {
             eat()
             val ident = peak<Identifier>()
             eat()
@@ -1811,82 +1828,82 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     //	| '(' expression ')'
     //	;
     fun primary_expression(): Expression? = rule {
-        if (check("__builtin_va_arg")) {
+        if (check(Spelling.BUILTIN_VA_ARG)) {
             eat()
-            if (!check("(")) {
+            if (!check(Spelling.LPAREN)) {
                 throw ParserException(InvalidToken("Expected '('", peak()))
             }
             eat()
             val expr = assignment_expression()?: throw ParserException(InvalidToken("Expected assignment expression", peak()))
-            if (!check(",")) {
+            if (!check(Spelling.COMMA)) {
                 throw ParserException(InvalidToken("Expected ','", peak()))
             }
             eat()
             val typeName = type_name()?: throw ParserException(InvalidToken("Expected type name", peak()))
-            if (!check(")")) {
+            if (!check(Spelling.RPAREN)) {
                 throw ParserException(InvalidToken("Expected ')'", peak()))
             }
             eat()
             return@rule fabric.newBuiltinVaArg(expr, typeName)
         }
-        if (check("__builtin_va_start")) {
+        if (check(Spelling.BUILTIN_VA_START)) {
             eat()
-            if (!check("(")) {
+            if (!check(Spelling.LPAREN)) {
                 throw ParserException(InvalidToken("Expected '('", peak()))
             }
             eat()
             val expr = assignment_expression()?: throw ParserException(InvalidToken("Expected assignment expression", peak()))
-            if (!check(",")) {
+            if (!check(Spelling.COMMA)) {
                 throw ParserException(InvalidToken("Expected ','", peak()))
             }
             eat()
             val param = expression() ?: throw ParserException(InvalidToken("Expected type name", peak()))
-            if (!check(")")) {
+            if (!check(Spelling.RPAREN)) {
                 throw ParserException(InvalidToken("Expected ')'", peak()))
             }
             eat()
             return@rule fabric.newBuiltinVaStart(expr, param)
         }
-        if (check("__builtin_va_end")) {
+        if (check(Spelling.BUILTIN_VA_END)) {
             eat()
-            if (!check("(")) {
+            if (!check(Spelling.LPAREN)) {
                 throw ParserException(InvalidToken("Expected '('", peak()))
             }
             eat()
             val expr = assignment_expression()?: throw ParserException(InvalidToken("Expected assignment expression", peak()))
-            if (!check(")")) {
+            if (!check(Spelling.RPAREN)) {
                 throw ParserException(InvalidToken("Expected ')'", peak()))
             }
             eat()
             return@rule fabric.newBuiltinVaEnd(expr)
         }
-        if (check("__builtin_va_copy")) {
+        if (check(Spelling.BUILTIN_VA_COPY)) {
             eat()
-            if (!check("(")) {
+            if (!check(Spelling.LPAREN)) {
                 throw ParserException(InvalidToken("Expected '('", peak()))
             }
             eat()
             val expr1 = assignment_expression()?: throw ParserException(InvalidToken("Expected assignment expression", peak()))
-            if (!check(",")) {
+            if (!check(Spelling.COMMA)) {
                 throw ParserException(InvalidToken("Expected ','", peak()))
             }
             eat()
             val expr2 = assignment_expression()?: throw ParserException(InvalidToken("Expected assignment expression", peak()))
-            if (!check(")")) {
+            if (!check(Spelling.RPAREN)) {
                 throw ParserException(InvalidToken("Expected ')'", peak()))
             }
             eat()
             return@rule fabric.newBuiltinVaCopy(expr1, expr2)
         }
-        if (check<Identifier>() &&
+        if (checkKind(TokenBuffer.IDENTIFIER) &&
             typeHolder().getTypedefOrNull(peak<Identifier>().str()) == null) {
             val ident = peak<Identifier>()
             eat()
             return@rule fabric.newVarNode(ident)
         }
-        if (check<AnyStringLiteral>()) {
+        if (checkKind(TokenBuffer.ANY_STRING_LITERAL)) {
             val allLiterals = arrayListOf<StringLiteral>()
-            while (check<AnyStringLiteral>()) {
+            while (checkKind(TokenBuffer.ANY_STRING_LITERAL)) {
                 when (val str = peak<AnyStringLiteral>()) {
                     is StringLiteral -> allLiterals.add(str)
                     is FunctionMark -> allLiterals.add(StringLiteral(currentFunction().name, str.position()))
@@ -1895,21 +1912,21 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
             }
             return@rule fabric.newStringNode(allLiterals)
         }
-        if (check<CharLiteral>()) {
+        if (checkKind(TokenBuffer.CHAR_LITERAL)) {
             val char = peak<CharLiteral>()
             eat()
             return@rule fabric.newCharNode(char)
         }
-        if (check<PPNumber>()) {
+        if (checkKind(TokenBuffer.NUMBER)) {
             val num = peak<PPNumber>()
             eat()
             return@rule fabric.newNumNode(num)
         }
-        if (check("(")) {
+        if (check(Spelling.LPAREN)) {
             eat()
             val expr = expression()
             if (expr != null) {
-                if (check(")")) {
+                if (check(Spelling.RPAREN)) {
                     eat()
                     return@rule expr
                 } else {
@@ -1941,12 +1958,24 @@ class CProgramParser private constructor(filename: String, iterator: TokenList):
     }
 
     companion object {
+        /**
+         * Builds a parser over [tokens], which are moved out of the list. [symbols] is the symbol table
+         * the tokens were preprocessed with.
+         */
+        fun build(filename: String, tokens: TokenList, symbols: SymbolTable, memoization: Boolean): CProgramParser {
+            return CProgramParser(filename, TokenBuffer.of(tokens, symbols), memoization)
+        }
+
+        fun build(filename: String, tokens: TokenList, memoization: Boolean): CProgramParser {
+            return build(filename, tokens, SymbolTable(), memoization)
+        }
+
         fun build(filename: String, tokens: TokenList): CProgramParser {
-            return CProgramParser(filename, tokens)
+            return build(filename, tokens, false)
         }
 
         fun build(tokens: TokenList): CProgramParser {
-            return CProgramParser("no-name", tokens)
+            return build("no-name", tokens, false)
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+package parser
+
+import typedesc.TypeHolder
+
+
+/**
+ * Packrat memoization table of a single production: maps start token index to
+ * the parsed node (or failure) and the token index right after it.
+ * An entry is only valid in the [TypeHolder] it was parsed in and until the typedefs of the holder change:
+ * the same tokens may parse differently when an identifier becomes a type name or stops being one.
+ */
+class MemoTable<T> {
+    class Entry<T>(val result: T?, val end: Int, val scope: TypeHolder, val typedefVersion: Int)
+
+    private val entries = hashMapOf<Int, Entry<T>>()
+
+    /**
+     * Returns the entry parsed from [start] in [scope] with the current typedefs, null otherwise.
+     */
+    fun find(start: Int, scope: TypeHolder): Entry<T>? {
+        val entry = entries[start] ?: return null
+        if (entry.scope !== scope || entry.typedefVersion != scope.typedefVersion()) {
+            return null
+        }
+
+        return entry
+    }
+
+    operator fun set(start: Int, entry: Entry<T>) {
+        entries[start] = entry
+    }
+
+    fun clear() {
+        entries.clear()
+    }
+}
@@ -343,10 +343,17 @@ class CProgramPreprocessor private constructor(filename: String, original: Token
         }
     }
 
-    private fun getMacroReplacement(macros: Macros, tok: CToken): TokenList? {
+    /**
+     * Tokens of object-like macros inherit the hideset of the macro name [tok], so indirect recursion stops.
+     * Tokens of function-like macros get the intersection of the name and closing parenthesis hidesets instead.
+     * Punctuators do not carry a hideset, so only the macro name is hidden there.
+     */
+    private fun getMacroReplacement(macros: Macros, symbol: Int, hidden: Hideset, tok: CToken): TokenList? {
         when (macros) {
             is MacroReplacement -> {
-                return macros.substitute(tok.position())
+                val hideset = hidden.copy()
+                hideset.add(symbol)
+                return macros.substitute(hideset, tok.position())
             }
             is PredefinedMacros -> {
                 return macros.cloneContentWith(tok.position())
@@ -364,7 +371,7 @@ class CProgramPreprocessor private constructor(filename: String, original: Token
                 killWithSpaces()
                 val args = parseMacroFunctionArguments()
 
-                return SubstituteMacroFunction(macros, ctx, args)
+                return SubstituteMacroFunction(macros, symbol, ctx, args)
                     .substitute(tok.position())
             }
             is MacroDefinition -> return TokenList()
@@ -372,15 +379,16 @@ class CProgramPreprocessor private constructor(filename: String, original: Token
     }
 
     private fun handleToken(tok: CToken): Boolean {
-        val macros = ctx.findMacros(tok.str()) ?: return false
         if (tok !is MacrosName) {
             return false
         }
-        if (tok.contains(macros.name)) {
+        val symbol = tok.symbol(ctx.symbols())
+        val macros = ctx.findMacros(symbol) ?: return false
+        if (tok.contains(symbol)) {
             return false
         }
         kill()
-        val replacement = getMacroReplacement(macros, tok) ?: return false
+        val replacement = getMacroReplacement(macros, symbol, tok.hideset(), tok) ?: return false
         if (replacement.isEmpty()) {
             return true
         }
@@ -431,7 +439,7 @@ class CProgramPreprocessor private constructor(filename: String, original: Token
                 return TokenList()
             }
 
-            val includeTokens = create(header.filename, header.tokenize(), ctx).preprocess()
+            val includeTokens = create(header.filename, header.tokenize(ctx.symbols()), ctx).preprocess()
             includeTokens.addBefore(null, EnterIncludeGuard(header.filename, ctx.includeLevel(), line))
             includeTokens.addAfter(null, ExitIncludeGuard(header.filename, ctx.includeLevel(), line))
             return includeTokens
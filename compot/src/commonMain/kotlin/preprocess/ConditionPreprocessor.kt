@@ -49,13 +49,14 @@ internal class ConditionPreprocessor(filename: String, condition: TokenList, pri
 
     fun evaluateCondition(): Long {
         val preprocessed = preprocess()
+        val expression = TokenPrinter.print(preprocessed)
 
-        val parser = CProgramParser.build(filename, preprocessed)
+        val parser = CProgramParser.build(filename, preprocessed, ctx.symbols(), false)
         val constexpr = parser.constant_expression() ?:
-            throw PreprocessorException("Cannot parse expression: '${TokenPrinter.print(preprocessed)}'")
+            throw PreprocessorException("Cannot parse expression: '$expression'")
 
         val evaluationContext = ConditionEvaluationContext(ctx)
         return ConstEvalExpression.eval(constexpr, TryConstEvalExpressionLong(evaluationContext)) ?:
-            throw PreprocessorException("Cannot evaluate expression: '${TokenPrinter.print(preprocessed)}'")
+            throw PreprocessorException("Cannot evaluate expression: '$expression'")
     }
 }
\ No newline at end of file
@@ -1,12 +1,14 @@
 package preprocess
 
 import common.FileUtils
+import common.fileExists
 import common.getBuildInHeader
+import common.lastModified
+import common.readTextFile
 import tokenizer.CTokenizer
+import tokenizer.SymbolTable
 import tokenizer.TokenList
-import java.io.FileInputStream
-import java.nio.file.Path
-import kotlin.io.path.exists
+import kotlin.jvm.Synchronized
 
 enum class HeaderType {
     SYSTEM,
@@ -14,8 +16,8 @@ enum class HeaderType {
 }
 
 data class Header(val filename: String, val content: String, val includeType: HeaderType) {
-    fun tokenize(): TokenList {
-        return CTokenizer.apply(content, filename)
+    fun tokenize(symbols: SymbolTable): TokenList {
+        return CTokenizer.apply(content, filename, symbols)
     }
 }
 
@@ -45,16 +47,43 @@ class PredefinedHeaderHolder(includeDirectories: Set<String>): HeaderHolder(incl
     }
 }
 
-class FileHeaderHolder(includeDirectories: Set<String>): HeaderHolder(includeDirectories) {
+/**
+ * Header file contents shared between compilations, e.g. by requests of the compiler daemon.
+ * An entry is reread when the file modification time changes.
+ */
+class HeaderCache {
+    private class Entry(val lastModified: Long, val content: String)
+
+    private val entries = hashMapOf<String, Entry>()
+
+    @Synchronized
+    private fun find(filename: String): Entry? = entries[filename]
+
+    @Synchronized
+    private fun put(filename: String, entry: Entry) {
+        entries[filename] = entry
+    }
+
+    fun read(filename: String): String {
+        val lastModified = lastModified(filename)
+        val entry = find(filename)
+        if (entry != null && entry.lastModified == lastModified) {
+            return entry.content
+        }
+
+        val content = readTextFile(filename)
+        put(filename, Entry(lastModified, content))
+        return content
+    }
+}
+
+class FileHeaderHolder(includeDirectories: Set<String>, private val cache: HeaderCache? = null): HeaderHolder(includeDirectories) {
     private fun tryReadHeader(fullPath: String, type: HeaderType): Header? {
-        val filePath = Path.of(fullPath)
-        if (!filePath.exists()) {
+        if (!fileExists(fullPath)) {
             return null
         }
 
-        val content = FileInputStream(filePath.toFile()).use { inputStream ->
-            inputStream.readBytes().decodeToString()
-        }
+        val content = cache?.read(fullPath) ?: readTextFile(fullPath)
         return Header(fullPath, content, type)
     }
 
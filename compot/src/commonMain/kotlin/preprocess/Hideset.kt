@@ -1,19 +1,46 @@
 package preprocess
 
-class Hideset {
-    private val hidden = arrayListOf<String>()
+/**
+ * Set of macro name ids of the compilation [tokenizer.SymbolTable]. Hidesets are usually tiny,
+ * so a linear scan over an int array beats hashing.
+ */
+class Hideset private constructor(private var hidden: IntArray, private var size: Int) {
+    constructor(): this(EMPTY, 0)
 
-    fun add(name: String) {
-        hidden.add(name)
+    fun add(symbol: Int) {
+        if (size == hidden.size) {
+            hidden = hidden.copyOf(if (size == 0) 4 else size * 2)
+        }
+        hidden[size++] = symbol
     }
 
-    fun contains(name: String): Boolean {
-        return hidden.contains(name)
+    fun addAll(other: Hideset) {
+        for (i in 0 until other.size) {
+            val symbol = other.hidden[i]
+            if (!contains(symbol)) {
+                add(symbol)
+            }
+        }
+    }
+
+    fun contains(symbol: Int): Boolean {
+        for (i in 0 until size) {
+            if (hidden[i] == symbol) {
+                return true
+            }
+        }
+        return false
     }
 
     fun copy(): Hideset {
-        val copy = Hideset()
-        copy.hidden.addAll(hidden)
-        return copy
+        if (size == 0) {
+            return Hideset()
+        }
+
+        return Hideset(hidden.copyOf(size), size)
+    }
+
+    companion object {
+        private val EMPTY = IntArray(0)
     }
-}
\ No newline at end of file
+}
@@ -13,8 +13,19 @@ class PreprocessorContext private constructor(private val macroReplacements: Mut
                                               private val predefinedMacroses: Map<String, PredefinedMacros>,
                                               private val headerHolder: HeaderHolder) {
     private var includeLevel = 0
+    private val symbols = SymbolTable()
+    // Visible macros indexed by name id in 'symbols'
+    private val macrosBySymbol = arrayListOf<Macros?>()
+
+    init {
+        predefinedMacroses.values.forEach { updateIndex(it.name) }
+        macroReplacements.values.forEach { updateIndex(it.name) }
+    }
+
     fun includeLevel(): Int = includeLevel
 
+    fun symbols(): SymbolTable = symbols
+
     fun enterInclude() {
         includeLevel += 1
     }
@@ -27,22 +38,49 @@ class PreprocessorContext private constructor(private val macroReplacements: Mut
     fun macroFunctions(): Map<String, MacroFunction> = macroFunctions
 
     fun define(macros: MacroReplacement): MacroReplacement? {
-        return macroReplacements.put(macros.name, macros)
+        val old = macroReplacements.put(macros.name, macros)
+        updateIndex(macros.name)
+        return old
     }
 
     fun define(macros: MacroDefinition): MacroDefinition? {
-        return macroDefinitions.put(macros.name, macros)
+        val old = macroDefinitions.put(macros.name, macros)
+        updateIndex(macros.name)
+        return old
     }
 
     fun define(macros: MacroFunction): MacroFunction? {
-        return macroFunctions.put(macros.name, macros)
+        val old = macroFunctions.put(macros.name, macros)
+        updateIndex(macros.name)
+        return old
     }
 
     fun findPredefinedMacros(name: String): PredefinedMacros? {
         return predefinedMacroses[name]
     }
 
+    fun findMacros(symbol: Int): Macros? {
+        return macrosBySymbol.getOrNull(symbol)
+    }
+
     fun findMacros(name: String): Macros? {
+        val symbol = symbols.find(name)
+        if (symbol == SymbolTable.NO_SYMBOL) {
+            return null
+        }
+
+        return macrosBySymbol.getOrNull(symbol)
+    }
+
+    private fun updateIndex(name: String) {
+        val symbol = symbols.intern(name)
+        while (macrosBySymbol.size <= symbol) {
+            macrosBySymbol.add(null)
+        }
+        macrosBySymbol[symbol] = lookupMacros(name)
+    }
+
+    private fun lookupMacros(name: String): Macros? {
         val macroDefinition = findMacroDefinition(name)
         if (macroDefinition != null) {
             return macroDefinition
@@ -71,6 +109,7 @@ class PreprocessorContext private constructor(private val macroReplacements: Mut
 
     fun undef(name: String) {
         macroReplacements.remove(name) ?: macroDefinitions.remove(name) ?: macroFunctions.remove(name)
+        updateIndex(name)
     }
 
     fun findHeader(headerName: String, filename: String, includeType: HeaderType): Header? {
@@ -9,9 +9,10 @@ import tokenizer.tokens.*
 import preprocess.macros.Macros.Companion.newTokenFrom
 
 
-internal class SubstituteMacroFunction(private val macros: MacroFunction, private val ctx: PreprocessorContext, private val args: List<TokenList>):
+internal class SubstituteMacroFunction(private val macros: MacroFunction, symbol: Int, private val ctx: PreprocessorContext, private val args: List<TokenList>):
     AbstractCPreprocessor(macros.name, macros.value) {
     private val result = TokenList()
+    private val hideset = Hideset().also { it.add(symbol) }
     private val argToValue = evaluateSubstitution(args)
 
     private fun evaluateSubstitution(args: List<TokenList>): Map<CToken, TokenList> {
@@ -35,7 +36,7 @@ internal class SubstituteMacroFunction(private val macros: MacroFunction, privat
         }
 
         val str = value.joinToString("", prefix = arg1.str()) { it.str() }
-        val tokens = CTokenizer.apply(str, where.filename())
+        val tokens = CTokenizer.apply(str, where.filename(), ctx.symbols())
         result.addAll(tokens)
         eat()
     }
@@ -125,7 +126,7 @@ internal class SubstituteMacroFunction(private val macros: MacroFunction, privat
 
             val value = argToValue[peak()]
             if (value == null) {
-                result.add(newTokenFrom(macros.name, macrosNamePos, peak()))
+                result.add(newTokenFrom(hideset, macrosNamePos, peak()))
                 eat()
                 continue
             }
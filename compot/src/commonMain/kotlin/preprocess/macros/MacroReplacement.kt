@@ -1,5 +1,6 @@
 package preprocess.macros
 
+import preprocess.Hideset
 import tokenizer.Position
 import tokenizer.TokenList
 import tokenizer.tokens.CToken
@@ -19,10 +20,10 @@ class MacroReplacement(name: String, val value: TokenList): Macros(name) {
         return builder.toString()
     }
 
-    fun substitute(macrosNamePos: Position): TokenList {
+    fun substitute(hideset: Hideset, macrosNamePos: Position): TokenList {
         val result = TokenList()
         for (tok in value) {
-            result.add(newTokenFrom(name, macrosNamePos, tok))
+            result.add(newTokenFrom(hideset, macrosNamePos, tok))
         }
 
         return result
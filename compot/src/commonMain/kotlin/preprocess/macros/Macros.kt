@@ -1,5 +1,6 @@
 package preprocess.macros
 
+import preprocess.Hideset
 import tokenizer.*
 import tokenizer.tokens.*
 
@@ -25,7 +26,7 @@ sealed class Macros(val name: String) {
     }
 
     companion object {
-        fun newTokenFrom(name: String, macrosNamePos: Position, tok: AnyToken): AnyToken {
+        fun newTokenFrom(hideset: Hideset, macrosNamePos: Position, tok: AnyToken): AnyToken {
             if (tok !is CToken) {
                 return tok.copy()
             }
@@ -34,7 +35,7 @@ sealed class Macros(val name: String) {
             val newTok = tok.cloneWith(preprocessedPosition).asToken<CToken>()
 
             if (newTok is MacrosName) {
-                newTok.add(name)
+                newTok.hideset().addAll(hideset)
             }
             return newTok
         }
@@ -3,13 +3,10 @@ package tokenizer
 import types.*
 import preprocess.Hideset
 import tokenizer.tokens.*
-import tokenizer.LexicalElements.keywords
-import tokenizer.LexicalElements.isOperator2
-import tokenizer.LexicalElements.isOperator3
-import tokenizer.StringReader.Companion.tryPunct
+import tokenizer.LexicalElements.punctuatorLength
 
 
-class CTokenizer private constructor(private val filename: String, private val reader: StringReader) {
+class CTokenizer private constructor(private val filename: String, private val reader: StringReader, private val symbols: SymbolTable?) {
     private val tokens = TokenList()
     private var position: Int = 1
     private var line: Int = 1
@@ -38,6 +35,33 @@ class CTokenizer private constructor(private val filename: String, private val r
         tokens.add(next)
     }
 
+    private fun identifier(name: String, where: Position): Identifier {
+        if (symbols == null) {
+            return Identifier(name, where, Hideset())
+        }
+
+        return Identifier.interned(symbols, name, where)
+    }
+
+    /**
+     * Keywords take the first ids of a [SymbolTable], so a single lookup both classifies and interns the word.
+     */
+    private fun keywordOrIdentifier(name: String, where: Position): CToken {
+        if (symbols == null) {
+            val keyword = SymbolTable.keyword(name)
+            if (keyword != SymbolTable.NO_SYMBOL) {
+                return Keyword.of(name, keyword, where)
+            }
+            return Identifier(name, where, Hideset())
+        }
+
+        val symbol = symbols.intern(name)
+        if (SymbolTable.isKeyword(symbol)) {
+            return Keyword.of(symbols.name(symbol), symbol, where)
+        }
+        return Identifier.interned(symbols, symbol, where)
+    }
+
     private fun asControlChar(ch: Char): Char? = when (ch) {
         'a' -> '\u0007'
         'b' -> '\b'
@@ -145,7 +169,7 @@ class CTokenizer private constructor(private val filename: String, private val r
     }
 
     private fun tryGetFPSuffix(str: String): Double? = try {
-        java.lang.Double.valueOf(str)
+        str.toDouble()
     } catch (_: NumberFormatException) {
         null
     }
@@ -221,12 +245,12 @@ class CTokenizer private constructor(private val filename: String, private val r
     private fun consumePower(string: String, base: Int): Double? {
         if (base == 10) {
             if (string.contains('e') || string.contains('E')) {
-                return java.lang.Double.valueOf(string)
+                return string.toDouble()
             }
         }
         if (base == 16) {
             if (string.contains('p') || string.contains('P')) {
-                return java.lang.Double.valueOf(string)
+                return string.toDouble()
             }
         }
 
@@ -341,28 +365,18 @@ class CTokenizer private constructor(private val filename: String, private val r
 
     private fun readIdentifier(): String {
         val startPos = reader.pos
-        while (!reader.eof && (reader.isLetter() || reader.isDigit())) {
-            eat()
-        }
+        eat(reader.countIdentifierPart())
         return reader.str.substring(startPos, reader.pos)
     }
 
     private fun readSpaces(): Int {
-        var spaces = 0
-        while (reader.isSpace()) {
-            eat()
-            spaces += 1
-        }
+        val spaces = reader.countSpaces()
+        eat(spaces)
         return spaces
     }
 
     private fun skipComment() {
-        while (!reader.eof) {
-            if (reader.check('\n')) {
-                break
-            }
-            eat()
-        }
+        eat(reader.countUntil('\n'))
     }
 
     private fun skipMultilineComments() {
@@ -381,7 +395,11 @@ class CTokenizer private constructor(private val filename: String, private val r
                 incrementLine()
                 continue
             }
-            eat()
+            if (reader.check('*')) {
+                eat()
+                continue
+            }
+            eat(reader.countUntil('*', '\n'))
         }
     }
 
@@ -390,10 +408,10 @@ class CTokenizer private constructor(private val filename: String, private val r
         while (true) {
             if (reader.isDigit()) {
                 append(eat())
-            } else if (reader.isOneFrom('e', 'E') && reader.isOneFrom(1, '+', '-')) {
+            } else if (reader.isOneOf('e', 'E') && reader.isOneOf(1, '+', '-')) {
                 append(eat())
                 append(eat())
-            } else if (reader.isOneFrom('p', 'P') && reader.isOneFrom(1, '+', '-')) {
+            } else if (reader.isOneOf('p', 'P') && reader.isOneOf(1, '+', '-')) {
                 append(eat())
                 append(eat())
             } else if (reader.check('.')) {
@@ -476,7 +494,7 @@ class CTokenizer private constructor(private val filename: String, private val r
                 val where = OriginalPosition(line, saved, filename)
                 val pair = convertToPPNumber(numberString, where)
                 if (pair == null) {
-                    append(Identifier(numberString, OriginalPosition(line, saved, filename), Hideset()))
+                    append(identifier(numberString, OriginalPosition(line, saved, filename)))
                     continue
                 }
 
@@ -485,25 +503,18 @@ class CTokenizer private constructor(private val filename: String, private val r
             }
 
             // Punctuations
-            if (tryPunct(reader.peek())) {
-                val v = reader.peek()
+            if (CharClass.isPunct(reader.peek())) {
                 val saved = position
-                if (reader.inRange(2) &&
-                    isOperator3(v, reader.peekOffset(1), reader.peekOffset(2))) {
-                    val operator = reader.peek(3)
-                    eat(3)
-                    append(Punctuator(operator, OriginalPosition(line, saved, filename)))
-                } else if (reader.inRange(1) && isOperator2(v, reader.peekOffset(1))) {
-                    val operator = reader.peek(2)
-                    eat(2)
-                    append(Punctuator(operator, OriginalPosition(line, saved, filename)))
-                } else if (reader.check("\\\n")) {
+                if (reader.check("\\\n")) {
                     eat(2)
                     incrementLine()
-                } else {
-                    val s = eat()
-                    append(Punctuator(s.toString(), OriginalPosition(line, saved, filename)))
+                    continue
                 }
+
+                val length = punctuatorLength(reader.peek(), reader.peekOrZero(1), reader.peekOrZero(2))
+                val operator = reader.peek(length)
+                eat(length)
+                append(Punctuator(operator, OriginalPosition(line, saved, filename)))
                 continue
             }
 
@@ -511,11 +522,7 @@ class CTokenizer private constructor(private val filename: String, private val r
             if (reader.isLetter()) {
                 val saved = position
                 val identifier = readIdentifier()
-                if (keywords.contains(identifier)) {
-                    append(Keyword(identifier, OriginalPosition(line, saved, filename), Hideset()))
-                } else {
-                    append(Identifier(identifier, OriginalPosition(line, saved, filename), Hideset()))
-                }
+                append(keywordOrIdentifier(identifier, OriginalPosition(line, saved, filename)))
                 continue
             }
 
@@ -524,8 +531,12 @@ class CTokenizer private constructor(private val filename: String, private val r
     }
 
     companion object {
-        fun apply(data: String, filename: String): TokenList {
-            return CTokenizer(filename, StringReader(data)).doTokenize()
+        /**
+         * Tokenizes [data]. Identifier spellings are interned in [symbols] if it is given,
+         * otherwise on the first lookup by the preprocessor.
+         */
+        fun apply(data: String, filename: String, symbols: SymbolTable? = null): TokenList {
+            return CTokenizer(filename, StringReader(data), symbols).doTokenize()
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,48 @@
+package tokenizer
+
+
+/**
+ * Character classification for the tokenizer. Latin-1 characters are classified
+ * with a single table lookup, other characters fall back to Unicode predicates.
+ */
+internal object CharClass {
+    private const val OTHER: Byte   = 0
+    private const val SPACE: Byte   = 1
+    private const val NEWLINE: Byte = 2
+    private const val DIGIT: Byte   = 3
+    private const val LETTER: Byte  = 4
+    private const val PUNCT: Byte   = 5
+
+    private val table = ByteArray(256).also { table ->
+        for (code in table.indices) {
+            val ch = code.toChar()
+            table[code] = when {
+                ch == ' ' || ch == '\t' || ch == '\r' || ch == '\u000C' || ch == '\u000B' -> SPACE
+                ch == '\n' -> NEWLINE
+                ch in '0'..'9' -> DIGIT
+                ch.isLetter() || ch == '_' -> LETTER
+                ch in "!\"#$%&()*+,-./:;<=>?@[\\]^`{|}~" -> PUNCT
+                else -> OTHER
+            }
+        }
+    }
+
+    private fun of(ch: Char): Byte {
+        val code = ch.code
+        if (code < table.size) {
+            return table[code]
+        }
+
+        return if (ch.isLetter()) LETTER else OTHER
+    }
+
+    fun isSpace(ch: Char): Boolean = of(ch) == SPACE
+    fun isDigit(ch: Char): Boolean = of(ch) == DIGIT
+    fun isLetter(ch: Char): Boolean = of(ch) == LETTER
+    fun isPunct(ch: Char): Boolean = of(ch) == PUNCT
+
+    fun isIdentifierPart(ch: Char): Boolean {
+        val cls = of(ch)
+        return cls == LETTER || cls == DIGIT
+    }
+}
@@ -34,24 +34,31 @@ object LexicalElements {
     // 6.4.6 Punctuators
     private val punctuators = unaryOperators + binaryOperators + ternaryOperators + postPreFixOperators + assignmentOperators
     val allPunctuators = punctuators + setOf("->", "(", ")", "[", "]", "{", "}", ";", ",", ".", "...", "#", "##") //TODO add binary operators
-    private val operators2 = allPunctuators.filter { it.length == 2 }
-    private val operators3 = allPunctuators.filter { it.length == 3 }
-
-    fun isOperator2(ch1: Char, ch2: Char): Boolean { //TODO remove
-        for (operator in operators2) {
-            if (operator[0] == ch1 && operator[1] == ch2) {
-                return true
-            }
-        }
-        return false
-    }
 
-    fun isOperator3(ch1: Char, ch2: Char, ch3: Char): Boolean { //TODO remove
-        for (operator in operators3) {
-            if (operator[0] == ch1 && operator[1] == ch2 && operator[2] == ch3) {
-                return true
-            }
+    // Builtins which the parser recognizes by name
+    val builtinNames = setOf("__builtin_va_list", "__builtin_va_start", "__builtin_va_arg", "__builtin_va_end", "__builtin_va_copy")
+
+    /**
+     * Returns length of the longest punctuator which starts with given chars.
+     * Pass '\u0000' for chars beyond the end of input.
+     */
+    fun punctuatorLength(ch1: Char, ch2: Char, ch3: Char): Int = when (ch1) {
+        '.' -> if (ch2 == '.' && ch3 == '.') 3 else 1
+        '<', '>' -> when (ch2) {
+            ch1  -> if (ch3 == '=') 3 else 2
+            '='  -> 2
+            else -> 1
+        }
+        '-' -> when (ch2) {
+            '-', '=', '>' -> 2
+            else -> 1
+        }
+        '+', '&', '|' -> when (ch2) {
+            ch1, '=' -> 2
+            else -> 1
         }
-        return false
+        '#' -> if (ch2 == '#') 2 else 1
+        '*', '/', '%', '^', '=', '!' -> if (ch2 == '=') 2 else 1
+        else -> 1
     }
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+package tokenizer
+
+
+/**
+ * Predefined [SymbolTable] ids of the spellings checked by the parser. Ids are looked up once,
+ * so a token check is a plain int comparison.
+ */
+object Spelling {
+    val BOOL     = SymbolTable.predefined("_Bool")
+    val NORETURN = SymbolTable.predefined("_Noreturn")
+    val AUTO     = SymbolTable.predefined("auto")
+    val BREAK    = SymbolTable.predefined("break")
+    val CASE     = SymbolTable.predefined("case")
+    val CHAR     = SymbolTable.predefined("char")
+    val CONST    = SymbolTable.predefined("const")
+    val CONTINUE = SymbolTable.predefined("continue")
+    val DEFAULT  = SymbolTable.predefined("default")
+    val DO       = SymbolTable.predefined("do")
+    val DOUBLE   = SymbolTable.predefined("double")
+    val ELSE     = SymbolTable.predefined("else")
+    val ENUM     = SymbolTable.predefined("enum")
+    val EXTERN   = SymbolTable.predefined("extern")
+    val FLOAT    = SymbolTable.predefined("float")
+    val FOR      = SymbolTable.predefined("for")
+    val GOTO     = SymbolTable.predefined("goto")
+    val IF       = SymbolTable.predefined("if")
+    val INLINE   = SymbolTable.predefined("inline")
+    val INT      = SymbolTable.predefined("int")
+    val LONG     = SymbolTable.predefined("long")
+    val REGISTER = SymbolTable.predefined("register")
+    val RESTRICT = SymbolTable.predefined("restrict")
+    val RETURN   = SymbolTable.predefined("return")
+    val SHORT    = SymbolTable.predefined("short")
+    val SIGNED   = SymbolTable.predefined("signed")
+    val SIZEOF   = SymbolTable.predefined("sizeof")
+    val STATIC   = SymbolTable.predefined("static")
+    val STRUCT   = SymbolTable.predefined("struct")
+    val SWITCH   = SymbolTable.predefined("switch")
+    val TYPEDEF  = SymbolTable.predefined("typedef")
+    val UNION    = SymbolTable.predefined("union")
+    val UNSIGNED = SymbolTable.predefined("unsigned")
+    val VOID     = SymbolTable.predefined("void")
+    val VOLATILE = SymbolTable.predefined("volatile")
+    val WHILE    = SymbolTable.predefined("while")
+
+    val BUILTIN_VA_ARG   = SymbolTable.predefined("__builtin_va_arg")
+    val BUILTIN_VA_COPY  = SymbolTable.predefined("__builtin_va_copy")
+    val BUILTIN_VA_END   = SymbolTable.predefined("__builtin_va_end")
+    val BUILTIN_VA_LIST  = SymbolTable.predefined("__builtin_va_list")
+    val BUILTIN_VA_START = SymbolTable.predefined("__builtin_va_start")
+
+    val NOT            = SymbolTable.predefined("!")
+    val NE             = SymbolTable.predefined("!=")
+    val PERCENT        = SymbolTable.predefined("%")
+    val PERCENT_ASSIGN = SymbolTable.predefined("%=")
+    val AMPERSAND      = SymbolTable.predefined("&")
+    val AND_AND        = SymbolTable.predefined("&&")
+    val AND_ASSIGN     = SymbolTable.predefined("&=")
+    val LPAREN         = SymbolTable.predefined("(")
+    val RPAREN         = SymbolTable.predefined(")")
+    val STAR           = SymbolTable.predefined("*")
+    val STAR_ASSIGN    = SymbolTable.predefined("*=")
+    val PLUS           = SymbolTable.predefined("+")
+    val INC            = SymbolTable.predefined("++")
+    val PLUS_ASSIGN    = SymbolTable.predefined("+=")
+    val COMMA          = SymbolTable.predefined(",")
+    val MINUS          = SymbolTable.predefined("-")
+    val DEC            = SymbolTable.predefined("--")
+    val MINUS_ASSIGN   = SymbolTable.predefined("-=")
+    val ARROW          = SymbolTable.predefined("->")
+    val DOT            = SymbolTable.predefined(".")
+    val SLASH          = SymbolTable.predefined("/")
+    val SLASH_ASSIGN   = SymbolTable.predefined("/=")
+    val COLON          = SymbolTable.predefined(":")
+    val SEMICOLON      = SymbolTable.predefined(";")
+    val LT             = SymbolTable.predefined("<")
+    val SHL            = SymbolTable.predefined("<<")
+    val SHL_ASSIGN     = SymbolTable.predefined("<<=")
+    val LE             = SymbolTable.predefined("<=")
+    val ASSIGN         = SymbolTable.predefined("=")
+    val EQ             = SymbolTable.predefined("==")
+    val GT             = SymbolTable.predefined(">")
+    val GE             = SymbolTable.predefined(">=")
+    val SHR            = SymbolTable.predefined(">>")
+    val SHR_ASSIGN     = SymbolTable.predefined(">>=")
+    val QUESTION       = SymbolTable.predefined("?")
+    val LBRACKET       = SymbolTable.predefined("[")
+    val RBRACKET       = SymbolTable.predefined("]")
+    val XOR            = SymbolTable.predefined("^")
+    val XOR_ASSIGN     = SymbolTable.predefined("^=")
+    val LBRACE         = SymbolTable.predefined("{")
+    val OR             = SymbolTable.predefined("|")
+    val OR_ASSIGN      = SymbolTable.predefined("|=")
+    val OR_OR          = SymbolTable.predefined("||")
+    val RBRACE         = SymbolTable.predefined("}")
+    val TILDE          = SymbolTable.predefined("~")
+}
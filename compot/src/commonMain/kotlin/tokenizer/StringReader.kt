@@ -30,24 +30,19 @@ class StringReader(val str: String, var pos: Int = 0) {
         if (eof) {
             return false
         }
-        val ch = peek()
-        return ch.isLetter() || ch == '_'
+        return CharClass.isLetter(str[pos])
     }
 
-    fun isOneFrom(vararg char: Char): Boolean {
-        if (eof) {
-            return false
-        }
-        val ch = peek()
-        return char.contains(ch)
+    fun isOneOf(first: Char, second: Char): Boolean {
+        return isOneOf(0, first, second)
     }
 
-    fun isOneFrom(offset: Int, vararg char: Char): Boolean {
+    fun isOneOf(offset: Int, first: Char, second: Char): Boolean {
         if (eof(offset)) {
             return false
         }
-        val ch = peekOffset(offset)
-        return char.contains(ch)
+        val ch = str[pos + offset]
+        return ch == first || ch == second
     }
 
     fun isHexDigit(): Boolean {
@@ -63,8 +58,7 @@ class StringReader(val str: String, var pos: Int = 0) {
             return false
         }
 
-        val ch = peekOffset(offset)
-        return ch.isDigit()
+        return CharClass.isDigit(str[pos + offset])
     }
 
     fun isBinary(offset: Int = 0): Boolean {
@@ -89,8 +83,49 @@ class StringReader(val str: String, var pos: Int = 0) {
         if (eof(offset)) {
             return false
         }
-        val ch = peekOffset(offset)
-        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\u000C' || ch == '\u000B'
+        return CharClass.isSpace(str[pos + offset])
+    }
+
+    fun countUntil(char: Char): Int {
+        return countUntil(char, char)
+    }
+
+    /**
+     * Returns count of chars before the nearest [first] or [second] char or the end of input.
+     */
+    fun countUntil(first: Char, second: Char): Int {
+        var end = pos
+        while (end < size) {
+            val ch = str[end]
+            if (ch == first || ch == second) {
+                break
+            }
+            end++
+        }
+        return end - pos
+    }
+
+    fun countSpaces(): Int {
+        var end = pos
+        while (end < size && CharClass.isSpace(str[end])) {
+            end++
+        }
+        return end - pos
+    }
+
+    fun countIdentifierPart(): Int {
+        var end = pos
+        while (end < size && CharClass.isIdentifierPart(str[end])) {
+            end++
+        }
+        return end - pos
+    }
+
+    /**
+     * Returns char at [offset] or '\u0000' if it is beyond the end of input.
+     */
+    fun peekOrZero(offset: Int): Char {
+        return if (pos + offset < size) str[pos + offset] else '\u0000'
     }
 
     fun check(char: Char): Boolean {
@@ -130,19 +165,4 @@ class StringReader(val str: String, var pos: Int = 0) {
     fun read(count: Int) {
         pos += count
     }
-
-    companion object {
-        private val punctuation = arrayOf(
-            '!', '"', '#', '$', '%', '&', '(', ')', '*', '+', ',', '-', '.', '/', ':', ';', '<', '=',
-            '>','?','@','[','\\',']','^','`','{','|','}','~',' ','\t','\n'
-        )
-
-        fun tryPunct(ch: Char): Boolean {
-            return punctuation.contains(ch)
-        }
-
-        fun isSeparator(char: Char): Boolean {
-            return punctuation.contains(char)
-        }
-    }
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+package tokenizer
+
+
+/**
+ * Interned token spellings of a single compilation, mostly identifiers and keywords. Every distinct spelling gets
+ * a dense integer id and a single shared [String] instance, so name-keyed tables may be indexed by id,
+ * and string comparisons of interned names take the identity fast path.
+ * Keywords, punctuators and builtin names take the first ids in every table, keywords first,
+ * so [predefined] ids are the same in all compilations.
+ */
+class SymbolTable {
+    private val ids = hashMapOf<String, Int>()
+    private val names = arrayListOf<String>()
+
+    init {
+        for (name in predefinedList) {
+            intern(name)
+        }
+    }
+
+    fun intern(name: String): Int {
+        val id = ids[name]
+        if (id != null) {
+            return id
+        }
+
+        val newId = names.size
+        names.add(name)
+        ids[name] = newId
+        return newId
+    }
+
+    fun find(name: String): Int {
+        return ids[name] ?: NO_SYMBOL
+    }
+
+    fun name(id: Int): String = names[id]
+
+    fun size(): Int = names.size
+
+    companion object {
+        const val NO_SYMBOL = -1
+
+        private val predefinedList = LexicalElements.keywords.toList() + LexicalElements.allPunctuators + LexicalElements.builtinNames
+        private val predefinedIds = predefinedList.withIndex().associate { it.value to it.index }
+
+        fun predefined(name: String): Int {
+            return predefinedIds[name] ?: NO_SYMBOL
+        }
+
+        fun isKeyword(id: Int): Boolean = id >= 0 && id < LexicalElements.keywords.size
+
+        fun keyword(name: String): Int {
+            val id = predefined(name)
+            return if (isKeyword(id)) id else NO_SYMBOL
+        }
+    }
+}
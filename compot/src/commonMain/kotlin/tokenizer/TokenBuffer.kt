@@ -0,0 +1,108 @@
+package tokenizer
+
+import tokenizer.tokens.*
+
+
+/**
+ * Array-backed buffer of preprocessed tokens consumed by the parser.
+ * Token kinds and spelling ids of the compilation [SymbolTable] are kept in flat arrays, so the parser checks tokens
+ * without touching the token objects. The objects are only read when a token goes into the AST.
+ * Space tokens are not stored: they are recorded as flags of the following token,
+ * so the parser walks and backtracks over the buffer with a plain index.
+ */
+class TokenBuffer private constructor(private val tokens: Array<CToken>,
+                                      private val spellings: IntArray,
+                                      private val attributes: ByteArray) {
+    fun size(): Int = tokens.size
+
+    operator fun get(index: Int): CToken = tokens[index]
+
+    /**
+     * One of the kind bits, e.g. [IDENTIFIER].
+     */
+    fun kind(index: Int): Int = 1 shl (attributes[index].toInt() and KIND_MASK)
+
+    fun isKind(index: Int, kindMask: Int): Boolean = kind(index) and kindMask != 0
+
+    /**
+     * Id of the token spelling in the compilation [SymbolTable], [SymbolTable.NO_SYMBOL] for literals.
+     */
+    fun spelling(index: Int): Int = spellings[index]
+
+    fun isSpelling(index: Int, spelling: Int): Boolean = spellings[index] == spelling
+
+    fun hasLeadingSpace(index: Int): Boolean = attributes[index].toInt() and LEADING_SPACE != 0
+
+    fun startsLine(index: Int): Boolean = attributes[index].toInt() and NEW_LINE != 0
+
+    companion object {
+        const val IDENTIFIER    = 1
+        const val KEYWORD       = 2
+        const val PUNCTUATOR    = 4
+        const val NUMBER        = 8
+        const val CHAR_LITERAL  = 16
+        const val STRING        = 32
+        const val FUNCTION_MARK = 64
+
+        const val ANY_STRING_LITERAL = STRING or FUNCTION_MARK
+
+        // Attribute byte: bit number of the kind in the low bits, then the space flags
+        private const val KIND_MASK     = 7
+        private const val LEADING_SPACE = 8
+        private const val NEW_LINE      = 16
+
+        private fun kindBitOf(token: CToken): Int = when (token) {
+            is Identifier    -> 0
+            is Keyword       -> 1
+            is Punctuator    -> 2
+            is PPNumber      -> 3
+            is CharLiteral   -> 4
+            is StringLiteral -> 5
+            is FunctionMark  -> 6
+        }
+
+        private fun spellingOf(token: CToken, symbols: SymbolTable): Int = when (token) {
+            is Identifier -> token.symbol(symbols)
+            is Keyword    -> token.symbol(symbols)
+            is Punctuator -> SymbolTable.predefined(token.data)
+            else          -> SymbolTable.NO_SYMBOL
+        }
+
+        /**
+         * Moves the tokens of [tokenList] into a buffer, [tokenList] is empty afterwards.
+         * Tokens are unlinked on the way, so the space tokens aren't kept alive by their neighbours.
+         * Identifier spellings are taken from [symbols], normally the symbol table of the preprocessor.
+         */
+        fun of(tokenList: TokenList, symbols: SymbolTable): TokenBuffer {
+            var count = 0
+            for (token in tokenList) {
+                if (token is CToken) {
+                    count++
+                }
+            }
+
+            val tokens = arrayOfNulls<CToken>(count)
+            val spellings = IntArray(count)
+            val attributes = ByteArray(count)
+            var index = 0
+            var pending = 0
+            while (tokenList.isNotEmpty()) {
+                when (val token = tokenList.removeFirst()) {
+                    is Indent  -> pending = pending or LEADING_SPACE
+                    is NewLine -> pending = pending or NEW_LINE
+                    is CToken  -> {
+                        tokens[index] = token
+                        spellings[index] = spellingOf(token, symbols)
+                        attributes[index] = (kindBitOf(token) or pending).toByte()
+                        pending = 0
+                        index++
+                    }
+                    else -> {}
+                }
+            }
+
+            @Suppress("UNCHECKED_CAST")
+            return TokenBuffer(tokens as Array<CToken>, spellings, attributes)
+        }
+    }
+}
@@ -5,7 +5,10 @@ import common.assertion
 import preprocess.Hideset
 
 
-class Identifier(private val data: String, position: Position, private val hideset: Hideset): CToken(position), MacrosName {
+class Identifier private constructor(private val data: String, position: Position, private val hideset: Hideset,
+                                     private var symbols: SymbolTable?, private var symbol: Int): CToken(position), MacrosName {
+    constructor(data: String, position: Position, hideset: Hideset): this(data, position, hideset, null, SymbolTable.NO_SYMBOL)
+
     init {
         assertion(LexicalElements.keywords.contains(data).not()) {
             "Identifier '$data' is a keyword"
@@ -19,12 +22,21 @@ class Identifier(private val data: String, position: Position, private val hides
     override fun str(): String = data
     override fun hideset(): Hideset = hideset
 
+    override fun symbol(symbols: SymbolTable): Int {
+        if (this.symbols !== symbols) {
+            symbol = symbols.intern(data)
+            this.symbols = symbols
+        }
+
+        return symbol
+    }
+
     override fun cloneWith(pos: Position): CToken {
-        return Identifier(data, pos, hideset.copy())
+        return Identifier(data, pos, hideset.copy(), symbols, symbol)
     }
 
     override fun copy(): AnyToken {
-        return Identifier(data, position(), hideset.copy())
+        return Identifier(data, position(), hideset.copy(), symbols, symbol)
     }
 
     override fun hashCode(): Int {
@@ -44,5 +56,19 @@ class Identifier(private val data: String, position: Position, private val hides
         fun unknown(name: String, where: Position): Identifier {
             return Identifier(name, where, Hideset())
         }
+
+        /**
+         * Creates an identifier with the spelling interned in [symbols].
+         */
+        fun interned(symbols: SymbolTable, name: String, where: Position): Identifier {
+            return interned(symbols, symbols.intern(name), where)
+        }
+
+        /**
+         * Creates an identifier with the spelling already interned in [symbols] as [symbol].
+         */
+        fun interned(symbols: SymbolTable, symbol: Int, where: Position): Identifier {
+            return Identifier(symbols.name(symbol), where, Hideset(), symbols, symbol)
+        }
     }
 }
\ No newline at end of file
@@ -3,10 +3,14 @@ package tokenizer.tokens
 import common.assertion
 import preprocess.Hideset
 import tokenizer.LexicalElements
+import tokenizer.SymbolTable
 import tokenizer.Position
 
 
-class Keyword(val data: String, position: Position, private val hideset: Hideset): CToken(position), MacrosName {
+class Keyword private constructor(val data: String, position: Position, private val hideset: Hideset,
+                                  private val symbol: Int): CToken(position), MacrosName {
+    constructor(data: String, position: Position, hideset: Hideset): this(data, position, hideset, SymbolTable.keyword(data))
+
     init {
         assertion(LexicalElements.keywords.contains(data)) {
             "Keyword '$data' is not a keyword"
@@ -15,9 +19,10 @@ class Keyword(val data: String, position: Position, private val hideset: Hideset
 
     override fun str(): String = data
     override fun hideset(): Hideset = hideset
+    override fun symbol(symbols: SymbolTable): Int = symbol
 
     override fun hashCode(): Int {
-        return data.hashCode()
+        return symbol
     }
 
     override fun equals(other: Any?): Boolean {
@@ -26,14 +31,23 @@ class Keyword(val data: String, position: Position, private val hideset: Hideset
 
         other as Keyword
 
-        return data == other.data
+        return symbol == other.symbol
     }
 
     override fun cloneWith(pos: Position): CToken {
-        return Keyword(data, pos, hideset.copy())
+        return Keyword(data, pos, hideset.copy(), symbol)
     }
 
     override fun copy(): AnyToken {
-        return Keyword(data, position(), hideset.copy())
+        return Keyword(data, position(), hideset.copy(), symbol)
+    }
+
+    companion object {
+        /**
+         * Creates a keyword from its [SymbolTable] id, the spelling is not looked up again.
+         */
+        fun of(data: String, symbol: Int, where: Position): Keyword {
+            return Keyword(data, where, Hideset(), symbol)
+        }
     }
 }
\ No newline at end of file
@@ -1,15 +1,21 @@
 package tokenizer.tokens
 
 import preprocess.Hideset
+import tokenizer.SymbolTable
 
 sealed interface MacrosName {
     fun hideset(): Hideset
 
-    fun contains(name: String): Boolean {
-        return hideset().contains(name)
+    /**
+     * Id of the name spelling in [symbols].
+     */
+    fun symbol(symbols: SymbolTable): Int
+
+    fun contains(symbol: Int): Boolean {
+        return hideset().contains(symbol)
     }
 
-    fun add(name: String) {
-        hideset().add(name)
+    fun add(symbol: Int) {
+        hideset().add(symbol)
     }
-}
\ No newline at end of file
+}
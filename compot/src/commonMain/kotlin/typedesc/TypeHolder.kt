@@ -12,6 +12,7 @@ class TypeHolder private constructor(private val valueMap: VarStack<VarDescripto
                                      private val structTypeMap: VarStack<CType>,
                                      private val unionTypeMap: VarStack<CType>,
                                      private val typedefs: VarStack<TypeDesc>,
+                                     private val enumerators: VarStack<CEnumType>,
     private val varMissingHandler: (VarNode) -> CompletedType): Scope {
 
     fun handleMissingVar(varName: VarNode): CompletedType {
@@ -31,16 +32,7 @@ class TypeHolder private constructor(private val valueMap: VarStack<VarDescripto
     }
 
     fun findEnum(name: String): CEnumType? {
-        //TODO cache results
-        for (enumType in enumTypeMap) {
-            if (enumType !is CEnumType) {
-                continue
-            }
-            if (enumType.hasEnumerator(name)) {
-                return enumType
-            }
-        }
-        return null
+        return enumerators[name]
     }
 
     fun getUnionTypeOrNull(name: String): CType? = unionTypeMap[name]
@@ -63,6 +55,12 @@ class TypeHolder private constructor(private val valueMap: VarStack<VarDescripto
         return typedefs[name]
     }
 
+    /**
+     * Changes whenever a typedef is declared. Whether an identifier starts a type name depends on typedefs,
+     * so the parser keys memoized productions on it.
+     */
+    fun typedefVersion(): Int = typedefs.version()
+
     private fun addTypeDesc(name: String, structType: CType, qualifiers: List<TypeQualifier>): TypeDesc {
         val typeDesc = TypeDesc.from(structType, qualifiers)
         typedefs[name] = typeDesc
@@ -100,7 +98,13 @@ class TypeHolder private constructor(private val valueMap: VarStack<VarDescripto
 
     fun addNewType(name: String, type: CType): CType {
         when (type) {
-            is CEnumType, is CUncompletedEnumType -> enumTypeMap[name] = type
+            is CEnumType -> {
+                enumTypeMap[name] = type
+                for (enumerator in type.enumerators()) {
+                    enumerators[enumerator] = type
+                }
+            }
+            is CUncompletedEnumType -> enumTypeMap[name] = type
             is CStructType, is CUncompletedStructType -> structTypeMap[name] = type
             is CUnionType, is CUncompletedUnionType -> unionTypeMap[name] = type
             else -> throw RuntimeException("Unknown type $type")
@@ -113,6 +117,7 @@ class TypeHolder private constructor(private val valueMap: VarStack<VarDescripto
     }
 
     override fun enter() {
+        enumerators.enter()
         enumTypeMap.enter()
         structTypeMap.enter()
         unionTypeMap.enter()
@@ -124,16 +129,15 @@ class TypeHolder private constructor(private val valueMap: VarStack<VarDescripto
         unionTypeMap.leave()
         structTypeMap.leave()
         enumTypeMap.leave()
+        enumerators.leave()
     }
 
-    fun copy(): TypeHolder {
-        val newValueMap = valueMap.copy()
-        val newEnumTypeMap = enumTypeMap.copy()
-        val newStructTypeMap = structTypeMap.copy()
-        val newUnionTypeMap = unionTypeMap.copy()
-        val newTypedefs = typedefs.copy()
-
-        return TypeHolder(newValueMap, newEnumTypeMap, newStructTypeMap, newUnionTypeMap, newTypedefs, varMissingHandler)
+    /**
+     * Creates a holder for function scope. Global declarations are shared, not copied,
+     * so the cost depends only on count of local declarations.
+     */
+    fun overlay(): TypeHolder {
+        return TypeHolder(valueMap.overlay(), enumTypeMap.overlay(), structTypeMap.overlay(), unionTypeMap.overlay(), typedefs.overlay(), enumerators.overlay(), varMissingHandler)
     }
 
     companion object {
@@ -148,7 +152,8 @@ class TypeHolder private constructor(private val valueMap: VarStack<VarDescripto
             val unionTypeMap = VarStack<CType>()
 
             val typedefs = VarStack<TypeDesc>()
-            return TypeHolder(valueMap, enumTypeMap, structTypeMap, unionTypeMap, typedefs, handler)
+            val enumerators = VarStack<CEnumType>()
+            return TypeHolder(valueMap, enumTypeMap, structTypeMap, unionTypeMap, typedefs, enumerators, handler)
         }
 
         private fun defaultVarMissingHandler(varName: VarNode): CompletedType {
@@ -9,6 +9,8 @@ data class CEnumType(val name: String, private val enumerators: Map<String, Int>
         return enumerators.contains(name)
     }
 
+    fun enumerators(): Set<String> = enumerators.keys
+
     fun enumerator(name: String): Int? {
         return enumerators[name] //TODO temporal
     }
@@ -0,0 +1,60 @@
+import codegen.GenerateIR
+import intrinsic.CIntrinsicResolver
+import ir.bin.BinaryFormatException
+import ir.bin.ModuleBinaryReader
+import ir.bin.ModuleBinaryWriter
+import ir.instruction.Intrinsic
+import ir.module.SSAModule
+import parser.CProgramParser
+import tokenizer.CTokenizer
+import kotlin.test.*
+
+
+class CIntrinsicResolverTest {
+    private fun generate(input: String): SSAModule {
+        val parser = CProgramParser.build(CTokenizer.apply(input, "<test-data>"))
+        val program = parser.translation_unit()
+        return GenerateIR.apply(parser.globalTypeHolder(), program)
+    }
+
+    private fun intrinsics(module: SSAModule): List<Intrinsic> {
+        return module.findFunction("sum").blocks().flatMap { bb -> bb.filterIsInstance<Intrinsic>() }
+    }
+
+    private val withVarArgs = """
+        int sum(int count, ...) {
+            __builtin_va_list args;
+            __builtin_va_start(args, count);
+            int total = 0;
+            for (int i = 0; i < count; i++) {
+                total += __builtin_va_arg(args, int);
+            }
+            __builtin_va_end(args);
+            return total;
+        }
+    """
+
+    @Test
+    fun testVarArgsRoundTrip() {
+        val module = generate(withVarArgs)
+        val bytes = ModuleBinaryWriter.write(module)
+        val read = ModuleBinaryReader.read(bytes, CIntrinsicResolver)
+
+        val expected = intrinsics(module)
+        val actual = intrinsics(read)
+        assertEquals(listOf("va_init", "va_start"), actual.map { it.implementor.name }.sorted())
+        assertEquals(expected.map { it.implementor.name }.sorted(), actual.map { it.implementor.name }.sorted())
+        for (intrinsic in actual) {
+            val original = expected.first { it.implementor.name == intrinsic.implementor.name }
+            assertContentEquals(original.implementor.parameters(), intrinsic.implementor.parameters())
+        }
+
+        assertContentEquals(bytes, ModuleBinaryWriter.write(read))
+    }
+
+    @Test
+    fun testReaderWithoutResolver() {
+        val bytes = ModuleBinaryWriter.write(generate(withVarArgs))
+        assertFailsWith<BinaryFormatException> { ModuleBinaryReader.read(bytes) }
+    }
+}
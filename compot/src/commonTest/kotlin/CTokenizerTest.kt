@@ -247,4 +247,46 @@ class CTokenizerTest {
         assertTrue { tokens[0] is AnyStringLiteral }
         tokens[0].isEqual(1, 1, "\"&ELF\"")
     }
-}
\ No newline at end of file
+
+    @Test
+    fun testPunctuators() {
+        val tokens = apply("a<<=b>>c...d->e##f<g/*x*\ny*/.h//z\n").toCTokenList()
+        val expected = listOf("a", "<<=", "b", ">>", "c", "...", "d", "->", "e", "##", "f", "<", "g", ".", "h")
+        assertEquals(expected, tokens.map { it.str() })
+        tokens[13].isEqual(2, 3, ".")
+    }
+
+    @Test
+    fun testTokenBuffer() {
+        val symbols = SymbolTable()
+        val tokens = apply("int a;\n  a = 1;")
+        val buffer = TokenBuffer.of(tokens, symbols)
+        assertTrue(tokens.isEmpty())
+        assertEquals(7, buffer.size())
+        buffer[0].isEqual(1, 1, "int")
+        assertEquals("=", buffer[4].str())
+        assertEquals(2, buffer[4].line())
+        assertFalse(buffer.hasLeadingSpace(0))
+        assertTrue(buffer.hasLeadingSpace(1))
+        assertFalse(buffer.hasLeadingSpace(2))
+        assertTrue(buffer.startsLine(3))
+        assertTrue(buffer.hasLeadingSpace(3))
+        assertFalse(buffer.startsLine(4))
+
+        assertEquals(TokenBuffer.KEYWORD, buffer.kind(0))
+        assertEquals(TokenBuffer.IDENTIFIER, buffer.kind(1))
+        assertEquals(TokenBuffer.PUNCTUATOR, buffer.kind(2))
+        assertEquals(TokenBuffer.NUMBER, buffer.kind(5))
+        assertTrue(buffer.isKind(3, TokenBuffer.IDENTIFIER or TokenBuffer.KEYWORD))
+        assertFalse(buffer.isKind(4, TokenBuffer.ANY_STRING_LITERAL))
+
+        assertEquals(Spelling.INT, buffer.spelling(0))
+        assertEquals(symbols.find("a"), buffer.spelling(1))
+        assertEquals(buffer.spelling(1), buffer.spelling(3))
+        assertEquals(Spelling.SEMICOLON, buffer.spelling(6))
+        assertEquals(SymbolTable.NO_SYMBOL, buffer.spelling(5))
+        assertTrue(buffer.isSpelling(4, Spelling.ASSIGN))
+        assertFalse(buffer.isSpelling(4, Spelling.EQ))
+        assertFalse(buffer.isSpelling(1, symbols.intern("b")))
+    }
+}
@@ -0,0 +1,105 @@
+import preprocess.*
+import tokenizer.CTokenizer
+import tokenizer.TokenList
+import tokenizer.TokenPrinter
+import tokenizer.tokens.Identifier
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFalse
+import kotlin.test.assertTrue
+
+
+class HidesetTest {
+    private fun preprocess(data: String, ctx: PreprocessorContext): TokenList {
+        val tokens = CTokenizer.apply(data, "<test-data>", ctx.symbols())
+        return CProgramPreprocessor.create("<test-data>", tokens, ctx).preprocess()
+    }
+
+    private fun context(): PreprocessorContext {
+        return PreprocessorContext.create(PredefinedHeaderHolder(setOf()))
+    }
+
+    @Test
+    fun testEmpty() {
+        val hideset = Hideset()
+        assertFalse(hideset.contains(0))
+        assertFalse(hideset.copy().contains(0))
+    }
+
+    @Test
+    fun testAddBeyondInitialCapacity() {
+        val hideset = Hideset()
+        for (symbol in 0 until 10) {
+            hideset.add(symbol)
+        }
+
+        for (symbol in 0 until 10) {
+            assertTrue(hideset.contains(symbol))
+        }
+        assertFalse(hideset.contains(10))
+    }
+
+    @Test
+    fun testCopyIsIndependent() {
+        val hideset = Hideset()
+        hideset.add(1)
+        val copy = hideset.copy()
+        copy.add(2)
+        hideset.add(3)
+
+        assertTrue(copy.contains(1))
+        assertTrue(copy.contains(2))
+        assertFalse(copy.contains(3))
+        assertFalse(hideset.contains(2))
+    }
+
+    @Test
+    fun testAddAll() {
+        val hideset = Hideset()
+        hideset.add(1)
+        hideset.add(2)
+        val other = Hideset()
+        other.add(2)
+        other.add(3)
+        hideset.addAll(other)
+
+        assertTrue(hideset.contains(1))
+        assertTrue(hideset.contains(2))
+        assertTrue(hideset.contains(3))
+        assertFalse(other.contains(1))
+    }
+
+    @Test
+    fun testNestedExpansionUnitesNames() {
+        val data = """
+            |#define f g
+            |#define g f
+            |f
+        """.trimMargin()
+
+        val ctx = context()
+        val result = preprocess(data, ctx)
+        assertEquals("\n\nf", TokenPrinter.print(result))
+
+        val name = result.filterIsInstance<Identifier>().single()
+        assertTrue(name.contains(ctx.symbols().find("f")))
+        assertTrue(name.contains(ctx.symbols().find("g")))
+    }
+
+    @Test
+    fun testFunctionLikeExpansionDropsNameHideset() {
+        val data = """
+            |#define f(a) a*g
+            |#define g(a) f(a)
+            |f(2)(9)
+        """.trimMargin()
+
+        val ctx = context()
+        val result = preprocess(data, ctx)
+        assertEquals("\n\n2*9*g", TokenPrinter.print(result))
+
+        val g = result.filterIsInstance<Identifier>().single()
+        assertTrue(g.contains(ctx.symbols().find("f")))
+        assertFalse(g.contains(ctx.symbols().find("g")))
+    }
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 
 import parser.CProgramParser
 import parser.LineAgnosticAstPrinter
+import parser.MemoTable
 import parser.ParserException
 import parser.nodes.AbstractDeclarator
 import parser.nodes.AnyDeclarator
@@ -12,6 +13,11 @@ import parser.nodes.FunctionNode
 import parser.nodes.Statement
 import tokenizer.CTokenizer
 import tokenizer.TokenList
+import typedesc.TypeDesc
+import typedesc.TypeHolder
+import typedesc.Typedef
+import types.INT
+import types.LONG
 import kotlin.test.*
 
 
@@ -1163,4 +1169,67 @@ class ParserTest {
         val program = parser.translation_unit()
         assertEquals("typedef struct point {int x; int y;} Point; Point *p = &(Point){1, 1};", LineAgnosticAstPrinter.print(program))
     }
-}
\ No newline at end of file
+
+    @Test
+    fun testMemoization() {
+        val input = """
+            typedef struct point {int x; int y;} Point;
+            long f(Point* p) { return (long)(int)((Point*)p)->x + sizeof((char)(short)p->y); }
+        """.trimIndent()
+
+        val expected = LineAgnosticAstPrinter.print(CProgramParser.build("<test-data>", apply(input), false).translation_unit())
+        val memoized = LineAgnosticAstPrinter.print(CProgramParser.build("<test-data>", apply(input), true).translation_unit())
+        assertEquals(expected, memoized)
+    }
+
+    @Test
+    fun testMemoizationWithStructAndEnumDefinitions() {
+        // Global declarations are parsed as function definitions first, then declaration specifiers are replayed.
+        val input = """
+            struct S {int x; long y;} s;
+            enum E {A, B = 4} e;
+            int f(void) { struct S {char c;} t; enum F {C = B} u; return (int)sizeof(t) + (enum F)C; }
+        """.trimIndent()
+
+        val expected = LineAgnosticAstPrinter.print(CProgramParser.build("<test-data>", apply(input), false).translation_unit())
+        val parser = CProgramParser.build("<test-data>", apply(input), true)
+        assertEquals(expected, LineAgnosticAstPrinter.print(parser.translation_unit()))
+
+        val typeHolder = parser.globalTypeHolder()
+        assertNotNull(typeHolder.getStructTypeOrNull("S"))
+        assertNotNull(typeHolder.getEnumTypeOrNull("E"))
+        assertEquals(4, typeHolder.findEnumByEnumerator("B"))
+        assertNull(typeHolder.getEnumTypeOrNull("F"))
+    }
+
+    @Test
+    fun testMemoizationWithShadowedTypedef() {
+        val input = """
+            typedef int T;
+            int f(void) { typedef T *T; T p = (T)0; return (T)p != 0; }
+            T g = (T)1;
+        """.trimIndent()
+
+        val expected = LineAgnosticAstPrinter.print(CProgramParser.build("<test-data>", apply(input), false).translation_unit())
+        val parser = CProgramParser.build("<test-data>", apply(input), true)
+        assertEquals(expected, LineAgnosticAstPrinter.print(parser.translation_unit()))
+        assertEquals(INT, parser.globalTypeHolder().getTypedefOrNull("T")?.cType())
+    }
+
+    @Test
+    fun testMemoEntryIsDroppedWhenTypedefsChange() {
+        val global = TypeHolder.default()
+        val local = global.overlay()
+        val table = MemoTable<String>()
+        table[0] = MemoTable.Entry("T", 1, local, local.typedefVersion())
+        assertNotNull(table.find(0, local))
+        assertNull(table.find(0, global))
+
+        local.addTypedef(Typedef("T", TypeDesc.from(INT, listOf())))
+        assertNull(table.find(0, local))
+
+        table[0] = MemoTable.Entry("T", 1, local, local.typedefVersion())
+        global.addTypedef(Typedef("U", TypeDesc.from(LONG, listOf())))
+        assertNull(table.find(0, local))
+    }
+}
@@ -0,0 +1,86 @@
+import preprocess.*
+import preprocess.macros.MacroDefinition
+import preprocess.macros.MacroReplacement
+import tokenizer.CTokenizer
+import tokenizer.SymbolTable
+import tokenizer.tokens.Identifier
+import tokenizer.tokens.Keyword
+import kotlin.test.*
+
+
+class PreprocessorContextTest {
+    private fun context(): PreprocessorContext {
+        return PreprocessorContext.create(PredefinedHeaderHolder(setOf()))
+    }
+
+    private fun replacement(name: String, value: String): MacroReplacement {
+        return MacroReplacement(name, CTokenizer.apply(value, "<test-data>"))
+    }
+
+    @Test
+    fun testRedefine() {
+        val ctx = context()
+        val first = replacement("A", "1")
+        val second = replacement("A", "2")
+
+        ctx.define(first)
+        val symbol = ctx.symbols().find("A")
+        assertSame(first, ctx.findMacros(symbol))
+
+        ctx.define(second)
+        assertSame(second, ctx.findMacros(symbol))
+        assertSame(second, ctx.findMacros("A"))
+    }
+
+    @Test
+    fun testUndef() {
+        val ctx = context()
+        ctx.define(replacement("A", "1"))
+        val definition = MacroDefinition("B")
+        ctx.define(definition)
+
+        ctx.undef("A")
+        assertNull(ctx.findMacros(ctx.symbols().find("A")))
+        assertNull(ctx.findMacros("A"))
+        assertSame(definition, ctx.findMacros("B"))
+
+        ctx.undef("C")
+        assertNull(ctx.findMacros("C"))
+    }
+
+    @Test
+    fun testRedefineAfterUndef() {
+        val ctx = context()
+        ctx.define(MacroDefinition("A"))
+        ctx.undef("A")
+        val second = replacement("A", "2")
+        ctx.define(second)
+
+        assertSame(second, ctx.findMacros(ctx.symbols().find("A")))
+    }
+
+    @Test
+    fun testTokenSymbols() {
+        val ctx = context()
+        val interned = CTokenizer.apply("A", "<test-data>", ctx.symbols()).filterIsInstance<Identifier>().single()
+        val lazy = CTokenizer.apply("A", "<test-data>").filterIsInstance<Identifier>().single()
+
+        assertEquals(ctx.symbols().find("A"), interned.symbol(ctx.symbols()))
+        assertEquals(interned.symbol(ctx.symbols()), lazy.symbol(ctx.symbols()))
+    }
+
+    @Test
+    fun testContextsDoNotShareSymbols() {
+        val first = context()
+        val second = context()
+        first.define(replacement("ONLY_FIRST", "1"))
+
+        assertNotNull(first.findMacros("ONLY_FIRST"))
+        assertNull(second.findMacros("ONLY_FIRST"))
+        assertEquals(SymbolTable.NO_SYMBOL, second.symbols().find("ONLY_FIRST"))
+
+        val keyword = CTokenizer.apply("int", "<test-data>").filterIsInstance<Keyword>().single()
+        assertEquals(keyword.symbol(first.symbols()), keyword.symbol(second.symbols()))
+        assertEquals("int", first.symbols().name(keyword.symbol(first.symbols())))
+    }
+}
\ No newline at end of file
@@ -618,6 +618,51 @@ class TypeResolutionTest {
         assertEquals("unsigned long", typeHolder.getTypedef("A").cType().toString())
     }
 
+    @Test
+    fun testLocalTypedefIsInvisibleGlobally() {
+        val input = """
+            typedef unsigned long A;
+            int f() { typedef int B; return 0; }
+            int g() { typedef char A; return 0; }
+        """.trimIndent()
+        val tokens = apply(input)
+        val parser = CProgramParser.build(tokens)
+
+        val program = parser.translation_unit()
+        val typeHolder = parser.globalTypeHolder()
+        assertEquals(null, typeHolder.getTypedefOrNull("B"))
+        assertEquals("unsigned long", typeHolder.getTypedef("A").cType().toString())
+
+        val functions = program.nodes.filterIsInstance<FunctionDeclarationNode>().map { it.function.typeHolder }
+        assertEquals("int", functions[0].getTypedef("B").cType().toString())
+        assertEquals("unsigned long", functions[0].getTypedef("A").cType().toString())
+        assertEquals(null, functions[1].getTypedefOrNull("B"))
+        assertEquals("char", functions[1].getTypedef("A").cType().toString())
+    }
+
+    @Test
+    fun testEnumerators() {
+        val input = """
+            enum Color { RED, GREEN = 5, BLUE };
+            enum Shape { CIRCLE = GREEN + 1, SQUARE };
+            int f() { enum Local { RED = 10 }; return RED; }
+        """.trimIndent()
+        val tokens = apply(input)
+        val parser = CProgramParser.build(tokens)
+
+        val program = parser.translation_unit()
+        val typeHolder = parser.globalTypeHolder()
+        assertEquals(0, typeHolder.findEnumByEnumerator("RED"))
+        assertEquals(6, typeHolder.findEnumByEnumerator("BLUE"))
+        assertEquals(7, typeHolder.findEnumByEnumerator("SQUARE"))
+        assertEquals("Shape", typeHolder.findEnum("CIRCLE")?.name)
+        assertEquals(null, typeHolder.findEnumByEnumerator("UNKNOWN"))
+
+        val function = program.nodes.filterIsInstance<FunctionDeclarationNode>().first().function
+        assertEquals(10, function.typeHolder.findEnumByEnumerator("RED"))
+        assertEquals(5, function.typeHolder.findEnumByEnumerator("GREEN"))
+    }
+
     @Test
     fun testStaticStorageClass() {
         val input = """
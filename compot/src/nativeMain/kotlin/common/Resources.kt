@@ -1,5 +1,24 @@
+@file:OptIn(ExperimentalForeignApi::class)
+
 package common
 
-actual fun getInclude(filename: String): String? {
-    TODO("Not yet implemented")
-}
\ No newline at end of file
+import kotlinx.cinterop.*
+import platform.posix.*
+
+
+// Native executable has no resources: built-in headers are installed next to it.
+private val includeDirectory: String by lazy {
+    val buffer = ByteArray(PATH_MAX)
+    val length = readlink("/proc/self/exe", buffer.refTo(0), (buffer.size - 1).convert())
+    val executable = if (length > 0) buffer.decodeToString(0, length.toInt()) else "."
+    FileUtils.resolve(FileUtils.getDirName(executable), "compot-includes")
+}
+
+actual fun getBuildInHeader(filename: String): String? {
+    val path = FileUtils.resolve(includeDirectory, filename)
+    if (!fileExists(path)) {
+        return null
+    }
+
+    return readTextFile(path)
+}
@@ -1,6 +1,7 @@
 import org.gradle.api.tasks.testing.logging.TestExceptionFormat
 import org.gradle.api.tasks.testing.logging.TestLogEvent
 import org.jetbrains.kotlin.gradle.ExperimentalKotlinGradlePluginApi
+import org.jetbrains.kotlin.gradle.targets.native.tasks.KotlinNativeTest
 
 plugins {
     id("kotlin-common")
@@ -19,6 +20,14 @@ kotlin {
         }
     }
 
+    linuxX64 {
+        binaries {
+            executable {
+                entryPoint = "main"
+            }
+        }
+    }
+
     sourceSets {
         commonMain {
             dependencies {
@@ -40,4 +49,12 @@ tasks.withType(Test::class).all {
         events = setOf(TestLogEvent.PASSED, TestLogEvent.SKIPPED, TestLogEvent.FAILED, TestLogEvent.STANDARD_OUT, TestLogEvent.STANDARD_ERROR)
         exceptionFormat = TestExceptionFormat.FULL
     }
-}
\ No newline at end of file
+}
+
+tasks.withType(KotlinNativeTest::class.java).all {
+    dependsOn(":examples:build")
+
+    workingDir = projectDir.absolutePath
+    mkdir("test-results")
+    environment("TEST_RESULT_DIR", "test-results")
+}
@@ -1,9 +1,22 @@
+import common.Extension
+import ir.bin.ModuleBinaryReader
+import ir.bin.ModuleBinaryWriter
 import ir.read.ModuleReader
 import startup.*
 
 
 fun main(args: Array<String>) {
     val cli = CliParser.parse(args) ?: return
-    val module = ModuleReader.read(cli.inputs().first().filename)
+    val input = cli.inputs().first()
+    val module = when (input.extension) {
+        Extension.IRB -> ModuleBinaryReader.read(input.filename)
+        else -> ModuleReader.read(input.filename)
+    }
+
+    val emitBinaryIr = cli.getEmitBinaryIr()
+    if (emitBinaryIr != null) {
+        ModuleBinaryWriter.write(module, emitBinaryIr)
+    }
+
     OptDriver.compile(cli, module)
-}
\ No newline at end of file
+}
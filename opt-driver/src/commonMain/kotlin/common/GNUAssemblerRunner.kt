@@ -2,8 +2,8 @@ package common
 
 
 object GNUAssemblerRunner {
-    fun compileAsm(filename: String, outputFileName: String): ExecutionResult {
+    fun compileAsm(filename: String, outputFileName: String, workingDir: String? = null, environment: Map<String, String>? = null): ExecutionResult {
         val gnuAsCommandLine = listOf(filename, "-o", outputFileName)
-        return runCommand("as", gnuAsCommandLine, null)
+        return runCommand("as", gnuAsCommandLine, workingDir, environment)
     }
 }
\ No newline at end of file
@@ -10,6 +10,8 @@ class GNULdRunner(private val outputFileName: ProcessedFile) {
     private var dynamicLinker: String? = null
     private var static = false
     private var dynamic = false
+    private var workingDir: String? = null
+    private var environment: Map<String, String>? = null
 
     fun crtObjects(objects: List<String>): GNULdRunner {
         crtObjects.addAll(objects)
@@ -51,6 +53,19 @@ class GNULdRunner(private val outputFileName: ProcessedFile) {
         return this
     }
 
+    /**
+     * Directory relative paths of the linker command line are resolved against.
+     */
+    fun workingDirectory(dir: String?): GNULdRunner {
+        workingDir = dir
+        return this
+    }
+
+    fun environment(env: Map<String, String>?): GNULdRunner {
+        environment = env
+        return this
+    }
+
     fun execute(): ExecutionResult {
         val gnuLdCommandLine = arrayListOf<String>()
         gnuLdCommandLine.addAll(listOf("-m", "elf_x86_64"))
@@ -76,6 +91,6 @@ class GNULdRunner(private val outputFileName: ProcessedFile) {
         gnuLdCommandLine.addAll(extraFlags)
 
         println("Linker command: $gnuLdCommandLine")
-        return runCommand("ld", gnuLdCommandLine, null)
+        return runCommand("ld", gnuLdCommandLine, workingDir, environment)
     }
 }
\ No newline at end of file
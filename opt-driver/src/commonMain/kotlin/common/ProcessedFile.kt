@@ -3,6 +3,7 @@ package common
 enum class Extension(val value: String) {
     C(".c"),
     IR(".ir"),
+    IRB(".irb"),
     AR(".a"),
     SO(".so"),
     ASM(".s"),
@@ -46,6 +47,7 @@ class ProcessedFile private constructor(val filename: String, val extension: Ext
             val extension = when {
                 filename.endsWith(Extension.C.value) -> Extension.C
                 filename.endsWith(Extension.IR.value) -> Extension.IR
+                filename.endsWith(Extension.IRB.value) -> Extension.IRB
                 filename.endsWith(Extension.AR.value) -> Extension.AR
                 filename.endsWith(Extension.ASM.value) -> Extension.ASM
                 filename.endsWith(Extension.OBJ.value) -> Extension.OBJ
@@ -1,9 +1,13 @@
 package common
 
-expect fun runCommand(command: String, args: List<String>, workingDir: String? = null): ExecutionResult
+/**
+ * Runs [command] in [workingDir] with [environment] as its whole environment.
+ * The current directory and environment of the compiler process are inherited when they are null.
+ */
+expect fun runCommand(command: String, args: List<String>, workingDir: String? = null, environment: Map<String, String>? = null): ExecutionResult
 
-fun checkedRunCommand(command: String, args: List<String>, workingDir: String? = null): ExecutionResult {
-    val result = runCommand(command, args, workingDir)
+fun checkedRunCommand(command: String, args: List<String>, workingDir: String? = null, environment: Map<String, String>? = null): ExecutionResult {
+    val result = runCommand(command, args, workingDir, environment)
     if (result.exitCode != 0) {
         throw RuntimeException("execution failed with code ${result.exitCode}:\n${result.error}")
     }
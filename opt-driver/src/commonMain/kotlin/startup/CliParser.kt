@@ -1,6 +1,7 @@
 package startup
 
 import common.ProcessedFile
+import ir.platform.x64.MArch
 
 object CliParser {
     fun parse(args: Array<String>): OptCLIArguments? {
@@ -34,6 +35,14 @@ object CliParser {
                     cursor++
                     commandLineArguments.setDumpIrDirectory(args[cursor])
                 }
+                "--emit-irb" -> {
+                    if (cursor + 1 >= args.size) {
+                        println("Expected output filename after --emit-irb")
+                        return null
+                    }
+                    cursor++
+                    commandLineArguments.setEmitBinaryIr(args[cursor])
+                }
                 "-o" -> {
                     if (cursor + 1 >= args.size) {
                         println("Expected output filename after -o")
@@ -44,13 +53,27 @@ object CliParser {
                     commandLineArguments.setOutputFilename(outputFilename)
                 }
                 "-fPIC" -> commandLineArguments.setPic(true)
+                "--in-block-calls" -> commandLineArguments.setInBlockCalls(true)
+                "-fomit-frame-pointer" -> commandLineArguments.setOmitFramePointer(true)
+                "-fno-omit-frame-pointer" -> commandLineArguments.setOmitFramePointer(false)
+                "-foptimize-sibling-calls" -> commandLineArguments.setOptimizeSiblingCalls(true)
+                "-fno-optimize-sibling-calls" -> commandLineArguments.setOptimizeSiblingCalls(false)
+                "-fverbose-asm" -> commandLineArguments.setVerboseAsm(true)
                 "-h", "--help" -> {
                     printHelp()
                     return null
                 }
                 else -> {
-                    println("Unknown argument: $arg")
-                    return null
+                    if (!arg.startsWith("-march=")) {
+                        println("Unknown argument: $arg")
+                        return null
+                    }
+                    val march = MArch.of(arg.substring("-march=".length))
+                    if (march == null) {
+                        println("Unknown target architecture: $arg")
+                        return null
+                    }
+                    commandLineArguments.setMArch(march)
                 }
             }
             cursor++
@@ -65,6 +88,12 @@ object CliParser {
         println("  -O<NUM>                  Set optimization level")
         println("  -o <filename>            Set output filename")
         println("  --dump-ir <directory>    Dump IR to directory")
+        println("  --emit-irb <filename>    Write the input module in binary IR format")
+        println("  --in-block-calls         Don't split basic blocks on calls after lowering")
+        println("  -fomit-frame-pointer     Don't keep the frame pointer in leaf functions")
+        println("  -foptimize-sibling-calls Replace calls in tail position by jumps")
+        println("  -fverbose-asm            Annotate generated assembly with IR instructions")
+        println("  -march=<arch>            Generate code for the given architecture, e.g. x86-64-v3")
         println("  -h, --help               Show this help message")
     }
 }
\ No newline at end of file
@@ -2,14 +2,23 @@ package startup
 
 import common.Extension
 import common.ProcessedFile
+import ir.platform.x64.MArch
 
 
 class OptCLIArguments {
     private var dumpIrDirectoryOutput: String? = null
+    private var emitBinaryIrFilename: String? = null
     private var optimizationLevel = 0
     private var outFilename = ProcessedFile.fromFilename("out.o")
     private var inputFilename = arrayListOf<ProcessedFile>()
     private var pic = false
+    private var inBlockCalls = false
+    private var omitFramePointer = false
+    private var optimizeSiblingCalls = false
+    private var verboseAsm = false
+    private var march = MArch.DEFAULT
+    private var workingDirectory: String? = null
+    private var environment: Map<String, String>? = null
 
     fun isDumpIr(): Boolean = dumpIrDirectoryOutput != null
 
@@ -22,6 +31,12 @@ class OptCLIArguments {
         return this
     }
 
+    fun getEmitBinaryIr(): String? = emitBinaryIrFilename
+    fun setEmitBinaryIr(filename: String): OptCLIArguments {
+        emitBinaryIrFilename = filename
+        return this
+    }
+
     fun setOutputFilename(output: ProcessedFile): OptCLIArguments {
         outFilename = output
         return this
@@ -39,10 +54,52 @@ class OptCLIArguments {
         return this
     }
 
+    fun isInBlockCalls(): Boolean = inBlockCalls
+    fun setInBlockCalls(enabled: Boolean): OptCLIArguments {
+        inBlockCalls = enabled
+        return this
+    }
+
+    fun isOmitFramePointer(): Boolean = omitFramePointer
+    fun setOmitFramePointer(enabled: Boolean): OptCLIArguments {
+        omitFramePointer = enabled
+        return this
+    }
+
+    fun isOptimizeSiblingCalls(): Boolean = optimizeSiblingCalls
+    fun setOptimizeSiblingCalls(enabled: Boolean): OptCLIArguments {
+        optimizeSiblingCalls = enabled
+        return this
+    }
+
+    fun isVerboseAsm(): Boolean = verboseAsm
+    fun setVerboseAsm(enabled: Boolean): OptCLIArguments {
+        verboseAsm = enabled
+        return this
+    }
+
+    fun getMArch(): MArch = march
+    fun setMArch(march: MArch): OptCLIArguments {
+        this.march = march
+        return this
+    }
+
+    fun getWorkingDirectory(): String? = workingDirectory
+    fun setWorkingDirectory(directory: String?): OptCLIArguments {
+        workingDirectory = directory
+        return this
+    }
+
+    fun getEnvironment(): Map<String, String>? = environment
+    fun setEnvironment(env: Map<String, String>?): OptCLIArguments {
+        environment = env
+        return this
+    }
+
     fun getOutputFilename(): ProcessedFile = outFilename
 
     fun setFilename(name: ProcessedFile): OptCLIArguments {
-        if (name.extension != Extension.IR) {
+        if (name.extension != Extension.IR && name.extension != Extension.IRB) {
             throw IllegalArgumentException("Invalid file extension: ${name.extension}")
         }
 
@@ -7,59 +7,81 @@ import ir.pass.CompileContext
 import ir.pass.CompileContextBuilder
 import ir.pass.PassPipeline
 import ir.platform.common.CodeGenerationFactory
-import ir.platform.common.CompiledModule
 import ir.platform.common.TargetPlatform
-import java.io.PrintWriter
-import java.nio.file.Path
-import kotlin.io.path.deleteIfExists
-import kotlin.io.path.exists
 import kotlin.random.Random
 
 
+typealias ModuleProducer = ((SSAModule) -> Unit) -> SSAModule
+
 class OptDriver private constructor(private val commandLineArguments: OptCLIArguments) {
     private fun inputBasename(): String {
         return commandLineArguments.inputs().first().basename()
     }
 
-    private fun runCompiler(suffix: String, asmFile: String, module: SSAModule, pipeline: (CompileContext) -> PassPipeline): ExecutionResult {
+    private fun makeContext(suffix: String): CompileContext {
         val builder = CompileContextBuilder(inputBasename())
             .setSuffix(suffix)
             .setPic(commandLineArguments.isPic())
+            .setInBlockCalls(commandLineArguments.isInBlockCalls())
+            .setOmitFramePointer(commandLineArguments.isOmitFramePointer())
+            .setOptimizeSiblingCalls(commandLineArguments.isOptimizeSiblingCalls())
+            .setVerboseAsm(commandLineArguments.isVerboseAsm())
+            .setMArch(commandLineArguments.getMArch())
 
         if (commandLineArguments.isDumpIr()) {
             builder.withDumpIr(commandLineArguments.getDumpIrDirectory())
         }
 
-        val ctx                   = builder.construct()
-        val unoptimizedIr         = pipeline(ctx).run(module)
-        val codeGenerationFactory = CodeGenerationFactory()
+        return builder.construct()
+    }
+
+    private fun makeCodeGenerationFactory(ctx: CompileContext): CodeGenerationFactory {
+        return CodeGenerationFactory()
             .setContext(ctx)
             .setTarget(TargetPlatform.X64)
             .pic(commandLineArguments.isPic())
+    }
+
+    private fun runCompiler(suffix: String, asmFile: String, module: SSAModule, pipeline: (CompileContext) -> PassPipeline): ExecutionResult {
+        val ctx                   = makeContext(suffix)
+        val unoptimizedIr         = pipeline(ctx).run(module)
+        val codeGenerationFactory = makeCodeGenerationFactory(ctx)
 
         val unoptimisedCode = codeGenerationFactory.build(unoptimizedIr)
-        return compileAsmFile(unoptimisedCode, asmFile)
+        return compileAsmFile(asmFile) { out ->
+            unoptimisedCode.emit(out)
+            out.append('\n')
+        }
     }
 
-    private fun compileAsmFile(compiledModule: CompiledModule, asmFileName: String): ExecutionResult {
-        val tempDir = FileUtils.createTempFile(OPT + Random.nextInt())
-        val optimizedAsm = tempDir.toString()
+    private fun runStreamingCompiler(suffix: String, asmFile: String, producer: ModuleProducer, pipeline: (CompileContext) -> PassPipeline): ExecutionResult {
+        val ctx                   = makeContext(suffix)
+        val codeGenerationFactory = makeCodeGenerationFactory(ctx)
+
+        return compileAsmFile(asmFile) { out ->
+            val stream = codeGenerationFactory.stream(out)
+            val last = producer { module -> stream.emit(pipeline(ctx).run(module)) }
+            stream.finish(pipeline(ctx).run(last))
+        }
+    }
+
+    private fun compileAsmFile(asmFileName: String, writeAsm: (TextFileWriter) -> Unit): ExecutionResult {
+        val optimizedAsm = FileUtils.createTempFile(OPT + Random.nextInt())
         try {
-            PrintWriter(optimizedAsm, Charsets.UTF_8).use { out ->
-                out.println(compiledModule.toString())
+            openTextFile(optimizedAsm).use { out ->
+                writeAsm(out)
             }
 
             if (commandLineArguments.isDumpIr()) {
                 val dst = "${commandLineArguments.getDumpIrDirectory()}/${inputBasename()}/$asmFileName"
-                PrintWriter(dst, Charsets.UTF_8).use { out ->
-                    out.println(compiledModule.toString())
-                }
+                copyFile(optimizedAsm, dst)
             }
 
             val output = commandLineArguments.getOutputFilename().withExtension(Extension.OBJ)
-            return GNUAssemblerRunner.compileAsm(optimizedAsm, output.filename)
+            return GNUAssemblerRunner.compileAsm(optimizedAsm, output.filename,
+                commandLineArguments.getWorkingDirectory(), commandLineArguments.getEnvironment())
         } finally {
-            tempDir.deleteIfExists()
+            deleteFile(optimizedAsm)
         }
     }
 
@@ -67,19 +89,27 @@ class OptDriver private constructor(private val commandLineArguments: OptCLIArgu
         if (!commandLineArguments.isDumpIr()) {
             return
         }
-        val directoryName = Path.of("${commandLineArguments.getDumpIrDirectory()}/${inputBasename()}/")
+        val directoryName = "${commandLineArguments.getDumpIrDirectory()}/${inputBasename()}/"
 
-        if (!directoryName.exists()) {
-            FileUtils.deleteDirectory(directoryName.toFile())
+        if (!fileExists(directoryName)) {
+            FileUtils.deleteDirectory(directoryName)
         }
     }
 
     private fun compile(module: SSAModule): ProcessedFile {
+        return compile { suffix, asmFile, pipeline -> runCompiler(suffix, asmFile, module, pipeline) }
+    }
+
+    private fun compileStreaming(producer: ModuleProducer): ProcessedFile {
+        return compile { suffix, asmFile, pipeline -> runStreamingCompiler(suffix, asmFile, producer, pipeline) }
+    }
+
+    private fun compile(run: (String, String, (CompileContext) -> PassPipeline) -> ExecutionResult): ProcessedFile {
         removeOrCreateDir()
         val result = if (commandLineArguments.getOptLevel() == 0) {
-            runCompiler(".base", BASE, module, PassPipeline::base)
+            run(".base", BASE, PassPipeline::base)
         } else if (commandLineArguments.getOptLevel() >= 1) {
-            runCompiler(".opt", OPT, module, PassPipeline::opt)
+            run(".opt", OPT, PassPipeline::opt)
         } else {
             throw IllegalArgumentException("Invalid optimization level: -O${commandLineArguments.getOptLevel()}")
         }
@@ -98,5 +128,14 @@ class OptDriver private constructor(private val commandLineArguments: OptCLIArgu
         fun compile(cli: OptCLIArguments, module: SSAModule): ProcessedFile {
             return OptDriver(cli).compile(module)
         }
+
+        /**
+         * Compiles a translation unit function by function. [producer] hands every generated
+         * module to the callback, which optimizes it and appends its code to the assembly file
+         * right away, and returns the last module holding remaining functions, globals and constants.
+         */
+        fun compileStreaming(cli: OptCLIArguments, producer: ModuleProducer): ProcessedFile {
+            return OptDriver(cli).compileStreaming(producer)
+        }
     }
 }
\ No newline at end of file
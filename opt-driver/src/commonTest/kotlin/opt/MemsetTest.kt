@@ -0,0 +1,34 @@
+package opt
+
+import common.CommonIrTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+
+
+abstract class MemsetTests: CommonIrTest() {
+    @Test
+    fun testMemset() {
+        val result = runTest("opt_ir/memset/memset", listOf("runtime/runtime.c"), options())
+        assertEquals("3 3 3 3 3 3 3 \n", result.output)
+    }
+
+    @Test
+    fun testMemsetXmm() {
+        val result = runTest("opt_ir/memset/memset_xmm", listOf("runtime/runtime.c"), options())
+        assertEquals("1 ".repeat(5) + "0 ".repeat(35) + "1 ".repeat(10) + "\n", result.output)
+    }
+
+    @Test
+    fun testMemsetLarge() {
+        val result = runTest("opt_ir/memset/memset_large", listOf("runtime/runtime.c"), options())
+        assertEquals("5 ".repeat(10) + "0 ".repeat(280) + "5 ".repeat(10) + "\n", result.output)
+    }
+}
+
+class MemsetO1Tests: MemsetTests() {
+    override fun options(): List<String> = listOf("-O1")
+}
+
+class MemsetO0Tests: MemsetTests() {
+    override fun options(): List<String> = listOf()
+}
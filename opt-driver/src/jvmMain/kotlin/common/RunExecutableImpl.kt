@@ -4,10 +4,15 @@ import java.io.File
 import java.util.concurrent.TimeUnit
 
 
-actual fun runCommand(command: String, args: List<String>, workingDir: String?): ExecutionResult {
-    val process = ProcessBuilder(listOf(command) + args)
+actual fun runCommand(command: String, args: List<String>, workingDir: String?, environment: Map<String, String>?): ExecutionResult {
+    val builder = ProcessBuilder(listOf(command) + args)
         .directory(workingDir?.let { File(it) })
-        .start()
+    if (environment != null) {
+        builder.environment().clear()
+        builder.environment().putAll(environment)
+    }
+
+    val process = builder.start()
 
     val stdout = process.inputStream.bufferedReader().readText()
     val stderr = process.errorStream.bufferedReader().readText()
@@ -0,0 +1,88 @@
+@file:OptIn(ExperimentalForeignApi::class)
+
+package common
+
+import kotlinx.cinterop.*
+import platform.posix.*
+
+
+private fun redirect(filename: String, fd: Int) {
+    val file = open(filename, O_WRONLY or O_TRUNC)
+    dup2(file, fd)
+    close(file)
+}
+
+private fun waitProcess(pid: Int): Int = memScoped {
+    val status = alloc<IntVar>()
+    while (waitpid(pid, status.ptr, 0) == -1) {
+        if (errno != EINTR) {
+            throw RuntimeException("waitpid failed: ${strerror(errno)?.toKString()}")
+        }
+    }
+
+    val value = status.value
+    return if ((value and 0x7f) == 0) {
+        (value shr 8) and 0xff
+    } else {
+        128 + (value and 0x7f)
+    }
+}
+
+/**
+ * The environment is replaced by env(1): setenv() is not safe in a forked child of a multithreaded process.
+ */
+private fun commandLine(command: String, args: List<String>, environment: Map<String, String>?): List<String> {
+    if (environment == null) {
+        return listOf(command) + args
+    }
+
+    return listOf("env", "-i") + environment.map { (name, value) -> "$name=$value" } + listOf(command) + args
+}
+
+actual fun runCommand(command: String, args: List<String>, workingDir: String?, environment: Map<String, String>?): ExecutionResult {
+    val stdoutFile = createTempFile("stdout")
+    val stderrFile = createTempFile("stderr")
+    try {
+        val pid = memScoped {
+            // Argument vector is allocated before fork.
+            val commandLine = commandLine(command, args, environment)
+            val argv = allocArray<CPointerVar<ByteVar>>(commandLine.size + 1)
+            for (i in commandLine.indices) {
+                argv[i] = commandLine[i].cstr.ptr
+            }
+            argv[commandLine.size] = null
+
+            val child = fork()
+            if (child == 0) {
+                if (workingDir != null && chdir(workingDir) != 0) {
+                    _exit(127)
+                }
+                redirect(stdoutFile, STDOUT_FILENO)
+                redirect(stderrFile, STDERR_FILENO)
+                execvp(commandLine[0], argv)
+                _exit(127)
+            }
+            child
+        }
+        if (pid == -1) {
+            throw RuntimeException("fork failed: ${strerror(errno)?.toKString()}")
+        }
+
+        val exitCode = waitProcess(pid)
+        return ExecutionResult(readTextFile(stdoutFile), readTextFile(stderrFile), exitCode)
+    } finally {
+        deleteFile(stdoutFile)
+        deleteFile(stderrFile)
+    }
+}
+
+actual fun env(name: String): String? {
+    val env = getenv(name) ?: return null
+    return env.toKString()
+}
+
+actual fun pwd(): String {
+    val buffer = ByteArray(PATH_MAX)
+    getcwd(buffer.refTo(0), buffer.size.convert())
+    return buffer.toKString()
+}
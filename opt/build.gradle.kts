@@ -10,6 +10,7 @@ version = "1.0"
 
 kotlin {
     jvm()
+    linuxX64()
 }
 
 tasks.withType(Test::class.java).all {
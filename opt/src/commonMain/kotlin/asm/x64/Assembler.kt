@@ -129,6 +129,32 @@ abstract class Assembler(functionName: String, val id: Int): AnonymousDirective(
     fun not(size: Int, dst: GPRegister) = add(Not(size, dst))
     fun not(size: Int, dst: Address)    = add(Not(size, dst))
 
+    // Return the Count of Number of Bits Set to 1
+    fun popcnt(size: Int, src: GPRegister, dst: GPRegister) = add(Popcnt(size, src, dst))
+    fun popcnt(size: Int, src: Address, dst: GPRegister)    = add(Popcnt(size, src, dst))
+
+    // Count the Number of Trailing Zero Bits
+    fun tzcnt(size: Int, src: GPRegister, dst: GPRegister) = add(Tzcnt(size, src, dst))
+    fun tzcnt(size: Int, src: Address, dst: GPRegister)    = add(Tzcnt(size, src, dst))
+
+    // Count the Number of Leading Zero Bits
+    fun lzcnt(size: Int, src: GPRegister, dst: GPRegister) = add(Lzcnt(size, src, dst))
+    fun lzcnt(size: Int, src: Address, dst: GPRegister)    = add(Lzcnt(size, src, dst))
+
+    // Bit Scan Forward
+    fun bsf(size: Int, src: GPRegister, dst: GPRegister) = add(Bsf(size, src, dst))
+    fun bsf(size: Int, src: Address, dst: GPRegister)    = add(Bsf(size, src, dst))
+
+    // Bit Scan Reverse
+    fun bsr(size: Int, src: GPRegister, dst: GPRegister) = add(Bsr(size, src, dst))
+    fun bsr(size: Int, src: Address, dst: GPRegister)    = add(Bsr(size, src, dst))
+
+    // Byte Swap
+    fun bswap(size: Int, dst: GPRegister) = add(Bswap(size, dst))
+
+    // Rotate Left
+    fun rol(size: Int, src: Imm8, dst: GPRegister) = add(Rol(size, src, dst))
+
     // Unsigned Divide
     fun div(size: Int, divider: GPRegister) = add(Div(size, divider))
     fun div(size: Int, divider: Address)    = add(Div(size, divider))
@@ -228,8 +254,11 @@ abstract class Assembler(functionName: String, val id: Int): AnonymousDirective(
     // Jump
     fun jump(label: String) = add(Jump(label))
     fun jump(label: Label) = add(Jump(label.id))
+    protected fun jump(name: FunSymbol) = add(Jump(name.toString()))
+    protected fun jump(reg: GPRegister) = add(Jump("*${reg.toString(8)}"))
 
     fun ret() = add(Ret)
+    fun repStosb() = add(RepStosb)
     fun leave() = add(Leave)
 
     // Add Scalar Double-Precision Floating-Point Values
@@ -357,6 +386,13 @@ abstract class Assembler(functionName: String, val id: Int): AnonymousDirective(
     fun pxor(src: XmmRegister, dst: XmmRegister) = add(Pxor(16, src, dst))
     fun pxor(src: Address, dst: XmmRegister)     = add(Pxor(16, src, dst))
 
+    // Move Unaligned Packed Integer Values
+    fun movdqu(src: XmmRegister, dst: Address) = add(Movdqu(src, dst))
+
+    // Move Quadword between general purpose and xmm registers
+    fun movq(src: GPRegister, dst: XmmRegister) = add(Movq(src, dst))
+    fun movq(src: XmmRegister, dst: GPRegister) = add(Movq(src, dst))
+
     // Unordered Compare Scalar Single-Precision Floating-Point Values and set EFLAGS
     fun ucomiss(src: Address, dst: XmmRegister) = add(Ucomiss(16, src, dst))
     fun ucomiss(src: XmmRegister, dst: XmmRegister) = add(Ucomiss(16, src, dst))
@@ -441,28 +477,28 @@ abstract class Assembler(functionName: String, val id: Int): AnonymousDirective(
 
     fun comment(message: String) = add(Comment(message))
 
-    override fun toString(): String {
-        val builder = StringBuilder()
+    override fun emit(out: Appendable) {
         var count = 0
         for ((label, instructions) in codeBlocks) {
             if (count > 0) {
-                builder.append("$label:\n")
+                out.append(label.id).append(":\n")
             }
             for ((idx, inst) in instructions.withIndex()) {
-                builder.append("    $inst")
+                out.append("    ")
+                inst.emit(out)
                 if (idx < instructions.size - 1) {
-                    builder.append("\n")
+                    out.append('\n')
                 }
             }
 
             if (count < codeBlocks.size - 1) {
-                builder.append("\n")
+                out.append('\n')
             }
             count += 1
         }
-
-        return builder.toString()
     }
 
+    override fun toString(): String = buildString { emit(this) }
+
     private data class BuilderContext(var label: Label, var instructions: MutableList<CPUInstruction>)
 }
\ No newline at end of file
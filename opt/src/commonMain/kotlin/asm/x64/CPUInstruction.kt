@@ -7,6 +7,10 @@ import ir.Definitions.QWORD_SIZE
 
 
 sealed class CPUInstruction {
+    open fun emit(out: Appendable) {
+        out.append(toString())
+    }
+
     companion object {
         fun prefix(size: Int): Char = when (size) {
             8 -> 'q'
@@ -26,6 +30,10 @@ internal object Ret: CPUInstruction() {
     override fun toString(): String = "ret"
 }
 
+internal object RepStosb: CPUInstruction() {
+    override fun toString(): String = "rep stosb"
+}
+
 internal data class Push(val size: Int, val operand: Operand): CPUInstruction() {
     override fun toString(): String {
         return "push${prefix(size)} ${operand.toString(size)}"
@@ -334,6 +342,52 @@ internal data class Not(val size: Int, val dst: Operand): CPUInstruction() {
     }
 }
 
+internal data class Popcnt(val size: Int, val src: Operand, val dst: GPRegister): CPUInstruction() {
+    override fun toString(): String {
+        return "popcnt${prefix(size)} ${src.toString(size)}, ${dst.toString(size)}"
+    }
+}
+
+internal data class Tzcnt(val size: Int, val src: Operand, val dst: GPRegister): CPUInstruction() {
+    override fun toString(): String {
+        return "tzcnt${prefix(size)} ${src.toString(size)}, ${dst.toString(size)}"
+    }
+}
+
+internal data class Lzcnt(val size: Int, val src: Operand, val dst: GPRegister): CPUInstruction() {
+    override fun toString(): String {
+        return "lzcnt${prefix(size)} ${src.toString(size)}, ${dst.toString(size)}"
+    }
+}
+
+internal data class Bsf(val size: Int, val src: Operand, val dst: GPRegister): CPUInstruction() {
+    override fun toString(): String {
+        return "bsf${prefix(size)} ${src.toString(size)}, ${dst.toString(size)}"
+    }
+}
+
+internal data class Bsr(val size: Int, val src: Operand, val dst: GPRegister): CPUInstruction() {
+    override fun toString(): String {
+        return "bsr${prefix(size)} ${src.toString(size)}, ${dst.toString(size)}"
+    }
+}
+
+internal data class Bswap(val size: Int, val dst: GPRegister): CPUInstruction() {
+    init {
+        assertion(size == 4 || size == 8) { "size=$size" }
+    }
+
+    override fun toString(): String {
+        return "bswap${prefix(size)} ${dst.toString(size)}"
+    }
+}
+
+internal data class Rol(val size: Int, val src: Imm8, val dst: Operand): CPUInstruction() {
+    override fun toString(): String {
+        return "rol${prefix(size)} ${src.toString(size)}, ${dst.toString(size)}"
+    }
+}
+
 internal data class Xorps(val size: Int, val src: Operand, val dst: Operand): CPUInstruction() {
     override fun toString(): String {
         return "xorps ${src.toString(size)}, ${dst.toString(size)}"
@@ -346,6 +400,20 @@ internal data class Xorpd(val size: Int, val src: Operand, val dst: Operand): CP
     }
 }
 
+internal data class Movdqu(val src: Operand, val dst: Operand): CPUInstruction() {
+    override fun toString(): String {
+        return "movdqu ${src.toString(16)}, ${dst.toString(16)}"
+    }
+}
+
+internal data class Movq(val src: Operand, val dst: Operand): CPUInstruction() {
+    override fun toString(): String {
+        val srcSize = if (src is XmmRegister) 16 else 8
+        val dstSize = if (dst is XmmRegister) 16 else 8
+        return "movq ${src.toString(srcSize)}, ${dst.toString(dstSize)}"
+    }
+}
+
 internal data class Pxor(val size: Int, val src: Operand, val dst: Operand): CPUInstruction() {
     override fun toString(): String {
         return "pxor ${src.toString(size)}, ${dst.toString(size)}"
@@ -465,5 +533,9 @@ internal data class CMOVcc(val size: Int, val flag: CondFlagType, val src: Opera
 }
 
 internal data class Comment(val message: String): CPUInstruction() {
+    override fun emit(out: Appendable) {
+        out.append("# ").append(message)
+    }
+
     override fun toString(): String = "# $message"
 }
\ No newline at end of file
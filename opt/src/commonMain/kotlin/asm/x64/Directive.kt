@@ -1,7 +1,11 @@
 package asm.x64
 
 
-sealed class AnyDirective
+sealed class AnyDirective {
+    open fun emit(out: Appendable) {
+        out.append(toString())
+    }
+}
 
 sealed class SectionDirective: AnyDirective()
 
@@ -47,19 +51,20 @@ data object ExternDirective : AnonymousDirective() {
 class ObjLabel(override val name: String): NamedDirective() {
     internal val anonymousDirective = arrayListOf<AnyDirective>()
 
-    override fun toString(): String = buildString {
-        append("$name:\n")
+    override fun emit(out: Appendable) {
+        out.append(name).append(":\n")
         for ((idx, d) in anonymousDirective.withIndex()) {
-            if (d is Assembler) { //TODO: fix this
-                append("$d")
-            } else {
-                append("\t$d")
+            if (d !is Assembler) { //TODO: fix this
+                out.append('\t')
             }
+            d.emit(out)
             if (idx != anonymousDirective.size - 1) {
-                append("\n")
+                out.append('\n')
             }
         }
     }
+
+    override fun toString(): String = buildString { emit(this) }
 }
 
 enum class SectionType {
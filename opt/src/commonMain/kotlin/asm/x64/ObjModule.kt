@@ -121,15 +121,15 @@ abstract class ObjModule(private val nameAssistant: NameAssistant): ObjBuilder {
         arrayToAppend.add(SizeDirective(label, size))
     }
 
-    override fun toString(): String {
-        val builder = StringBuilder()
+    fun emit(out: Appendable) {
         for ((idx, symbol) in symbols.withIndex()) {
-            builder.append(symbol)
+            symbol.emit(out)
             if (idx < symbols.size - 1) {
-                builder.append("\n")
+                out.append('\n')
             }
         }
-        builder.append("\n")
-        return builder.toString()
+        out.append('\n')
     }
+
+    override fun toString(): String = buildString { emit(this) }
 }
\ No newline at end of file
@@ -0,0 +1,120 @@
+package common
+
+
+/**
+ * Fixed-size bit vector. Set operations process 64 bits per step and report whether the receiver was changed.
+ */
+class BitVector(val bitCount: Int) {
+    @PublishedApi
+    internal val words = LongArray((bitCount + WORD_BITS - 1) / WORD_BITS)
+
+    operator fun get(index: Int): Boolean {
+        if (index < 0 || index >= bitCount) {
+            return false
+        }
+
+        return (words[index ushr LOG_WORD_BITS] and (1L shl index)) != 0L
+    }
+
+    fun set(index: Int) {
+        checkBounds(index)
+        val wordIndex = index ushr LOG_WORD_BITS
+        words[wordIndex] = words[wordIndex] or (1L shl index)
+    }
+
+    fun clear(index: Int) {
+        checkBounds(index)
+        val wordIndex = index ushr LOG_WORD_BITS
+        words[wordIndex] = words[wordIndex] and (1L shl index).inv()
+    }
+
+    /**
+     * this = this ∪ other
+     */
+    fun union(other: BitVector): Boolean {
+        var changed = false
+        for (i in words.indices) {
+            val old = words[i]
+            val new = old or other.words[i]
+            if (old != new) {
+                words[i] = new
+                changed = true
+            }
+        }
+
+        return changed
+    }
+
+    /**
+     * this = this ∪ (a - b)
+     */
+    fun unionDifference(a: BitVector, b: BitVector): Boolean {
+        var changed = false
+        for (i in words.indices) {
+            val old = words[i]
+            val new = old or (a.words[i] and b.words[i].inv())
+            if (old != new) {
+                words[i] = new
+                changed = true
+            }
+        }
+
+        return changed
+    }
+
+    fun cardinality(): Int {
+        var count = 0
+        for (word in words) {
+            count += word.countOneBits()
+        }
+
+        return count
+    }
+
+    inline fun forEachSetBit(action: (Int) -> Unit) {
+        for (wordIndex in words.indices) {
+            var word = words[wordIndex]
+            while (word != 0L) {
+                val bit = word.countTrailingZeroBits()
+                action((wordIndex shl LOG_WORD_BITS) + bit)
+                word = word and (word - 1)
+            }
+        }
+    }
+
+    private fun checkBounds(index: Int) {
+        if (index < 0 || index >= bitCount) {
+            throw IndexOutOfBoundsException("Index $index is out of bounds: [0, $bitCount)")
+        }
+    }
+
+    override fun equals(other: Any?): Boolean {
+        if (this === other) return true
+        if (other !is BitVector) return false
+
+        return bitCount == other.bitCount && words.contentEquals(other.words)
+    }
+
+    override fun hashCode(): Int {
+        return words.contentHashCode()
+    }
+
+    override fun toString(): String = buildString {
+        append('{')
+        var first = true
+        forEachSetBit {
+            if (!first) {
+                append(", ")
+            }
+            append(it)
+            first = false
+        }
+        append('}')
+    }
+
+    companion object {
+        private const val WORD_BITS = 64
+        @PublishedApi
+        internal const val LOG_WORD_BITS = 6
+    }
+}
@@ -0,0 +1,65 @@
+package common
+
+/**
+ * Buffered writer of a text file, see [openTextFile].
+ */
+interface TextFileWriter: Appendable, AutoCloseable
+
+expect fun readTextFile(filename: String): String
+
+expect fun openTextFile(filename: String): TextFileWriter
+
+expect fun readBinaryFile(filename: String): ByteArray
+
+/**
+ * Writes [bytes] to the file, replacing its content.
+ */
+expect fun writeBinaryFile(filename: String, bytes: ByteArray)
+
+expect fun fileExists(filename: String): Boolean
+
+/**
+ * Returns the modification time of the file in milliseconds.
+ */
+expect fun lastModified(filename: String): Long
+
+/**
+ * Sets the modification time of the file to the current time.
+ */
+expect fun touchFile(filename: String)
+
+/**
+ * Returns the size of the file in bytes.
+ */
+expect fun fileSize(filename: String): Long
+
+expect fun copyFile(src: String, dst: String)
+
+/**
+ * Atomically replaces [dst] by [src], both files must be on the same file system.
+ */
+expect fun renameFile(src: String, dst: String)
+
+/**
+ * Deletes the file if it exists, returns true if it was deleted.
+ */
+expect fun deleteFile(filename: String): Boolean
+
+/**
+ * Deletes the directory with all its content.
+ */
+expect fun deleteRecursively(dirname: String): Boolean
+
+expect fun createDirectories(dirname: String)
+
+/**
+ * Returns paths of the directory entries.
+ */
+expect fun listDirectory(dirname: String): List<String>
+
+expect fun absolutePath(filename: String): String
+
+/**
+ * Creates a new empty file in the system temporary directory and returns its absolute path.
+ */
+expect fun createTempFile(prefix: String): String
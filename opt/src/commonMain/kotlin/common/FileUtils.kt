@@ -1,12 +1,9 @@
 package common
 
-import java.io.File
-import java.nio.file.Files
-import java.nio.file.Path
 
 object FileUtils {
     fun getBasename(name: String): String {
-        val fileName = Path.of(name).fileName.toString()
+        val fileName = name.trimEnd('/').substringAfterLast('/')
         return removeExtension(fileName)
     }
 
@@ -20,21 +17,47 @@ object FileUtils {
     }
 
     fun getDirName(name: String): String {
-        return Path.of(name).toAbsolutePath().parent.toString()
+        val dirName = absolutePath(name).substringBeforeLast('/')
+        return dirName.ifEmpty { "/" }
     }
 
-    fun createTempFile(prefix: String): Path {
-        val tempDir = Path.of(System.getProperty("java.io.tmpdir"))
-        return Files.createTempFile(tempDir, prefix, null).toAbsolutePath()
+    /**
+     * Resolves [path] against [directory] unless it is absolute.
+     */
+    fun resolve(directory: String, path: String): String {
+        if (path.startsWith('/')) {
+            return path
+        }
+
+        return if (directory.endsWith('/')) "$directory$path" else "$directory/$path"
     }
 
-    fun deleteDirectory(directoryToBeDeleted: File): Boolean {
-        val allContents = directoryToBeDeleted.listFiles()
-        if (allContents != null) {
-            for (file in allContents) {
-                deleteDirectory(file)
+    /**
+     * Removes redundant separators, '.' and '..' segments of the path.
+     */
+    fun normalize(path: String): String {
+        val segments = arrayListOf<String>()
+        for (segment in path.split('/')) {
+            when (segment) {
+                "", "." -> continue
+                ".." -> if (segments.isNotEmpty() && segments.last() != "..") {
+                    segments.removeLast()
+                } else if (!path.startsWith('/')) {
+                    segments.add(segment)
+                }
+                else -> segments.add(segment)
             }
         }
-        return directoryToBeDeleted.delete()
+
+        val normalized = segments.joinToString("/")
+        return if (path.startsWith('/')) "/$normalized" else normalized.ifEmpty { "." }
+    }
+
+    fun createTempFile(prefix: String): String {
+        return common.createTempFile(prefix)
+    }
+
+    fun deleteDirectory(dirname: String): Boolean {
+        return deleteRecursively(dirname)
     }
-}
\ No newline at end of file
+}
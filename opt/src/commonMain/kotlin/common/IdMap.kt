@@ -0,0 +1,153 @@
+package common
+
+
+/**
+ * Dense numbering of objects: every numbered key gets an id in range [0, capacity()).
+ * Ids of keys which were not numbered are out of the range.
+ */
+interface IdNumbering<in K> {
+    fun capacity(): Int
+    fun id(key: K): Int
+}
+
+/**
+ * Map keyed by [IdNumbering] ids: lookup is array indexing instead of hashing.
+ * Keys are compared by identity, so a stale id of a key which was not numbered never returns a foreign value.
+ */
+class IdMap<K: Any, V: Any> private constructor(private val numbering: IdNumbering<K>, capacity: Int): AbstractMutableMap<K, V>() {
+    private var keysArray: Array<Any?> = arrayOfNulls(capacity)
+    private var valuesArray: Array<Any?> = arrayOfNulls(capacity)
+    private var count = 0
+
+    override val size: Int
+        get() = count
+
+    override val entries: MutableSet<MutableMap.MutableEntry<K, V>>
+        get() {
+            val set = linkedSetOf<MutableMap.MutableEntry<K, V>>()
+            forEachEntry { k, v -> set.add(IdMapEntry(k, v)) }
+            return set
+        }
+
+    private fun slot(key: K): Int {
+        val idx = numbering.id(key)
+        if (idx < 0 || idx >= keysArray.size || keysArray[idx] !== key) {
+            return -1
+        }
+
+        return idx
+    }
+
+    override fun get(key: K): V? {
+        val idx = slot(key)
+        if (idx == -1) {
+            return null
+        }
+
+        @Suppress("UNCHECKED_CAST")
+        return valuesArray[idx] as V
+    }
+
+    override fun containsKey(key: K): Boolean {
+        return slot(key) != -1
+    }
+
+    override fun put(key: K, value: V): V? {
+        val idx = numbering.id(key)
+        if (idx < 0) {
+            throw IndexOutOfBoundsException("Key $key is not numbered")
+        }
+        if (idx >= keysArray.size) {
+            grow(idx + 1)
+        }
+
+        val oldKey = keysArray[idx]
+        assertion(oldKey == null || oldKey === key) { "Key $key has the id of $oldKey" }
+        val old = valuesArray[idx]
+        if (oldKey == null) {
+            count += 1
+        }
+        keysArray[idx] = key
+        valuesArray[idx] = value
+
+        @Suppress("UNCHECKED_CAST")
+        return old as V?
+    }
+
+    override fun remove(key: K): V? {
+        val idx = slot(key)
+        if (idx == -1) {
+            return null
+        }
+
+        val old = valuesArray[idx]
+        keysArray[idx] = null
+        valuesArray[idx] = null
+        count -= 1
+
+        @Suppress("UNCHECKED_CAST")
+        return old as V
+    }
+
+    override fun clear() {
+        keysArray.fill(null)
+        valuesArray.fill(null)
+        count = 0
+    }
+
+    /**
+     * Iterates over entries in id order without allocation.
+     */
+    inline fun forEachEntry(action: (K, V) -> Unit) {
+        for (idx in 0 until idCapacity()) {
+            val key = keyAt(idx) ?: continue
+            action(key, valueAt(idx))
+        }
+    }
+
+    @PublishedApi
+    internal fun idCapacity(): Int = keysArray.size
+
+    @PublishedApi
+    internal fun keyAt(idx: Int): K? {
+        @Suppress("UNCHECKED_CAST")
+        return keysArray[idx] as K?
+    }
+
+    @PublishedApi
+    internal fun valueAt(idx: Int): V {
+        @Suppress("UNCHECKED_CAST")
+        return valuesArray[idx] as V
+    }
+
+    private fun grow(minCapacity: Int) {
+        val newCapacity = maxOf(minCapacity, keysArray.size * 2)
+        keysArray = keysArray.copyOf(newCapacity)
+        valuesArray = valuesArray.copyOf(newCapacity)
+    }
+
+    private class IdMapEntry<K, V>(override val key: K, override val value: V): MutableMap.MutableEntry<K, V> {
+        override fun setValue(newValue: V): V {
+            throw UnsupportedOperationException("IdMap entries are read-only")
+        }
+
+        override fun hashCode(): Int = key.hashCode() xor value.hashCode()
+
+        override fun equals(other: Any?): Boolean {
+            if (other !is Map.Entry<*, *>) return false
+            return key == other.key && value == other.value
+        }
+
+        override fun toString(): String = "$key=$value"
+    }
+
+    companion object {
+        fun <K: Any, V: Any> create(numbering: IdNumbering<K>): IdMap<K, V> {
+            return IdMap(numbering, numbering.capacity())
+        }
+    }
+}
+
+fun <K: Any, V: Any> idMapOf(numbering: IdNumbering<K>): IdMap<K, V> {
+    return IdMap.create(numbering)
+}
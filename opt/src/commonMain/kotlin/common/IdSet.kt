@@ -0,0 +1,136 @@
+package common
+
+
+/**
+ * Set of objects numbered by [IdNumbering], membership test is array indexing.
+ * Iteration goes in id order.
+ */
+class IdSet<E: Any> private constructor(private val numbering: IdNumbering<E>, capacity: Int): AbstractMutableSet<E>() {
+    private var slots: Array<Any?> = arrayOfNulls(capacity)
+    private var count = 0
+
+    override val size: Int
+        get() = count
+
+    override fun contains(element: E): Boolean {
+        val idx = numbering.id(element)
+        return idx >= 0 && idx < slots.size && slots[idx] === element
+    }
+
+    override fun add(element: E): Boolean {
+        val idx = numbering.id(element)
+        if (idx < 0) {
+            throw IndexOutOfBoundsException("Element $element is not numbered")
+        }
+        if (idx >= slots.size) {
+            slots = slots.copyOf(maxOf(idx + 1, slots.size * 2))
+        }
+        val slot = slots[idx]
+        assertion(slot == null || slot === element) { "Element $element has the id of $slot" }
+        if (slot != null) {
+            return false
+        }
+
+        slots[idx] = element
+        count += 1
+        return true
+    }
+
+    override fun remove(element: E): Boolean {
+        if (!contains(element)) {
+            return false
+        }
+
+        slots[numbering.id(element)] = null
+        count -= 1
+        return true
+    }
+
+    override fun addAll(elements: Collection<E>): Boolean {
+        if (elements !is IdSet<E>) {
+            return super.addAll(elements)
+        }
+
+        var changed = false
+        elements.forEachElement { changed = add(it) || changed }
+        return changed
+    }
+
+    override fun removeAll(elements: Collection<E>): Boolean {
+        if (elements !is IdSet<E>) {
+            return super.removeAll(elements)
+        }
+
+        var changed = false
+        elements.forEachElement { changed = remove(it) || changed }
+        return changed
+    }
+
+    override fun clear() {
+        slots.fill(null)
+        count = 0
+    }
+
+    /**
+     * Iterates over elements in id order without allocation.
+     */
+    inline fun forEachElement(action: (E) -> Unit) {
+        for (idx in 0 until idCapacity()) {
+            action(elementAt(idx) ?: continue)
+        }
+    }
+
+    @PublishedApi
+    internal fun idCapacity(): Int = slots.size
+
+    @PublishedApi
+    internal fun elementAt(idx: Int): E? {
+        @Suppress("UNCHECKED_CAST")
+        return slots[idx] as E?
+    }
+
+    override fun iterator(): MutableIterator<E> = IdSetIterator()
+
+    private inner class IdSetIterator: MutableIterator<E> {
+        private var next = 0
+        private var last = -1
+
+        override fun hasNext(): Boolean {
+            while (next < slots.size && slots[next] == null) {
+                next++
+            }
+
+            return next < slots.size
+        }
+
+        override fun next(): E {
+            if (!hasNext()) {
+                throw NoSuchElementException()
+            }
+
+            last = next
+            next++
+            @Suppress("UNCHECKED_CAST")
+            return slots[last] as E
+        }
+
+        override fun remove() {
+            if (last == -1 || slots[last] == null) {
+                throw IllegalStateException("next() was not called")
+            }
+
+            slots[last] = null
+            count -= 1
+        }
+    }
+
+    companion object {
+        fun <E: Any> create(numbering: IdNumbering<E>): IdSet<E> {
+            return IdSet(numbering, numbering.capacity())
+        }
+    }
+}
+
+fun <E: Any> idSetOf(numbering: IdNumbering<E>): IdSet<E> {
+    return IdSet.create(numbering)
+}
@@ -1,57 +1,55 @@
 package common
 
 
-class IntMap<K, V>(private val valuesArray: Array<V?>, private val keysArray: Array<K?>, val closure: (K) -> Int) : MutableMap<K, V> {
-    override val entries: MutableSet<MutableMap.MutableEntry<K, V>>
-        get() {
-            val keyToValue = hashSetOf<IntMapEntry<K, V>>()
-            keysArray.forEachWith(valuesArray) { k, v ->
-                if (k == null) {
-                    return@forEachWith
-                }
-
-                keyToValue.add(IntMapEntry(k, v))
-            }
+class IntMap<K, V>(private var valuesArray: Array<V?>, private var keysArray: Array<K?>, val closure: (K) -> Int) : MutableMap<K, V> {
+    private var count = 0
 
-            @Suppress("UNCHECKED_CAST")
-            return keyToValue as MutableSet<MutableMap.MutableEntry<K, V>>
-        }
+    override val entries: MutableSet<MutableMap.MutableEntry<K, V>>
+        get() = EntrySet()
 
     override val keys: MutableSet<K>
-        get() = keysArray.fold(hashSetOf()) { acc, v ->
-            if (v != null) {
-                acc.add(v)
-            }
-            acc
-        }
+        get() = KeySet()
 
     override val size: Int
-        get() = keysArray.count { it != null }
+        get() = count
 
     override val values: MutableCollection<V>
-        get() = valuesArray.fold(arrayListOf()) { acc, v ->
-            if (v != null) {
-                acc.add(v)
-            }
-            acc
-        }
+        get() = Values()
 
     override fun clear() {
         valuesArray.fill(null)
         keysArray.fill(null)
+        count = 0
     }
 
-    override fun isEmpty(): Boolean = valuesArray.all { it == null }
+    override fun isEmpty(): Boolean = count == 0
 
-    override fun remove(key: K): V? {
+    private fun slot(key: K): Int {
         val idx = closure(key)
-        checkBounds(idx)
-        if (keysArray[idx] != key) {
+        if (idx < 0) {
+            throw IndexOutOfBoundsException("Index $idx is out of bounds: [0, ${valuesArray.size})")
+        }
+        if (idx >= keysArray.size || keysArray[idx] != key) {
+            return -1
+        }
+
+        return idx
+    }
+
+    override fun remove(key: K): V? {
+        val idx = slot(key)
+        if (idx == -1) {
             return null
         }
+
+        return removeAt(idx)
+    }
+
+    private fun removeAt(idx: Int): V? {
         val item = valuesArray[idx]
         valuesArray[idx] = null
         keysArray[idx] = null
+        count -= 1
         return item
     }
 
@@ -63,17 +61,22 @@ class IntMap<K, V>(private val valuesArray: Array<V?>, private val keysArray: Ar
 
     override fun put(key: K, value: V): V? {
         val idx = closure(key)
+        if (idx >= valuesArray.size) {
+            grow(idx + 1)
+        }
         checkBounds(idx)
         val item = valuesArray[idx]
+        if (keysArray[idx] == null) {
+            count += 1
+        }
         valuesArray[idx] = value
         keysArray[idx] = key
         return item
     }
 
     override fun get(key: K): V? {
-        val idx = closure(key)
-        checkBounds(idx)
-        if (keysArray[idx] != key) {
+        val idx = slot(key)
+        if (idx == -1) {
             return null
         }
 
@@ -81,35 +84,161 @@ class IntMap<K, V>(private val valuesArray: Array<V?>, private val keysArray: Ar
     }
 
     override fun containsValue(value: V): Boolean {
-        return valuesArray.contains(value)
+        for (idx in keysArray.indices) {
+            if (keysArray[idx] != null && valuesArray[idx] == value) {
+                return true
+            }
+        }
+
+        return false
     }
 
     override fun containsKey(key: K): Boolean {
-        return keysArray.contains(key)
+        return slot(key) != -1
+    }
+
+    /**
+     * Iterates over entries in index order without allocation.
+     */
+    inline fun forEachEntry(action: (K, V) -> Unit) {
+        for (idx in 0 until capacity()) {
+            val key = keyAt(idx) ?: continue
+            action(key, valueAt(idx))
+        }
+    }
+
+    @PublishedApi
+    internal fun capacity(): Int = keysArray.size
+
+    @PublishedApi
+    internal fun keyAt(idx: Int): K? = keysArray[idx]
+
+    @PublishedApi
+    internal fun valueAt(idx: Int): V {
+        @Suppress("UNCHECKED_CAST")
+        return valuesArray[idx] as V
     }
 
     override fun toString(): String {
         val builder = StringBuilder()
         builder.append("{")
-        valuesArray.forEachIndexed { idx, v ->
-            if (v == null) {
-                return@forEachIndexed
-            }
-            builder.append(keysArray[idx]).append("=").append(v).append(", ")
+        forEachEntry { k, v ->
+            builder.append(k).append("=").append(v).append(", ")
         }
         builder.append("}")
         return builder.toString()
     }
 
+    private fun grow(minSize: Int) {
+        val newSize = maxOf(minSize, valuesArray.size * 2)
+        valuesArray = valuesArray.copyOf(newSize)
+        keysArray = keysArray.copyOf(newSize)
+    }
+
     private fun checkBounds(idx: Int) {
         if (idx >= valuesArray.size || idx < 0) {
             throw IndexOutOfBoundsException("Index $idx is out of bounds: [0, ${valuesArray.size})")
         }
     }
 
-    private data class IntMapEntry<K, V>(override val key: K, override var value: V?) : Map.Entry<K, V?>
+    // Views below are backed by the arrays: no copying on access.
+    private abstract inner class IntMapIterator<T> : MutableIterator<T> {
+        private var next = 0
+        private var last = -1
+
+        override fun hasNext(): Boolean {
+            while (next < keysArray.size && keysArray[next] == null) {
+                next++
+            }
+
+            return next < keysArray.size
+        }
+
+        override fun next(): T {
+            if (!hasNext()) {
+                throw NoSuchElementException()
+            }
+
+            last = next
+            next++
+            return element(last)
+        }
+
+        override fun remove() {
+            if (last == -1 || keysArray[last] == null) {
+                throw IllegalStateException("next() was not called")
+            }
+
+            removeAt(last)
+        }
+
+        abstract fun element(idx: Int): T
+    }
+
+    private inner class IntMapEntry(private val idx: Int) : MutableMap.MutableEntry<K, V> {
+        override val key: K = keyAt(idx)!!
+
+        override val value: V
+            get() = valueAt(idx)
+
+        override fun setValue(newValue: V): V {
+            val old = valueAt(idx)
+            valuesArray[idx] = newValue
+            return old
+        }
+
+        override fun hashCode(): Int = key.hashCode() xor value.hashCode()
+
+        override fun equals(other: Any?): Boolean {
+            if (other !is Map.Entry<*, *>) return false
+            return key == other.key && value == other.value
+        }
+
+        override fun toString(): String = "$key=$value"
+    }
+
+    private inner class EntrySet : AbstractMutableSet<MutableMap.MutableEntry<K, V>>() {
+        override val size: Int
+            get() = count
+
+        override fun add(element: MutableMap.MutableEntry<K, V>): Boolean {
+            throw UnsupportedOperationException("IntMap.entries doesn't support add")
+        }
+
+        override fun iterator(): MutableIterator<MutableMap.MutableEntry<K, V>> = object : IntMapIterator<MutableMap.MutableEntry<K, V>>() {
+            override fun element(idx: Int): MutableMap.MutableEntry<K, V> = IntMapEntry(idx)
+        }
+    }
+
+    private inner class KeySet : AbstractMutableSet<K>() {
+        override val size: Int
+            get() = count
+
+        override fun contains(element: K): Boolean = containsKey(element)
+
+        override fun add(element: K): Boolean {
+            throw UnsupportedOperationException("IntMap.keys doesn't support add")
+        }
+
+        override fun iterator(): MutableIterator<K> = object : IntMapIterator<K>() {
+            override fun element(idx: Int): K = keyAt(idx)!!
+        }
+    }
+
+    private inner class Values : AbstractMutableCollection<V>() {
+        override val size: Int
+            get() = count
+
+        override fun add(element: V): Boolean {
+            throw UnsupportedOperationException("IntMap.values doesn't support add")
+        }
+
+        override fun iterator(): MutableIterator<V> = object : IntMapIterator<V>() {
+            override fun element(idx: Int): V = valueAt(idx)
+        }
+    }
 }
 
-inline fun <reified K, reified T> intMapOf(size: Int, noinline closure: (K) -> Int): MutableMap<K, T> {
+inline fun <reified K, reified T> intMapOf(size: Int, noinline closure: (K) -> Int): IntMap<K, T> {
     return IntMap(arrayOfNulls<T>(size), arrayOfNulls<K>(size), closure)
-}
\ No newline at end of file
+}
@@ -2,10 +2,9 @@ package common
 
 
 class IntSet<E>(private val bitmask: BooleanArray, val values: Array<E>, val closure: (E) -> Int): Set<E> {
-    override val size: Int
-        get() = bitmask.count { it }
+    override val size: Int = bitmask.count { it }
 
-    override fun isEmpty(): Boolean = values.all { it == null }
+    override fun isEmpty(): Boolean = size == 0
 
     override fun containsAll(elements: Collection<E>): Boolean {
         for (elem in elements) {
@@ -26,6 +25,23 @@ class IntSet<E>(private val bitmask: BooleanArray, val values: Array<E>, val clo
         return bitmask.hashCode()
     }
 
+    /**
+     * Iterates over elements in index order without allocation.
+     */
+    inline fun forEachElement(action: (E) -> Unit) {
+        for (idx in 0 until capacity()) {
+            if (isSet(idx)) {
+                action(values[idx])
+            }
+        }
+    }
+
+    @PublishedApi
+    internal fun capacity(): Int = bitmask.size
+
+    @PublishedApi
+    internal fun isSet(idx: Int): Boolean = bitmask[idx]
+
     override fun iterator(): Iterator<E> = IntSetIterator(bitmask, values)
     override fun equals(other: Any?): Boolean {
         if (this === other) return true
@@ -29,13 +29,30 @@ abstract class LeakedLinkedList<T: LListNode>: Collection<T> {
         }
     }
 
-    operator fun get(index: Int): T {
-        var current: LListNode? = head
-        for (i in 0 until index) {
-            current = current!!.next
+    // Walks from the nearest end of the list.
+    private fun nodeAt(index: Int): LListNode {
+        if (index < 0 || index >= size) {
+            throw IndexOutOfBoundsException("Index $index is out of bounds: [0, $size)")
+        }
+
+        if (index < size / 2) {
+            var current: LListNode = head!!
+            for (i in 0 until index) {
+                current = current.next!!
+            }
+            return current
+        }
+
+        var current: LListNode = tail!!
+        for (i in index until size - 1) {
+            current = current.prev!!
         }
+        return current
+    }
+
+    operator fun get(index: Int): T {
         @Suppress("UNCHECKED_CAST")
-        return current as T
+        return nodeAt(index) as T
     }
 
     private fun add(index: Int, value: T) {
@@ -45,12 +62,9 @@ abstract class LeakedLinkedList<T: LListNode>: Collection<T> {
             add(value)
             return
         }
-        var current: LListNode? = head
-        for (i in 0 until index) {
-            current = current!!.next
-        }
+        val current = nodeAt(index)
         value.next = current
-        value.prev = current!!.prev
+        value.prev = current.prev
         current.prev = value
         if (value.prev != null) {
             value.prev!!.next = value
@@ -111,13 +125,8 @@ abstract class LeakedLinkedList<T: LListNode>: Collection<T> {
     }
 
     fun removeAt(index: Int): T {
-        var current: LListNode? = head
-        for (i in 0 until index) {
-            current = current!!.next
-        }
         @Suppress("UNCHECKED_CAST")
-        remove(current as T)
-        return current
+        return remove(nodeAt(index) as T)
     }
 
     override fun containsAll(elements: Collection<T>): Boolean {
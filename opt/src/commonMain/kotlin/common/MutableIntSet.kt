@@ -2,12 +2,15 @@ package common
 
 
 class MutableIntSet<E>(private val bitmask: BooleanArray, val values: Array<E?>, val closure: (E) -> Int): MutableSet<E> {
+    private var count = bitmask.count { it }
+
     override val size: Int
-        get() = bitmask.count { it }
+        get() = count
 
     override fun clear() {
         bitmask.fill(false)
         values.fill(null)
+        count = 0
     }
 
     override fun addAll(elements: Collection<E>): Boolean {
@@ -24,10 +27,13 @@ class MutableIntSet<E>(private val bitmask: BooleanArray, val values: Array<E?>,
         val isHas = bitmask[idx]
         bitmask[idx] = true
         values[idx] = element
-        return isHas
+        if (!isHas) {
+            count += 1
+        }
+        return !isHas
     }
 
-    override fun isEmpty(): Boolean = bitmask.isEmpty()
+    override fun isEmpty(): Boolean = count == 0
 
     override fun containsAll(elements: Collection<E>): Boolean {
         for (elem in elements) {
@@ -47,17 +53,38 @@ class MutableIntSet<E>(private val bitmask: BooleanArray, val values: Array<E?>,
         return bitmask[closure(element)]
     }
 
-    override fun iterator(): MutableIterator<E> {
-        val ret = arrayListOf<E>()
-        for (el in values) {
-            if (el == null) {
-                continue
+    override fun iterator(): MutableIterator<E> = object : MutableIterator<E> {
+        private var next = 0
+        private var last = -1
+
+        override fun hasNext(): Boolean {
+            while (next < bitmask.size && !bitmask[next]) {
+                next++
+            }
+
+            return next < bitmask.size
+        }
+
+        override fun next(): E {
+            if (!hasNext()) {
+                throw NoSuchElementException()
             }
 
-            ret.add(el)
+            last = next
+            next++
+            @Suppress("UNCHECKED_CAST")
+            return values[last] as E
         }
 
-        return ret.iterator()
+        override fun remove() {
+            if (last == -1 || !bitmask[last]) {
+                throw IllegalStateException("next() was not called")
+            }
+
+            bitmask[last] = false
+            values[last] = null
+            count -= 1
+        }
     }
 
     override fun retainAll(elements: Collection<E>): Boolean {
@@ -87,6 +114,9 @@ class MutableIntSet<E>(private val bitmask: BooleanArray, val values: Array<E?>,
         val isHas = bitmask[idx]
         bitmask[idx] = false
         values[idx] = null
+        if (isHas) {
+            count -= 1
+        }
         return isHas
     }
 }
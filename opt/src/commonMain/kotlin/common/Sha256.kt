@@ -0,0 +1,137 @@
+package common
+
+
+/**
+ * SHA-256 message digest, FIPS 180-4.
+ */
+class Sha256 {
+    private val state = INITIAL_STATE.copyOf()
+    private val block = ByteArray(BLOCK_SIZE)
+    private val words = IntArray(64)
+    private var blockLength = 0
+    private var totalLength = 0L
+
+    fun update(bytes: ByteArray): Sha256 {
+        for (b in bytes) {
+            update(b)
+        }
+
+        return this
+    }
+
+    fun update(text: String): Sha256 = update(text.encodeToByteArray())
+
+    private fun update(b: Byte) {
+        block[blockLength] = b
+        blockLength += 1
+        totalLength += 1
+        if (blockLength == BLOCK_SIZE) {
+            compress()
+            blockLength = 0
+        }
+    }
+
+    /**
+     * Completes the hash computation, the instance must not be updated afterward.
+     */
+    fun digest(): ByteArray {
+        val bitLength = totalLength * 8
+        update(0x80.toByte())
+        while (blockLength != BLOCK_SIZE - Long.SIZE_BYTES) {
+            update(0)
+        }
+        for (i in Long.SIZE_BYTES - 1 downTo 0) {
+            update((bitLength ushr (i * 8)).toByte())
+        }
+
+        val result = ByteArray(state.size * Int.SIZE_BYTES)
+        for ((idx, word) in state.withIndex()) {
+            for (i in 0 until Int.SIZE_BYTES) {
+                result[idx * Int.SIZE_BYTES + i] = (word ushr ((Int.SIZE_BYTES - 1 - i) * 8)).toByte()
+            }
+        }
+
+        return result
+    }
+
+    fun hexDigest(): String {
+        val builder = StringBuilder()
+        for (b in digest()) {
+            val value = b.toInt() and 0xFF
+            builder.append(HEX_DIGITS[value ushr 4])
+            builder.append(HEX_DIGITS[value and 0xF])
+        }
+
+        return builder.toString()
+    }
+
+    private fun compress() {
+        for (i in 0 until 16) {
+            words[i] = ((block[i * 4].toInt() and 0xFF) shl 24) or
+                    ((block[i * 4 + 1].toInt() and 0xFF) shl 16) or
+                    ((block[i * 4 + 2].toInt() and 0xFF) shl 8) or
+                    (block[i * 4 + 3].toInt() and 0xFF)
+        }
+        for (i in 16 until 64) {
+            val s0 = words[i - 15].rotateRight(7) xor words[i - 15].rotateRight(18) xor (words[i - 15] ushr 3)
+            val s1 = words[i - 2].rotateRight(17) xor words[i - 2].rotateRight(19) xor (words[i - 2] ushr 10)
+            words[i] = words[i - 16] + s0 + words[i - 7] + s1
+        }
+
+        var a = state[0]
+        var b = state[1]
+        var c = state[2]
+        var d = state[3]
+        var e = state[4]
+        var f = state[5]
+        var g = state[6]
+        var h = state[7]
+        for (i in 0 until 64) {
+            val s1 = e.rotateRight(6) xor e.rotateRight(11) xor e.rotateRight(25)
+            val ch = (e and f) xor (e.inv() and g)
+            val t1 = h + s1 + ch + ROUND_CONSTANTS[i] + words[i]
+            val s0 = a.rotateRight(2) xor a.rotateRight(13) xor a.rotateRight(22)
+            val maj = (a and b) xor (a and c) xor (b and c)
+            val t2 = s0 + maj
+
+            h = g
+            g = f
+            f = e
+            e = d + t1
+            d = c
+            c = b
+            b = a
+            a = t1 + t2
+        }
+
+        state[0] += a
+        state[1] += b
+        state[2] += c
+        state[3] += d
+        state[4] += e
+        state[5] += f
+        state[6] += g
+        state[7] += h
+    }
+
+    companion object {
+        private const val BLOCK_SIZE = 64
+        private const val HEX_DIGITS = "0123456789abcdef"
+
+        private val INITIAL_STATE = intArrayOf(
+            0x6a09e667, -0x4498517b, 0x3c6ef372, -0x5ab00ac6,
+            0x510e527f, -0x64fa9774, 0x1f83d9ab, 0x5be0cd19
+        )
+
+        private val ROUND_CONSTANTS = intArrayOf(
+            0x428a2f98, 0x71374491, -0x4a3f0431, -0x164a245b, 0x3956c25b, 0x59f111f1, -0x6dc07d5c, -0x54e3a12b,
+            -0x27f85568, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, -0x7f214e02, -0x6423f959, -0x3e640e8c,
+            -0x1b64963f, -0x1041b87a, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            -0x67c1aeae, -0x57ce3993, -0x4ffcd838, -0x40a68039, -0x391ff40d, -0x2a586eb9, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, -0x7e3d36d2, -0x6d8dd37b,
+            -0x5d40175f, -0x57e599b5, -0x3db47490, -0x3893ae5d, -0x2e6d17e7, -0x2966f9dc, -0xbf1ca7b, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, -0x7b3787ec, -0x7338fdf8, -0x6f410006, -0x5baf9315, -0x41065c09, -0x398e870e
+        )
+    }
+}
@@ -0,0 +1,120 @@
+package ir.bin
+
+import ir.types.*
+
+
+class BinaryFormatException(message: String): Exception(message)
+
+/**
+ * Layout of the binary IR file:
+ *
+ *   magic, version,
+ *   struct types, function prototypes, forward declared globals,
+ *   constants, globals, function bodies.
+ *
+ * Every section starts with a varint element count. Strings are interned: the first occurrence is written
+ * as the next table index followed by UTF-8 bytes, other occurrences as the table index only.
+ * Blocks are written in preorder, followed by the blocks unreachable from the entry in the order of indices.
+ * Local values are referenced by varint numbers: arguments first, then instructions in the order of blocks.
+ * Intrinsics are written with the provider name and parameters, the reader gets the provider from
+ * [ir.intrinsic.IntrinsicResolver].
+ */
+internal object BinaryFormat {
+    const val MAGIC = 0x42524950 // "PIRB"
+
+    /**
+     * Must be incremented on every incompatible change of the layout.
+     */
+    const val VERSION = 1
+
+    // Types
+    const val TYPE_ARRAY  = 14
+    const val TYPE_STRUCT = 15
+    const val TYPE_TUPLE  = 16
+
+    /**
+     * Types encoded by their index in this array.
+     */
+    val PRIMITIVE_TYPES: Array<Type> = arrayOf(
+        VoidType, FlagType, UndefType,
+        I8Type, U8Type, I16Type, U16Type, I32Type, U32Type, I64Type, U64Type,
+        F32Type, F64Type, PtrType
+    )
+
+    // Values
+    const val VALUE_LOCAL   = 0
+    const val VALUE_SYMBOL  = 1
+    const val VALUE_INT     = 2
+    const val VALUE_F32     = 3
+    const val VALUE_F64     = 4
+    const val VALUE_TRUE    = 5
+    const val VALUE_FALSE   = 6
+    const val VALUE_NULL    = 7
+    const val VALUE_UNDEF   = 8
+    const val VALUE_POINTER = 9
+    const val VALUE_STRING  = 10
+    const val VALUE_LIST    = 11
+
+    // Attributes
+    const val ATTR_VARARG     = 0
+    const val ATTR_BYVAL      = 1
+    const val ATTR_VISIBILITY = 2
+
+    // Declarations
+    const val EXTERN_FUNCTION      = 0
+    const val FUNCTION_DECLARATION = 1
+    const val GLOBAL_VALUE         = 0
+    const val EXTERN_VALUE         = 1
+
+    // Instructions
+    const val OP_ALLOC        = 0
+    const val OP_ADD          = 1
+    const val OP_SUB          = 2
+    const val OP_MUL          = 3
+    const val OP_OR           = 4
+    const val OP_XOR          = 5
+    const val OP_AND          = 6
+    const val OP_SHL          = 7
+    const val OP_SHR          = 8
+    const val OP_DIV          = 9
+    const val OP_TUPLE_DIV    = 10
+    const val OP_NEG          = 11
+    const val OP_NOT          = 12
+    const val OP_BITOP        = 13
+    const val OP_BRANCH       = 14
+    const val OP_BRANCH_COND  = 15
+    const val OP_CALL         = 16
+    const val OP_TUPLE_CALL   = 17
+    const val OP_VOID_CALL    = 18
+    const val OP_ICALL        = 19
+    const val OP_ITUPLE_CALL  = 20
+    const val OP_IVOID_CALL   = 21
+    const val OP_FLAG2INT     = 22
+    const val OP_BITCAST      = 23
+    const val OP_INT2FP       = 24
+    const val OP_UINT2FP      = 25
+    const val OP_ZEXT         = 26
+    const val OP_SEXT         = 27
+    const val OP_TRUNC        = 28
+    const val OP_FPTRUNC      = 29
+    const val OP_FPEXT        = 30
+    const val OP_FP2INT       = 31
+    const val OP_COPY         = 32
+    const val OP_GEP          = 33
+    const val OP_GFP          = 34
+    const val OP_ICMP         = 35
+    const val OP_FCMP         = 36
+    const val OP_LOAD         = 37
+    const val OP_PHI          = 38
+    const val OP_RETURN_VALUE = 39
+    const val OP_RETURN_VOID  = 40
+    const val OP_SELECT       = 41
+    const val OP_STORE        = 42
+    const val OP_INT2PTR      = 43
+    const val OP_PTR2INT      = 44
+    const val OP_MEMCPY       = 45
+    const val OP_MEMSET       = 46
+    const val OP_PROJ         = 47
+    const val OP_SWITCH       = 48
+    const val OP_INTRINSIC    = 49
+}
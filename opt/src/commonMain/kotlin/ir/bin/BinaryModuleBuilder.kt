@@ -0,0 +1,126 @@
+package ir.bin
+
+import ir.attributes.FunctionAttribute
+import ir.instruction.InstBuilder
+import ir.instruction.Instruction
+import ir.instruction.Phi
+import ir.module.*
+import ir.module.block.Block
+import ir.module.builder.AnyFunctionDataBuilder
+import ir.module.builder.AnyModuleBuilder
+import ir.pass.analysis.VerifySSA
+import ir.types.NonTrivialType
+import ir.types.Type
+import ir.value.ArgumentValue
+import ir.value.LocalValue
+
+
+internal class BinaryModuleBuilder private constructor(): AnyModuleBuilder() {
+    private val functions = arrayListOf<BinaryFunctionDataBuilder>()
+
+    fun createFunction(name: String, returnType: Type, argumentTypes: List<NonTrivialType>, argumentValues: List<ArgumentValue>, attributes: Set<FunctionAttribute>): BinaryFunctionDataBuilder {
+        val prototype = FunctionPrototype(name, returnType, argumentTypes, attributes)
+        val data = BinaryFunctionDataBuilder(prototype, argumentValues)
+        functions.add(data)
+        return data
+    }
+
+    fun findFunctionOrNull(name: String): DirectFunctionPrototype? {
+        return functions.find { it.prototype().name() == name }?.prototype() ?: functionDeclarations[name]
+    }
+
+    override fun build(): SSAModule {
+        val fns = functions.map { it.build() }.associateBy { it.name() }
+
+        val ssa = SSAModule(fns, functionDeclarations, constantPool, globals, structs)
+        return VerifySSA.run(ssa)
+    }
+
+    companion object {
+        fun create(): BinaryModuleBuilder {
+            return BinaryModuleBuilder()
+        }
+    }
+}
+
+/**
+ * Puts decoded instructions into blocks of [FunctionData] directly and numbers local values in the order of definition.
+ */
+internal class BinaryFunctionDataBuilder(prototype: FunctionPrototype, argumentValues: List<ArgumentValue>):
+    AnyFunctionDataBuilder(prototype, argumentValues) {
+    private val blocks = arrayListOf<Block>()
+    private val locals = arrayListOf<LocalValue>()
+    private val incompletePhis = arrayListOf<IncompletePhi>()
+
+    init {
+        locals.addAll(argumentValues)
+    }
+
+    fun allocateBlocks(count: Int) {
+        if (count == 0) {
+            throw BinaryFormatException("Function '${prototype.name()}' has no blocks")
+        }
+
+        blocks.add(fd.begin())
+        for (i in 1 until count) {
+            blocks.add(allocateBlock())
+        }
+    }
+
+    fun block(index: Int): Block {
+        if (index < 0 || index >= blocks.size) {
+            throw BinaryFormatException("Block index $index is out of bounds: [0, ${blocks.size})")
+        }
+
+        return blocks[index]
+    }
+
+    fun switchBlock(index: Int) {
+        bb = block(index)
+    }
+
+    fun local(id: Int): LocalValue {
+        if (id < 0 || id >= locals.size) {
+            throw BinaryFormatException("Undefined local value $id in function '${prototype.name()}'")
+        }
+
+        return locals[id]
+    }
+
+    fun <T: Instruction> put(builder: InstBuilder<T>): T {
+        val inst = bb.put(builder)
+        if (inst is LocalValue) {
+            locals.add(inst)
+        }
+
+        return inst
+    }
+
+    /**
+     * Operands of the [phi] referencing locals by id are set in [build], when all locals are defined.
+     */
+    fun phi(phi: InstBuilder<Phi>, localOperands: IntArray) {
+        incompletePhis.add(IncompletePhi(put(phi), localOperands))
+    }
+
+    override fun build(): FunctionData {
+        for ((phi, localOperands) in incompletePhis) {
+            for ((idx, id) in localOperands.withIndex()) {
+                if (id == NO_LOCAL) {
+                    continue
+                }
+
+                phi.value(idx, local(id))
+            }
+        }
+
+        normalizeBlocks()
+        return fd
+    }
+
+    companion object {
+        const val NO_LOCAL = -1
+    }
+}
+
+private data class IncompletePhi(val phi: Phi, val localOperands: IntArray)
@@ -0,0 +1,84 @@
+package ir.bin
+
+
+/**
+ * Reader of the data written by [ByteOutput].
+ */
+class ByteInput(private val bytes: ByteArray) {
+    private var position = 0
+
+    fun isEnd(): Boolean = position >= bytes.size
+
+    fun readByte(): Int {
+        if (isEnd()) {
+            throw BinaryFormatException("Unexpected end of data at $position")
+        }
+
+        val value = bytes[position].toInt() and 0xFF
+        position += 1
+        return value
+    }
+
+    fun readBytes(length: Int): ByteArray {
+        if (length < 0 || position + length > bytes.size) {
+            throw BinaryFormatException("Unexpected end of data at $position: length=$length")
+        }
+
+        val result = bytes.copyOfRange(position, position + length)
+        position += length
+        return result
+    }
+
+    fun readVarint(): Int {
+        val value = readVarLong()
+        if (value < 0 || value > Int.MAX_VALUE) {
+            throw BinaryFormatException("Varint is out of range: $value")
+        }
+
+        return value.toInt()
+    }
+
+    fun readVarLong(): Long {
+        var result = 0L
+        var shift = 0
+        while (true) {
+            val b = readByte()
+            result = result or ((b and 0x7F).toLong() shl shift)
+            if (b and 0x80 == 0) {
+                return result
+            }
+
+            shift += 7
+            if (shift >= Long.SIZE_BITS) {
+                throw BinaryFormatException("Varint is too long at $position")
+            }
+        }
+    }
+
+    fun readSignedVarLong(): Long {
+        val value = readVarLong()
+        return (value ushr 1) xor -(value and 1)
+    }
+
+    fun readInt32(): Int {
+        var result = 0
+        for (i in 0 until Int.SIZE_BYTES) {
+            result = result or (readByte() shl (i * 8))
+        }
+
+        return result
+    }
+
+    fun readInt64(): Long {
+        var result = 0L
+        for (i in 0 until Long.SIZE_BYTES) {
+            result = result or (readByte().toLong() shl (i * 8))
+        }
+
+        return result
+    }
+
+    fun readString(): String {
+        return readBytes(readVarint()).decodeToString()
+    }
+}
@@ -0,0 +1,73 @@
+package ir.bin
+
+
+/**
+ * Growable byte buffer. Integers are written as LEB128 varints, signed ones are zigzag encoded before.
+ */
+class ByteOutput(initialCapacity: Int = 1024) {
+    private var buffer = ByteArray(initialCapacity)
+    private var size = 0
+
+    private fun ensureCapacity(extra: Int) {
+        if (size + extra <= buffer.size) {
+            return
+        }
+
+        buffer = buffer.copyOf(maxOf(size + extra, buffer.size * 2))
+    }
+
+    fun size(): Int = size
+
+    fun writeByte(value: Int) {
+        ensureCapacity(1)
+        buffer[size] = value.toByte()
+        size += 1
+    }
+
+    fun writeBytes(bytes: ByteArray) {
+        ensureCapacity(bytes.size)
+        bytes.copyInto(buffer, size)
+        size += bytes.size
+    }
+
+    fun writeVarint(value: Int) {
+        if (value < 0) {
+            throw IllegalArgumentException("Negative varint: $value")
+        }
+
+        writeVarLong(value.toLong())
+    }
+
+    fun writeVarLong(value: Long) {
+        var v = value
+        while (v and 0x7FL.inv() != 0L) {
+            writeByte(((v and 0x7F) or 0x80).toInt())
+            v = v ushr 7
+        }
+        writeByte(v.toInt())
+    }
+
+    fun writeSignedVarLong(value: Long) {
+        writeVarLong((value shl 1) xor (value shr 63))
+    }
+
+    fun writeInt32(value: Int) {
+        for (i in 0 until Int.SIZE_BYTES) {
+            writeByte(value ushr (i * 8))
+        }
+    }
+
+    fun writeInt64(value: Long) {
+        for (i in 0 until Long.SIZE_BYTES) {
+            writeByte((value ushr (i * 8)).toInt())
+        }
+    }
+
+    fun writeString(value: String) {
+        val bytes = value.encodeToByteArray()
+        writeVarint(bytes.size)
+        writeBytes(bytes)
+    }
+
+    fun toByteArray(): ByteArray = buffer.copyOf(size)
+}
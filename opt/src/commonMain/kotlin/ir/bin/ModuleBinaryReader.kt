@@ -0,0 +1,460 @@
+package ir.bin
+
+import common.readBinaryFile
+import ir.attributes.*
+import ir.global.*
+import ir.instruction.*
+import ir.intrinsic.IntrinsicResolver
+import ir.module.DirectFunctionPrototype
+import ir.module.IndirectFunctionPrototype
+import ir.module.SSAModule
+import ir.module.block.Block
+import ir.types.*
+import ir.value.ArgumentValue
+import ir.value.Value
+import ir.value.asValue
+import ir.value.constant.*
+
+
+/**
+ * Builds [SSAModule] from the data written by [ModuleBinaryWriter].
+ * Unlike [ir.read.ModuleReader] there is no tokenization: instructions are put into blocks as they are decoded.
+ */
+class ModuleBinaryReader private constructor(bytes: ByteArray, private val intrinsics: IntrinsicResolver) {
+    private val input = ByteInput(bytes)
+    private val strings = arrayListOf<String>()
+    private val moduleBuilder = BinaryModuleBuilder.create()
+
+    private fun read(): SSAModule {
+        readHeader()
+        readStructTypes()
+        val functions = readPrototypes()
+        readForwardDeclarations()
+        readConstants()
+        readGlobals()
+        for (fn in functions) {
+            FunctionBodyReader(fn).read()
+        }
+
+        if (!input.isEnd()) {
+            throw BinaryFormatException("Unexpected data after the end of module")
+        }
+
+        return moduleBuilder.build()
+    }
+
+    private fun readHeader() {
+        val magic = input.readInt32()
+        if (magic != BinaryFormat.MAGIC) {
+            throw BinaryFormatException("Not a binary IR file: magic=${magic.toString(16)}")
+        }
+
+        val version = input.readVarint()
+        if (version != BinaryFormat.VERSION) {
+            throw BinaryFormatException("Unsupported binary IR version: $version, expected ${BinaryFormat.VERSION}")
+        }
+    }
+
+    private fun readName(): String {
+        val idx = input.readVarint()
+        if (idx == strings.size) {
+            val string = input.readString()
+            strings.add(string)
+            return string
+        }
+        if (idx > strings.size) {
+            throw BinaryFormatException("String index $idx is out of bounds: [0, ${strings.size}]")
+        }
+
+        return strings[idx]
+    }
+
+    private inline fun<reified E: Enum<E>> readEnum(): E {
+        val ordinal = input.readVarint()
+        val entries = enumValues<E>()
+        if (ordinal >= entries.size) {
+            throw BinaryFormatException("Invalid ${E::class.simpleName} ordinal: $ordinal")
+        }
+
+        return entries[ordinal]
+    }
+
+    private fun readType(): Type {
+        val tag = input.readByte()
+        if (tag < BinaryFormat.PRIMITIVE_TYPES.size) {
+            return BinaryFormat.PRIMITIVE_TYPES[tag]
+        }
+
+        return when (tag) {
+            BinaryFormat.TYPE_ARRAY -> {
+                val elementType = readType().asType<NonTrivialType>()
+                ArrayType(elementType, input.readVarint())
+            }
+            BinaryFormat.TYPE_STRUCT -> findStructType(readName())
+            BinaryFormat.TYPE_TUPLE  -> {
+                val innerTypes = Array(input.readVarint()) { readType().asType<PrimitiveType>() }
+                TupleType(innerTypes)
+            }
+            else -> throw BinaryFormatException("Unknown type tag: $tag")
+        }
+    }
+
+    private fun readNonTrivialTypes(): List<NonTrivialType> {
+        val count = input.readVarint()
+        return (0 until count).mapTo(arrayListOf()) { readType().asType<NonTrivialType>() }
+    }
+
+    private fun findStructType(name: String): StructType {
+        return moduleBuilder.findStructTypeOrNull(name) ?: throw BinaryFormatException("Struct type '$name' not found")
+    }
+
+    private fun findFunction(name: String): DirectFunctionPrototype {
+        return moduleBuilder.findFunctionOrNull(name) ?: throw BinaryFormatException("Function '$name' not found")
+    }
+
+    private fun findSymbol(name: String): GlobalSymbol {
+        return moduleBuilder.findConstantOrNull(name)
+            ?: moduleBuilder.findGlobalOrNull(name)
+            ?: moduleBuilder.findFunctionOrNull(name)
+            ?: throw BinaryFormatException("Symbol '$name' not found")
+    }
+
+    private fun readStructTypes() {
+        repeat(input.readVarint()) {
+            val name = readName()
+            val fields = readNonTrivialTypes()
+            moduleBuilder.structType(name, fields, input.readVarint())
+        }
+    }
+
+    private fun readByValue(): ByValue {
+        val argumentIndex = input.readVarint()
+        return ByValue(argumentIndex, findStructType(readName()))
+    }
+
+    private fun readAttributes(): Set<FunctionAttribute> {
+        val attributes = hashSetOf<FunctionAttribute>()
+        repeat(input.readVarint()) {
+            val attribute = when (val tag = input.readByte()) {
+                BinaryFormat.ATTR_VARARG     -> VarArgAttribute
+                BinaryFormat.ATTR_BYVAL      -> readByValue()
+                BinaryFormat.ATTR_VISIBILITY -> readEnum<GlobalValueAttribute>()
+                else -> throw BinaryFormatException("Unknown attribute tag: $tag")
+            }
+            attributes.add(attribute)
+        }
+
+        return attributes
+    }
+
+    private fun readPrototypes(): List<BinaryFunctionDataBuilder> {
+        repeat(input.readVarint()) {
+            val kind       = input.readByte()
+            val name       = readName()
+            val returnType = readType()
+            val arguments  = readNonTrivialTypes()
+            val attributes = readAttributes()
+            when (kind) {
+                BinaryFormat.EXTERN_FUNCTION      -> moduleBuilder.createExternFunction(name, returnType, arguments, attributes)
+                BinaryFormat.FUNCTION_DECLARATION -> moduleBuilder.createFunctionDeclaration(name, returnType, arguments, attributes)
+                else -> throw BinaryFormatException("Unknown function declaration kind: $kind")
+            }
+        }
+
+        val functions = arrayListOf<BinaryFunctionDataBuilder>()
+        repeat(input.readVarint()) {
+            val name       = readName()
+            val returnType = readType()
+            val arguments  = readNonTrivialTypes()
+            val attributes = readAttributes()
+
+            val argumentValues = arrayListOf<ArgumentValue>()
+            repeat(input.readVarint()) {
+                val position = input.readVarint()
+                val type = readType().asType<NonTrivialType>()
+                val argAttributes = hashSetOf<ArgumentValueAttribute>()
+                repeat(input.readVarint()) {
+                    argAttributes.add(readByValue())
+                }
+                argumentValues.add(ArgumentValue(position, type, argAttributes))
+            }
+
+            functions.add(moduleBuilder.createFunction(name, returnType, arguments, argumentValues, attributes))
+        }
+
+        return functions
+    }
+
+    private fun readForwardDeclarations() {
+        repeat(input.readVarint()) {
+            val name = readName()
+            moduleBuilder.addExternValue(name, readType().asType())
+                ?: throw BinaryFormatException("Global '$name' is declared twice")
+        }
+    }
+
+    private fun readConstants() {
+        repeat(input.readVarint()) {
+            val name = readName()
+            moduleBuilder.addConstant(makeGlobalConstant(name, readConstant()))
+        }
+    }
+
+    private fun makeGlobalConstant(name: String, constant: NonTrivialConstant): GlobalConstant {
+        return GlobalConstant.of(name, constant) ?: throw BinaryFormatException("Unsupported constant '$name': $constant")
+    }
+
+    private fun readGlobals() {
+        repeat(input.readVarint()) {
+            when (val kind = input.readByte()) {
+                BinaryFormat.GLOBAL_VALUE -> {
+                    val name        = readName()
+                    val initializer = readConstant()
+                    val attribute   = readEnum<GlobalValueAttribute>()
+                    val declared    = moduleBuilder.findGlobalOrNull(name)
+                    if (declared is ExternValue) {
+                        moduleBuilder.redefineGlobalValue(declared, name, initializer, attribute)
+                    } else {
+                        moduleBuilder.addGlobalValue(name, initializer, attribute)
+                    }
+                }
+                BinaryFormat.EXTERN_VALUE -> {
+                    val name = readName()
+                    val type = readType().asType<NonTrivialType>()
+                    if (moduleBuilder.findGlobalOrNull(name) == null) {
+                        moduleBuilder.addExternValue(name, type)
+                    }
+                }
+                else -> throw BinaryFormatException("Unknown global kind: $kind")
+            }
+        }
+    }
+
+    private fun readConstant(): NonTrivialConstant {
+        return readConstant(input.readByte())
+    }
+
+    private fun readConstant(tag: Int): NonTrivialConstant = when (tag) {
+        BinaryFormat.VALUE_INT -> {
+            val type = readType().asType<IntegerType>()
+            IntegerConstant.of(type, input.readSignedVarLong())
+        }
+        BinaryFormat.VALUE_F32   -> F32Value(Float.fromBits(input.readInt32()))
+        BinaryFormat.VALUE_F64   -> F64Value(Double.fromBits(input.readInt64()))
+        BinaryFormat.VALUE_NULL  -> NullValue
+        BinaryFormat.VALUE_UNDEF -> UndefValue
+        BinaryFormat.VALUE_POINTER -> {
+            val symbol = findSymbol(readName())
+            PointerLiteral.of(symbol, input.readVarint())
+        }
+        BinaryFormat.VALUE_STRING -> {
+            val type = readType().asType<ArrayType>()
+            StringLiteralConstant(type, input.readString())
+        }
+        BinaryFormat.VALUE_LIST -> {
+            val type = readType().asType<AggregateType>()
+            val elements = (0 until input.readVarint()).mapTo(arrayListOf()) { readConstant() }
+            InitializerListValue(type, elements)
+        }
+        else -> throw BinaryFormatException("Unknown constant tag: $tag")
+    }
+
+    private inner class FunctionBodyReader(private val fn: BinaryFunctionDataBuilder) {
+        fun read() {
+            val blockCount = input.readVarint()
+            fn.allocateBlocks(blockCount)
+            for (idx in 0 until blockCount) {
+                fn.switchBlock(idx)
+                repeat(input.readVarint()) {
+                    readInstruction()
+                }
+            }
+        }
+
+        private fun readBlock(): Block {
+            return fn.block(input.readVarint())
+        }
+
+        private fun readValue(): Value {
+            return readValue(input.readByte())
+        }
+
+        private fun readValue(tag: Int): Value = when (tag) {
+            BinaryFormat.VALUE_LOCAL  -> fn.local(input.readVarint())
+            BinaryFormat.VALUE_SYMBOL -> findSymbol(readName())
+            BinaryFormat.VALUE_TRUE   -> TrueBoolValue
+            BinaryFormat.VALUE_FALSE  -> FalseBoolValue
+            else -> readConstant(tag)
+        }
+
+        private fun readValues(): List<Value> {
+            val count = input.readVarint()
+            return (0 until count).mapTo(arrayListOf()) { readValue() }
+        }
+
+        private fun readIntrinsic(): InstBuilder<Intrinsic> {
+            val name       = readName()
+            val parameters = IntArray(input.readVarint()) { input.readSignedVarLong().toInt() }
+            val provider   = intrinsics.resolve(name, parameters)
+                ?: throw BinaryFormatException("Unknown intrinsic '@$name' with parameters ${parameters.contentToString()}")
+
+            return Intrinsic.intrinsic(readValues().toTypedArray(), provider, readBlock())
+        }
+
+        private fun readIndirectPrototype(): IndirectFunctionPrototype {
+            val returnType = readType()
+            val arguments  = readNonTrivialTypes()
+            return IndirectFunctionPrototype(returnType, arguments, readAttributes())
+        }
+
+        private fun readInstruction() {
+            val opcode = input.readByte()
+            if (opcode == BinaryFormat.OP_PHI) {
+                readPhi()
+                return
+            }
+
+            fn.put(decode(opcode))
+        }
+
+        private fun readPhi() {
+            val type = readType().asType<PrimitiveType>()
+            val count = input.readVarint()
+            val incoming = arrayOfNulls<Block>(count)
+            val values = Array<Value>(count) { UndefValue }
+            val localOperands = IntArray(count) { BinaryFunctionDataBuilder.NO_LOCAL }
+            for (idx in 0 until count) {
+                incoming[idx] = readBlock()
+                val tag = input.readByte()
+                if (tag == BinaryFormat.VALUE_LOCAL) {
+                    localOperands[idx] = input.readVarint()
+                } else {
+                    values[idx] = readValue(tag)
+                }
+            }
+
+            val blocks = Array(count) { incoming[it]!! }
+            fn.phi(Phi.phi(blocks, type, values), localOperands)
+        }
+
+        private fun decode(opcode: Int): InstBuilder<Instruction> = when (opcode) {
+            BinaryFormat.OP_ALLOC     -> Alloc.alloc(readType().asType())
+            BinaryFormat.OP_ADD       -> Add.add(readValue(), readValue())
+            BinaryFormat.OP_SUB       -> Sub.sub(readValue(), readValue())
+            BinaryFormat.OP_MUL       -> Mul.mul(readValue(), readValue())
+            BinaryFormat.OP_OR        -> Or.or(readValue(), readValue())
+            BinaryFormat.OP_XOR       -> Xor.xor(readValue(), readValue())
+            BinaryFormat.OP_AND       -> And.and(readValue(), readValue())
+            BinaryFormat.OP_SHL       -> Shl.shl(readValue(), readValue())
+            BinaryFormat.OP_SHR       -> Shr.shr(readValue(), readValue())
+            BinaryFormat.OP_DIV       -> Div.div(readValue(), readValue())
+            BinaryFormat.OP_TUPLE_DIV -> TupleDiv.div(readValue(), readValue())
+            BinaryFormat.OP_NEG       -> Neg.neg(readValue())
+            BinaryFormat.OP_NOT       -> Not.not(readValue())
+            BinaryFormat.OP_BITOP     -> {
+                val op = readEnum<BitOpType>()
+                BitOp.bitop(op, readValue())
+            }
+            BinaryFormat.OP_BRANCH      -> Branch.br(readBlock())
+            BinaryFormat.OP_BRANCH_COND -> BranchCond.br(readValue(), readBlock(), readBlock())
+            BinaryFormat.OP_CALL        -> Call.call(findFunction(readName()), readValues(), readAttributes(), readBlock())
+            BinaryFormat.OP_TUPLE_CALL  -> TupleCall.call(findFunction(readName()), readValues(), readAttributes(), readBlock())
+            BinaryFormat.OP_VOID_CALL   -> VoidCall.call(findFunction(readName()), readValues(), readAttributes(), readBlock())
+            BinaryFormat.OP_ICALL       -> IndirectionCall.call(readValue(), readIndirectPrototype(), readValues(), readAttributes(), readBlock())
+            BinaryFormat.OP_ITUPLE_CALL -> IndirectionTupleCall.call(readValue(), readIndirectPrototype(), readValues(), readAttributes(), readBlock())
+            BinaryFormat.OP_IVOID_CALL  -> IndirectionVoidCall.call(readValue(), readIndirectPrototype(), readValues(), readAttributes(), readBlock())
+            BinaryFormat.OP_FLAG2INT -> {
+                val operand = readValue()
+                Flag2Int.flag2int(operand, readType().asType())
+            }
+            BinaryFormat.OP_BITCAST -> {
+                val operand = readValue()
+                Bitcast.bitcast(operand, readType().asType())
+            }
+            BinaryFormat.OP_INT2FP -> {
+                val operand = readValue()
+                Int2Float.int2fp(operand, readType().asType())
+            }
+            BinaryFormat.OP_UINT2FP -> {
+                val operand = readValue()
+                Unsigned2Float.uint2fp(operand, readType().asType())
+            }
+            BinaryFormat.OP_ZEXT -> {
+                val operand = readValue()
+                ZeroExtend.zext(operand, readType().asType())
+            }
+            BinaryFormat.OP_SEXT -> {
+                val operand = readValue()
+                SignExtend.sext(operand, readType().asType())
+            }
+            BinaryFormat.OP_TRUNC -> {
+                val operand = readValue()
+                Truncate.trunc(operand, readType().asType())
+            }
+            BinaryFormat.OP_FPTRUNC -> {
+                val operand = readValue()
+                FpTruncate.fptrunc(operand, readType().asType())
+            }
+            BinaryFormat.OP_FPEXT -> {
+                val operand = readValue()
+                FpExtend.fpext(operand, readType().asType())
+            }
+            BinaryFormat.OP_FP2INT -> {
+                val operand = readValue()
+                Float2Int.fp2int(operand, readType().asType())
+            }
+            BinaryFormat.OP_COPY -> Copy.copy(readValue())
+            BinaryFormat.OP_GEP  -> GetElementPtr.gep(readValue(), readType().asType(), readValue())
+            BinaryFormat.OP_GFP  -> GetFieldPtr.gfp(readValue(), readType().asType(), readValue().asValue())
+            BinaryFormat.OP_ICMP -> {
+                val predicate = readEnum<IntPredicate>()
+                IntCompare.icmp(readValue(), predicate, readValue())
+            }
+            BinaryFormat.OP_FCMP -> {
+                val predicate = readEnum<FloatPredicate>()
+                FloatCompare.fcmp(readValue(), predicate, readValue())
+            }
+            BinaryFormat.OP_LOAD -> {
+                val pointer = readValue()
+                Load.load(readType().asType(), pointer)
+            }
+            BinaryFormat.OP_RETURN_VALUE -> {
+                val returnType = readType()
+                ReturnValue.ret(returnType, readValues().toTypedArray())
+            }
+            BinaryFormat.OP_RETURN_VOID -> ReturnVoid.ret()
+            BinaryFormat.OP_SELECT -> {
+                val type = readType().asType<IntegerType>()
+                Select.select(readValue(), type, readValue(), readValue())
+            }
+            BinaryFormat.OP_STORE   -> Store.store(readValue(), readValue())
+            BinaryFormat.OP_INT2PTR -> Int2Pointer.int2ptr(readValue())
+            BinaryFormat.OP_PTR2INT -> {
+                val operand = readValue()
+                Pointer2Int.ptr2int(operand, readType().asType())
+            }
+            BinaryFormat.OP_MEMCPY -> Memcpy.memcpy(readValue(), readValue(), readValue().asValue())
+            BinaryFormat.OP_MEMSET -> Memset.memset(readValue(), readValue().asValue(), readValue().asValue())
+            BinaryFormat.OP_PROJ   -> Projection.proj(readValue(), input.readVarint())
+            BinaryFormat.OP_SWITCH -> {
+                val value   = readValue()
+                val default = readBlock()
+                val table   = Array(input.readVarint()) { readValue().asValue<IntegerConstant>() }
+                val targets = Array(table.size) { readBlock() }
+                Switch.switch(value, default, table, targets)
+            }
+            BinaryFormat.OP_INTRINSIC -> readIntrinsic()
+            else -> throw BinaryFormatException("Unknown opcode: $opcode")
+        }
+    }
+
+    companion object {
+        fun read(bytes: ByteArray, intrinsics: IntrinsicResolver = IntrinsicResolver.NONE): SSAModule {
+            return ModuleBinaryReader(bytes, intrinsics).read()
+        }
+
+        fun read(filename: String, intrinsics: IntrinsicResolver = IntrinsicResolver.NONE): SSAModule {
+            return read(readBinaryFile(filename), intrinsics)
+        }
+    }
+}
@@ -0,0 +1,631 @@
+package ir.bin
+
+import common.writeBinaryFile
+import ir.attributes.ByValue
+import ir.attributes.FunctionAttribute
+import ir.attributes.GlobalValueAttribute
+import ir.attributes.VarArgAttribute
+import ir.global.*
+import ir.instruction.*
+import ir.instruction.lir.*
+import ir.instruction.utils.IRInstructionVisitor
+import ir.module.*
+import ir.module.block.Block
+import ir.pass.analysis.traverse.BlockOrder
+import ir.pass.analysis.traverse.PreOrderFabric
+import ir.types.*
+import ir.value.LocalValue
+import ir.value.Value
+import ir.value.constant.*
+
+
+/**
+ * Serializes [SSAModule] to the binary format described in [BinaryFormat].
+ */
+class ModuleBinaryWriter private constructor(private val module: SSAModule) {
+    private val output = ByteOutput()
+    private val strings = hashMapOf<String, Int>()
+    private val primitiveTypes = BinaryFormat.PRIMITIVE_TYPES.withIndex().associate { (idx, type) -> type to idx }
+
+    private fun write(): ByteArray {
+        output.writeInt32(BinaryFormat.MAGIC)
+        output.writeVarint(BinaryFormat.VERSION)
+
+        writeStructTypes()
+        writePrototypes()
+
+        val constants = orderedConstants()
+        writeForwardDeclarations(constants)
+        writeConstants(constants)
+        writeGlobals()
+        writeFunctionBodies()
+
+        return output.toByteArray()
+    }
+
+    private fun writeName(name: String) {
+        val idx = strings[name]
+        if (idx != null) {
+            output.writeVarint(idx)
+            return
+        }
+
+        output.writeVarint(strings.size)
+        output.writeString(name)
+        strings[name] = strings.size
+    }
+
+    private fun writeType(type: Type) {
+        val tag = primitiveTypes[type]
+        if (tag != null) {
+            output.writeByte(tag)
+            return
+        }
+
+        when (type) {
+            is ArrayType -> {
+                output.writeByte(BinaryFormat.TYPE_ARRAY)
+                writeType(type.elementType())
+                output.writeVarint(type.length)
+            }
+            is StructType -> {
+                output.writeByte(BinaryFormat.TYPE_STRUCT)
+                writeName(type.name)
+            }
+            is TupleType -> {
+                output.writeByte(BinaryFormat.TYPE_TUPLE)
+                val innerTypes = type.innerTypes()
+                output.writeVarint(innerTypes.size)
+                innerTypes.forEach { writeType(it) }
+            }
+            else -> throw BinaryFormatException("Unsupported type: $type")
+        }
+    }
+
+    private fun writeTypes(types: List<Type>) {
+        output.writeVarint(types.size)
+        types.forEach { writeType(it) }
+    }
+
+    /**
+     * Struct types are written after the types of their fields.
+     */
+    private fun writeStructTypes() {
+        val visited = hashSetOf<String>()
+        val order = arrayListOf<StructType>()
+
+        fun visitType(type: NonTrivialType) {
+            when (type) {
+                is ArrayType  -> visitType(type.elementType())
+                is StructType -> {
+                    if (!visited.add(type.name)) {
+                        return
+                    }
+                    type.fields.forEach { visitType(it) }
+                    order.add(type)
+                }
+                else -> {}
+            }
+        }
+
+        module.types.values.forEach { visitType(it) }
+
+        output.writeVarint(order.size)
+        for (struct in order) {
+            writeName(struct.name)
+            writeTypes(struct.fields)
+            output.writeVarint(struct.alignmentOf())
+        }
+    }
+
+    private fun writeByValue(byValue: ByValue) {
+        output.writeVarint(byValue.argumentIndex)
+        writeName(byValue.aggregateType.name)
+    }
+
+    private fun writeAttributes(attributes: Set<FunctionAttribute>) {
+        output.writeVarint(attributes.size)
+        for (attribute in attributes) {
+            when (attribute) {
+                is VarArgAttribute -> output.writeByte(BinaryFormat.ATTR_VARARG)
+                is ByValue -> {
+                    output.writeByte(BinaryFormat.ATTR_BYVAL)
+                    writeByValue(attribute)
+                }
+                is GlobalValueAttribute -> {
+                    output.writeByte(BinaryFormat.ATTR_VISIBILITY)
+                    output.writeVarint(attribute.ordinal)
+                }
+            }
+        }
+    }
+
+    private fun writePrototype(prototype: AnyFunctionPrototype) {
+        writeType(prototype.returnType())
+        writeTypes(prototype.arguments())
+        writeAttributes(prototype.attributes)
+    }
+
+    private fun writePrototypes() {
+        output.writeVarint(module.externFunctions.size)
+        for (extern in module.externFunctions.values) {
+            val kind = when (extern) {
+                is ExternFunction    -> BinaryFormat.EXTERN_FUNCTION
+                is FunctionPrototype -> BinaryFormat.FUNCTION_DECLARATION
+            }
+            output.writeByte(kind)
+            writeName(extern.name)
+            writePrototype(extern)
+        }
+
+        val functions = module.functions()
+        output.writeVarint(functions.size)
+        for (fd in functions) {
+            writeName(fd.name())
+            writePrototype(fd.prototype)
+
+            val arguments = fd.arguments()
+            output.writeVarint(arguments.size)
+            for (arg in arguments) {
+                output.writeVarint(arg.position())
+                writeType(arg.type())
+                output.writeVarint(arg.attributes.size)
+                for (attribute in arg.attributes) {
+                    when (attribute) {
+                        is ByValue -> writeByValue(attribute)
+                    }
+                }
+            }
+        }
+    }
+
+    private fun forEachSymbol(constant: NonTrivialConstant, action: (GlobalSymbol) -> Unit) {
+        when (constant) {
+            is PointerLiteral       -> action(constant.gConstant)
+            is InitializerListValue -> constant.elements.forEach { forEachSymbol(it, action) }
+            else -> {}
+        }
+    }
+
+    /**
+     * Constants are written after the constants they point to.
+     */
+    private fun orderedConstants(): List<GlobalConstant> {
+        val visited = hashSetOf<String>()
+        val order = arrayListOf<GlobalConstant>()
+
+        fun visit(constant: GlobalConstant) {
+            if (!visited.add(constant.name())) {
+                return
+            }
+
+            forEachSymbol(constant.constant()) { symbol ->
+                val dependency = module.constantPool[symbol.name()]
+                if (symbol is GlobalConstant && dependency != null) {
+                    visit(dependency)
+                }
+            }
+            order.add(constant)
+        }
+
+        module.constantPool.values.forEach { visit(it) }
+        return order
+    }
+
+    /**
+     * Globals may point to each other in any order, so the ones referenced before their definition
+     * are declared first and redefined by the reader later.
+     */
+    private fun writeForwardDeclarations(constants: List<GlobalConstant>) {
+        val defined = hashSetOf<String>()
+        val forward = linkedMapOf<String, AnyGlobalValue>()
+        val visitor = { symbol: GlobalSymbol ->
+            val global = module.globals[symbol.name()]
+            if (symbol is AnyGlobalValue && global != null && symbol.name() !in defined) {
+                forward[symbol.name()] = global
+            }
+        }
+
+        constants.forEach { forEachSymbol(it.constant(), visitor) }
+        for (global in module.globals.values) {
+            if (global is GlobalValue) {
+                forEachSymbol(global.initializer(), visitor)
+            }
+            defined.add(global.name())
+        }
+
+        output.writeVarint(forward.size)
+        for (global in forward.values) {
+            writeName(global.name())
+            when (global) {
+                is GlobalValue -> writeType(global.contentType())
+                is ExternValue -> writeType(global.type)
+            }
+        }
+    }
+
+    private fun writeConstants(constants: List<GlobalConstant>) {
+        output.writeVarint(constants.size)
+        for (constant in constants) {
+            writeName(constant.name())
+            writeConstant(constant.constant())
+        }
+    }
+
+    private fun writeGlobals() {
+        output.writeVarint(module.globals.size)
+        for (global in module.globals.values) {
+            when (global) {
+                is GlobalValue -> {
+                    output.writeByte(BinaryFormat.GLOBAL_VALUE)
+                    writeName(global.name())
+                    writeConstant(global.initializer())
+                    output.writeVarint(global.attribute().ordinal)
+                }
+                is ExternValue -> {
+                    output.writeByte(BinaryFormat.EXTERN_VALUE)
+                    writeName(global.name())
+                    writeType(global.type)
+                }
+            }
+        }
+    }
+
+    private fun writeConstant(constant: NonTrivialConstant) {
+        when (constant) {
+            is IntegerConstant -> {
+                output.writeByte(BinaryFormat.VALUE_INT)
+                writeType(constant.type())
+                output.writeSignedVarLong(constant.value())
+            }
+            is F32Value -> {
+                output.writeByte(BinaryFormat.VALUE_F32)
+                output.writeInt32(constant.bits())
+            }
+            is F64Value -> {
+                output.writeByte(BinaryFormat.VALUE_F64)
+                output.writeInt64(constant.bits())
+            }
+            is NullValue  -> output.writeByte(BinaryFormat.VALUE_NULL)
+            is UndefValue -> output.writeByte(BinaryFormat.VALUE_UNDEF)
+            is PointerLiteral -> {
+                output.writeByte(BinaryFormat.VALUE_POINTER)
+                writeName(constant.gConstant.name())
+                output.writeVarint(constant.index)
+            }
+            is StringLiteralConstant -> {
+                output.writeByte(BinaryFormat.VALUE_STRING)
+                writeType(constant.type())
+                output.writeString(constant.content)
+            }
+            is InitializerListValue -> {
+                output.writeByte(BinaryFormat.VALUE_LIST)
+                writeType(constant.type())
+                output.writeVarint(constant.elements.size)
+                constant.elements.forEach { writeConstant(it) }
+            }
+        }
+    }
+
+    private fun writeFunctionBodies() {
+        for (fd in module.functions()) {
+            FunctionBodyWriter(fd).write()
+        }
+    }
+
+    private inner class FunctionBodyWriter(private val fd: FunctionData) : IRInstructionVisitor<Unit>() {
+        private val order: BlockOrder = orderBlocks()
+        private val locals = hashMapOf<LocalValue, Int>()
+
+        private fun raiseError(message: String): BinaryFormatException {
+            return BinaryFormatException("$message, function=${fd.prototype.shortDescription()}")
+        }
+
+        /**
+         * Preorder puts definitions before their uses except in phi. Blocks unreachable from the entry
+         * are still valid IR and phi may name them as predecessors, so they go last ordered by index.
+         * The reader numbers blocks in the written order, so writing the module again gives the same bytes.
+         */
+        private fun orderBlocks(): BlockOrder {
+            val preorder = fd.analysis(PreOrderFabric)
+            if (preorder.size == fd.blocks().size()) {
+                return preorder
+            }
+
+            val unreachable = arrayListOf<Block>()
+            for (bb in fd) {
+                if (!preorder.contains(bb)) {
+                    unreachable.add(bb)
+                }
+            }
+            unreachable.sortBy { it.index }
+
+            return BlockOrder(preorder + unreachable, fd.marker())
+        }
+
+        // Phi may use a value defined later, so all locals are numbered before writing.
+        private fun numberLocals() {
+            for (arg in fd.arguments()) {
+                locals[arg] = locals.size
+            }
+
+            for (bb in order) {
+                for (inst in bb) {
+                    if (inst is LocalValue) {
+                        locals[inst] = locals.size
+                    }
+                }
+            }
+        }
+
+        fun write() {
+            numberLocals()
+
+            output.writeVarint(order.size)
+            for (bb in order) {
+                output.writeVarint(bb.size)
+                for (inst in bb) {
+                    inst.accept(this)
+                }
+            }
+        }
+
+        private fun writeBlock(block: Block) {
+            val idx = order.indexOf(block)
+            if (idx < 0) {
+                throw raiseError("block=$block isn't in the function")
+            }
+
+            output.writeVarint(idx)
+        }
+
+        private fun writeValue(value: Value) {
+            when (value) {
+                is LocalValue -> {
+                    val id = locals[value] ?: throw raiseError("undefined value=$value")
+                    output.writeByte(BinaryFormat.VALUE_LOCAL)
+                    output.writeVarint(id)
+                }
+                is GlobalSymbol -> {
+                    output.writeByte(BinaryFormat.VALUE_SYMBOL)
+                    writeName(value.name())
+                }
+                is TrueBoolValue  -> output.writeByte(BinaryFormat.VALUE_TRUE)
+                is FalseBoolValue -> output.writeByte(BinaryFormat.VALUE_FALSE)
+                is NonTrivialConstant -> writeConstant(value)
+                else -> throw raiseError("unsupported value=$value")
+            }
+        }
+
+        private fun writeValues(values: List<Value>) {
+            output.writeVarint(values.size)
+            values.forEach { writeValue(it) }
+        }
+
+        private fun unary(opcode: Int, operand: Value) {
+            output.writeByte(opcode)
+            writeValue(operand)
+        }
+
+        private fun binary(opcode: Int, lhs: Value, rhs: Value) {
+            output.writeByte(opcode)
+            writeValue(lhs)
+            writeValue(rhs)
+        }
+
+        private fun cast(opcode: Int, operand: Value, type: Type) {
+            output.writeByte(opcode)
+            writeValue(operand)
+            writeType(type)
+        }
+
+        private fun directCall(opcode: Int, call: Callable, prototype: DirectFunctionPrototype) {
+            output.writeByte(opcode)
+            writeName(prototype.name)
+            writeValues(call.arguments())
+            writeAttributes(call.attributes())
+            writeBlock(call.target())
+        }
+
+        private fun indirectCall(opcode: Int, call: IndirectionCallable, prototype: IndirectFunctionPrototype) {
+            output.writeByte(opcode)
+            writeValue(call.pointer())
+            writePrototype(prototype)
+            writeValues(call.arguments())
+            writeAttributes(call.attributes())
+            writeBlock(call.target())
+        }
+
+        private fun unsupported(inst: Instruction): Nothing {
+            throw raiseError("unsupported instruction=${inst.dump()}")
+        }
+
+        override fun visit(alloc: Alloc) {
+            output.writeByte(BinaryFormat.OP_ALLOC)
+            writeType(alloc.allocatedType)
+        }
+
+        override fun visit(generate: Generate) = unsupported(generate)
+        override fun visit(lea: Lea) = unsupported(lea)
+        override fun visit(add: Add) = binary(BinaryFormat.OP_ADD, add.lhs(), add.rhs())
+        override fun visit(and: And) = binary(BinaryFormat.OP_AND, and.lhs(), and.rhs())
+        override fun visit(sub: Sub) = binary(BinaryFormat.OP_SUB, sub.lhs(), sub.rhs())
+        override fun visit(mul: Mul) = binary(BinaryFormat.OP_MUL, mul.lhs(), mul.rhs())
+        override fun visit(or: Or) = binary(BinaryFormat.OP_OR, or.lhs(), or.rhs())
+        override fun visit(xor: Xor) = binary(BinaryFormat.OP_XOR, xor.lhs(), xor.rhs())
+        override fun visit(fadd: Fxor) = unsupported(fadd)
+        override fun visit(shl: Shl) = binary(BinaryFormat.OP_SHL, shl.lhs(), shl.rhs())
+        override fun visit(shr: Shr) = binary(BinaryFormat.OP_SHR, shr.lhs(), shr.rhs())
+        override fun visit(div: Div) = binary(BinaryFormat.OP_DIV, div.lhs(), div.rhs())
+        override fun visit(neg: Neg) = unary(BinaryFormat.OP_NEG, neg.operand())
+        override fun visit(not: Not) = unary(BinaryFormat.OP_NOT, not.operand())
+
+        override fun visit(bitop: BitOp) {
+            output.writeByte(BinaryFormat.OP_BITOP)
+            output.writeVarint(bitop.op().ordinal)
+            writeValue(bitop.operand())
+        }
+
+        override fun visit(branch: Branch) {
+            output.writeByte(BinaryFormat.OP_BRANCH)
+            writeBlock(branch.target())
+        }
+
+        override fun visit(branchCond: BranchCond) {
+            output.writeByte(BinaryFormat.OP_BRANCH_COND)
+            writeValue(branchCond.condition())
+            writeBlock(branchCond.onTrue())
+            writeBlock(branchCond.onFalse())
+        }
+
+        override fun visit(call: Call) = directCall(BinaryFormat.OP_CALL, call, call.prototype())
+        override fun visit(tupleCall: TupleCall) = directCall(BinaryFormat.OP_TUPLE_CALL, tupleCall, tupleCall.prototype())
+        override fun visit(flag2Int: Flag2Int) = cast(BinaryFormat.OP_FLAG2INT, flag2Int.operand(), flag2Int.type())
+        override fun visit(bitcast: Bitcast) = cast(BinaryFormat.OP_BITCAST, bitcast.operand(), bitcast.type())
+        override fun visit(itofp: Int2Float) = cast(BinaryFormat.OP_INT2FP, itofp.operand(), itofp.type())
+        override fun visit(utofp: Unsigned2Float) = cast(BinaryFormat.OP_UINT2FP, utofp.operand(), utofp.type())
+        override fun visit(zext: ZeroExtend) = cast(BinaryFormat.OP_ZEXT, zext.operand(), zext.type())
+        override fun visit(sext: SignExtend) = cast(BinaryFormat.OP_SEXT, sext.operand(), sext.type())
+        override fun visit(trunc: Truncate) = cast(BinaryFormat.OP_TRUNC, trunc.operand(), trunc.type())
+        override fun visit(fptruncate: FpTruncate) = cast(BinaryFormat.OP_FPTRUNC, fptruncate.operand(), fptruncate.type())
+        override fun visit(fpext: FpExtend) = cast(BinaryFormat.OP_FPEXT, fpext.operand(), fpext.type())
+        override fun visit(fptosi: Float2Int) = cast(BinaryFormat.OP_FP2INT, fptosi.value(), fptosi.type())
+        override fun visit(copy: Copy) = unary(BinaryFormat.OP_COPY, copy.operand())
+        override fun visit(move: Move) = unsupported(move)
+        override fun visit(move: MoveByIndex) = unsupported(move)
+        override fun visit(downStackFrame: DownStackFrame) = unsupported(downStackFrame)
+
+        override fun visit(gep: GetElementPtr) {
+            output.writeByte(BinaryFormat.OP_GEP)
+            writeValue(gep.source())
+            writeType(gep.basicType)
+            writeValue(gep.index())
+        }
+
+        override fun visit(gfp: GetFieldPtr) {
+            output.writeByte(BinaryFormat.OP_GFP)
+            writeValue(gfp.source())
+            writeType(gfp.basicType)
+            writeValue(gfp.index())
+        }
+
+        override fun visit(icmp: IntCompare) {
+            output.writeByte(BinaryFormat.OP_ICMP)
+            output.writeVarint(icmp.predicate().ordinal)
+            writeValue(icmp.lhs())
+            writeValue(icmp.rhs())
+        }
+
+        override fun visit(fcmp: FloatCompare) {
+            output.writeByte(BinaryFormat.OP_FCMP)
+            output.writeVarint(fcmp.predicate().ordinal)
+            writeValue(fcmp.lhs())
+            writeValue(fcmp.rhs())
+        }
+
+        override fun visit(load: Load) = cast(BinaryFormat.OP_LOAD, load.operand(), load.type())
+
+        override fun visit(phi: Phi) {
+            output.writeByte(BinaryFormat.OP_PHI)
+            writeType(phi.type())
+            output.writeVarint(phi.incoming().size)
+            phi.zip { block, value ->
+                writeBlock(block)
+                writeValue(value)
+            }
+        }
+
+        override fun visit(returnValue: ReturnValue) {
+            output.writeByte(BinaryFormat.OP_RETURN_VALUE)
+            writeType(returnValue.type())
+            writeValues(returnValue.operands())
+        }
+
+        override fun visit(returnVoid: ReturnVoid) {
+            output.writeByte(BinaryFormat.OP_RETURN_VOID)
+        }
+
+        override fun visit(indirectionCall: IndirectionCall) {
+            indirectCall(BinaryFormat.OP_ICALL, indirectionCall, indirectionCall.prototype())
+        }
+
+        override fun visit(indirectionVoidCall: IndirectionVoidCall) {
+            indirectCall(BinaryFormat.OP_IVOID_CALL, indirectionVoidCall, indirectionVoidCall.prototype())
+        }
+
+        override fun visit(select: Select) {
+            output.writeByte(BinaryFormat.OP_SELECT)
+            writeType(select.type())
+            writeValue(select.condition())
+            writeValue(select.onTrue())
+            writeValue(select.onFalse())
+        }
+
+        override fun visit(store: Store) = binary(BinaryFormat.OP_STORE, store.pointer(), store.value())
+        override fun visit(upStackFrame: UpStackFrame) = unsupported(upStackFrame)
+        override fun visit(voidCall: VoidCall) = directCall(BinaryFormat.OP_VOID_CALL, voidCall, voidCall.prototype())
+        override fun visit(int2ptr: Int2Pointer) = unary(BinaryFormat.OP_INT2PTR, int2ptr.operand())
+        override fun visit(ptr2Int: Pointer2Int) = cast(BinaryFormat.OP_PTR2INT, ptr2Int.operand(), ptr2Int.type())
+
+        override fun visit(memcpy: Memcpy) {
+            output.writeByte(BinaryFormat.OP_MEMCPY)
+            writeValue(memcpy.destination())
+            writeValue(memcpy.source())
+            writeValue(memcpy.length())
+        }
+
+        override fun visit(memset: Memset) {
+            output.writeByte(BinaryFormat.OP_MEMSET)
+            writeValue(memset.destination())
+            writeValue(memset.value())
+            writeValue(memset.length())
+        }
+
+        override fun visit(indexedLoad: IndexedLoad) = unsupported(indexedLoad)
+        override fun visit(store: StoreOnStack) = unsupported(store)
+        override fun visit(loadst: LoadFromStack) = unsupported(loadst)
+        override fun visit(leaStack: LeaStack) = unsupported(leaStack)
+        override fun visit(tupleDiv: TupleDiv) = binary(BinaryFormat.OP_TUPLE_DIV, tupleDiv.lhs(), tupleDiv.rhs())
+
+        override fun visit(proj: Projection) {
+            output.writeByte(BinaryFormat.OP_PROJ)
+            writeValue(proj.tuple())
+            output.writeVarint(proj.index())
+        }
+
+        override fun visit(switch: Switch) {
+            output.writeByte(BinaryFormat.OP_SWITCH)
+            writeValue(switch.value())
+            writeBlock(switch.default())
+            val table = switch.table()
+            output.writeVarint(table.size)
+            table.forEach { writeValue(it) }
+            switch.jumps().forEach { writeBlock(it) }
+        }
+
+        override fun visit(tupleCall: IndirectionTupleCall) {
+            indirectCall(BinaryFormat.OP_ITUPLE_CALL, tupleCall, tupleCall.prototype())
+        }
+
+        override fun visit(intrinsic: Intrinsic) {
+            val implementor = intrinsic.implementor
+            output.writeByte(BinaryFormat.OP_INTRINSIC)
+            writeName(implementor.name)
+            val parameters = implementor.parameters()
+            output.writeVarint(parameters.size)
+            parameters.forEach { output.writeSignedVarLong(it.toLong()) }
+            writeValues(intrinsic.inputs())
+            writeBlock(intrinsic.target())
+        }
+    }
+
+    companion object {
+        fun write(module: SSAModule): ByteArray {
+            return ModuleBinaryWriter(module).write()
+        }
+
+        fun write(module: SSAModule, filename: String) {
+            writeBinaryFile(filename, write(module))
+        }
+    }
+}
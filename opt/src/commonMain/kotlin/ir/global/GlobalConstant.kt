@@ -1,5 +1,7 @@
 package ir.global
 
+import ir.types.ArrayType
+import ir.types.StructType
 import ir.value.constant.*
 
 
@@ -21,4 +23,29 @@ sealed class GlobalConstant(protected open val name: String): GlobalSymbol {
     }
 
     abstract fun constant(): NonTrivialConstant
+
+    companion object {
+        /**
+         * Creates the global constant holding [constant], returns null if such a constant cannot be global.
+         */
+        fun of(name: String, constant: NonTrivialConstant): GlobalConstant? = when (constant) {
+            is I8Value  -> I8ConstantValue(name, constant.i8)
+            is U8Value  -> U8ConstantValue(name, constant.u8)
+            is I16Value -> I16ConstantValue(name, constant.i16)
+            is U16Value -> U16ConstantValue(name, constant.u16)
+            is I32Value -> I32ConstantValue(name, constant.i32)
+            is U32Value -> U32ConstantValue(name, constant.u32)
+            is I64Value -> I64ConstantValue(name, constant.i64)
+            is U64Value -> U64ConstantValue(name, constant.u64)
+            is F32Value -> F32ConstantValue(name, constant.f32)
+            is F64Value -> F64ConstantValue(name, constant.f64)
+            is StringLiteralConstant -> StringLiteralGlobalConstant(name, constant.type(), constant.content)
+            is InitializerListValue  -> when (constant.type()) {
+                is ArrayType  -> ArrayGlobalConstant(name, constant)
+                is StructType -> StructGlobalConstant(name, constant)
+                else -> null
+            }
+            else -> null
+        }
+    }
 }
\ No newline at end of file
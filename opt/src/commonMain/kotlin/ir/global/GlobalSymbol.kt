@@ -1,6 +1,6 @@
 package ir.global
 
-import ir.instruction.Instruction
+import ir.value.UseList
 import ir.value.Value
 import ir.types.NonTrivialType
 import ir.value.UsableValue
@@ -15,5 +15,5 @@ sealed interface GlobalSymbol: Value {
 interface FunctionSymbol: GlobalSymbol
 
 sealed class AnyGlobalValue: GlobalSymbol, UsableValue {
-    final override var usedIn: MutableList<Instruction> = mutableListOf()
+    final override val uses: UseList = UseList()
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+package ir.instruction
+
+import ir.types.*
+import ir.value.Value
+import ir.module.block.Block
+import ir.instruction.utils.IRInstructionVisitor
+import ir.Definitions.HWORD_SIZE
+import ir.Definitions.QWORD_SIZE
+import ir.Definitions.WORD_SIZE
+
+
+enum class BitOpType {
+    Popcount {
+        override fun toString(): String = "popcount"
+    },
+    CountTrailingZeros {
+        override fun toString(): String = "ctz"
+    },
+    CountLeadingZeros {
+        override fun toString(): String = "clz"
+    },
+    ByteSwap {
+        override fun toString(): String = "bswap"
+    };
+}
+
+/**
+ * Integer bit manipulation: population count, count of trailing/leading zero bits and byte swap.
+ * Count of trailing/leading zero bits is undefined for zero operand.
+ */
+class BitOp private constructor(id: Identity, owner: Block, tp: IntegerType, private val op: BitOpType, value: Value):
+    Unary(id, owner, tp, value) {
+    override fun dump(): String {
+        return "%${name()} = $NAME $op $tp ${operand()}"
+    }
+
+    override fun type(): IntegerType = tp.asType()
+
+    fun op(): BitOpType = op
+
+    override fun<T> accept(visitor: IRInstructionVisitor<T>): T {
+        return visitor.visit(this)
+    }
+
+    companion object {
+        const val NAME = "bitop"
+
+        fun bitop(op: BitOpType, value: Value): InstBuilder<BitOp> = { id: Identity, owner: Block ->
+            make(id, owner, op, value)
+        }
+
+        private fun make(id: Identity, owner: Block, op: BitOpType, value: Value): BitOp {
+            val valueType = value.type()
+            require(isAppropriateType(op, valueType)) {
+                "should be 32 or 64 bit integer type in '$id', but value=$value:$valueType, op=$op"
+            }
+
+            return registerUser(BitOp(id, owner, valueType.asType(), op, value))
+        }
+
+        private fun isAppropriateType(op: BitOpType, valueType: Type): Boolean {
+            if (valueType !is IntegerType) {
+                return false
+            }
+
+            return when (valueType.sizeOf()) {
+                WORD_SIZE, QWORD_SIZE -> true
+                HWORD_SIZE -> op == BitOpType.ByteSwap
+                else -> false
+            }
+        }
+
+        fun typeCheck(bitop: BitOp): Boolean {
+            return isAppropriateType(bitop.op(), bitop.operand().type())
+        }
+    }
+}
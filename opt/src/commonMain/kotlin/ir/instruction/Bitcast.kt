@@ -31,7 +31,7 @@ class Bitcast private constructor(id: Identity, owner: Block, toType: IntegerTyp
                 "inconsistent types in '$id': ty=$toType, value=$value:$valueType"
             }
 
-            return registerUser(Bitcast(id, owner, toType, value), value)
+            return registerUser(Bitcast(id, owner, toType, value))
         }
 
         private fun isAppropriateType(toType: Type, valueType: Type): Boolean {
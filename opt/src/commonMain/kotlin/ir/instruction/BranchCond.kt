@@ -52,7 +52,7 @@ class BranchCond private constructor(id: Identity, owner: Block, value: Value, o
                 "should be boolean type, but value=$value:$valueType"
             }
 
-            return registerUser(BranchCond(id, owner, value, onTrue, onFalse), value)
+            return registerUser(BranchCond(id, owner, value, onTrue, onFalse))
         }
 
         private fun isAppropriateType(valueType: Type): Boolean {
@@ -59,8 +59,8 @@ class Call private constructor(id: Identity, owner: Block, private val func: Dir
         if (tp !is TupleType) {
             throw IllegalStateException("type must be TupleType, but $tp found")
         }
-        for (user in usedIn()) {
-            user as Projection
+        uses.forEach { use ->
+            val user = use.user as Projection
             if (user.index() == index) {
                 return user
             }
@@ -83,7 +83,7 @@ class Call private constructor(id: Identity, owner: Block, private val func: Dir
                     { "$it: ${it.type()}" }
             }
 
-            return registerUser(Call(id, owner, func, attributes, args.toTypedArray(), target), args.iterator())
+            return registerUser(Call(id, owner, func, attributes, args.toTypedArray(), target))
         }
     }
 }
\ No newline at end of file
@@ -15,6 +15,12 @@ sealed interface Callable {
     fun shortName(): String = prototype().shortDescription()
     fun target(): Block
 
+    /**
+     * Returns true if the call doesn't have an edge to a continuation block
+     * and is placed in the middle of a block as an ordinary instruction.
+     */
+    fun isInBlock(): Boolean = this is TerminateInstruction && targets().isEmpty()
+
     fun attributes(): Set<FunctionAttribute>
 
     fun printArguments(builder: StringBuilder) {
@@ -34,7 +40,10 @@ sealed interface Callable {
                 builder.append(", ")
             }
         }
-        builder.append(") bt label %${target()}")
+        builder.append(")")
+        if (!isInBlock()) {
+            builder.append(" bt label %${target()}")
+        }
         attributes().forEach { builder.append(" $it") }
     }
 
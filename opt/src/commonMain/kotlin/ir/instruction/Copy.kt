@@ -39,7 +39,7 @@ class Copy private constructor(id: Identity, owner: Block, private val type: Pri
                 "should not be $originType, but origin=$origin:$originType"
             }
 
-            return registerUser(Copy(id, owner, originType.asType(), origin), origin)
+            return registerUser(Copy(id, owner, originType.asType(), origin))
         }
 
         fun typeCheck(copy: Copy): Boolean {
@@ -31,7 +31,7 @@ class Div private constructor(id: Identity, owner: Block, tp: FloatingPointType,
                 "incorrect types in '$id' a=$a:$aType, b=$b:$bType"
             }
 
-            return registerUser(Div(id, owner, aType.asType(), a, b), a, b)
+            return registerUser(Div(id, owner, aType.asType(), a, b))
         }
 
         private fun isAppropriateTypes(tp: Type, aType: Type, bType: Type): Boolean {
@@ -30,7 +30,7 @@ class Flag2Int private constructor(id: Identity, owner: Block, toType: IntegerTy
                 "inconsistent types in '$id': type=${value.type()}"
             }
 
-            return registerUser(Flag2Int(id, owner, toType, value), value)
+            return registerUser(Flag2Int(id, owner, toType, value))
         }
 
         fun isAppropriateType(valueType: Type): Boolean {
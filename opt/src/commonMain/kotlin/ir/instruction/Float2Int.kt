@@ -40,7 +40,7 @@ class Float2Int private constructor(id: Identity, owner: Block, toType: IntegerT
                 "inconsistent types in '$id': ty=$toType, value=$value:$valueType"
             }
 
-            return registerUser(Float2Int(id, owner, toType, value), value)
+            return registerUser(Float2Int(id, owner, toType, value))
         }
 
         private fun isAppropriateType(valueType: Type): Boolean {
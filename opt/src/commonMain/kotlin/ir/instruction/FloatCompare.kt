@@ -95,7 +95,7 @@ class FloatCompare private constructor(id: Identity, owner: Block, operandsType:
                 "should be the same types, but a=$a:$aType, b=$b:$bType"
             }
 
-            return registerUser(FloatCompare(id, owner, aType.asType(), a, predicate, b), a, b)
+            return registerUser(FloatCompare(id, owner, aType.asType(), a, predicate, b))
         }
 
         private fun isAppropriateType(aType: Type, bType: Type): Boolean {
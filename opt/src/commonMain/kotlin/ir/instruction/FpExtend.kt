@@ -31,7 +31,7 @@ class FpExtend private constructor(id: Identity, owner: Block, toType: FloatingP
                 "inconsistent types in '$id': ty=$toType, value=$value:$valueType"
             }
 
-            return registerUser(FpExtend(id, owner, toType, value), value)
+            return registerUser(FpExtend(id, owner, toType, value))
         }
 
         private fun isAppropriateType(toType: FloatingPointType, valueType: Type): Boolean {
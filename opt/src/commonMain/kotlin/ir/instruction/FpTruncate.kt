@@ -31,7 +31,7 @@ class FpTruncate private constructor(id: Identity, owner: Block, toType: Floatin
                 "inconsistent types in '$id': ty=$toType, value=$value:$valueType"
             }
 
-            return registerUser(FpTruncate(id, owner, toType, value), value)
+            return registerUser(FpTruncate(id, owner, toType, value))
         }
 
         private fun isAppropriateType(toType: FloatingPointType, valueType: Type): Boolean {
@@ -49,7 +49,7 @@ class GetElementPtr private constructor(id: Identity, owner: Block, val basicTyp
                 "inconsistent types in '$id' type=$elementType source=$source:$sourceType, index=$index:$indexType"
             }
 
-            return registerUser(GetElementPtr(id, owner, elementType, source, index), source, index)
+            return registerUser(GetElementPtr(id, owner, elementType, source, index))
         }
 
         private fun isAppropriateType(sourceType: Type, indexType: Type): Boolean {
@@ -38,7 +38,7 @@ class GetFieldPtr private constructor(id: Identity, owner: Block, val basicType:
                 "inconsistent types in '$id' type=$type, source=$source:$sourceType, index=$index:$indexType"
             }
 
-            return registerUser(GetFieldPtr(id, owner, type, source, index), source)
+            return registerUser(GetFieldPtr(id, owner, type, source, index))
         }
 
         private fun isAppropriateType(sourceType: Type, basicType: AggregateType, index: IntegerConstant): Boolean {
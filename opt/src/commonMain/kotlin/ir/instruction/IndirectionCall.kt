@@ -84,7 +84,7 @@ class IndirectionCall private constructor(id: Identity, owner: Block,
             }
 
             val operands = args.toTypedArray(pointer)
-            return registerUser(IndirectionCall(id, owner, func, attributes, operands, target), *operands)
+            return registerUser(IndirectionCall(id, owner, func, attributes, operands, target))
         }
     }
 }
\ No newline at end of file
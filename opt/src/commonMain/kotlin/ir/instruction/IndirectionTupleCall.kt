@@ -82,7 +82,7 @@ class IndirectionTupleCall private constructor(
             }
 
             val operands = args.toTypedArray(pointer)
-            return registerUser(IndirectionTupleCall(id, owner, func, attributes, operands, target), *operands)
+            return registerUser(IndirectionTupleCall(id, owner, func, attributes, operands, target))
         }
     }
 }
\ No newline at end of file
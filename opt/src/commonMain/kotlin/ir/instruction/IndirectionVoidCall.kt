@@ -82,7 +82,7 @@ class IndirectionVoidCall private constructor(id: Identity,
             }
 
             val operands = args.toTypedArray(pointer)
-            return registerUser(IndirectionVoidCall(id, owner, func, attributes, operands, block), operands.iterator())
+            return registerUser(IndirectionVoidCall(id, owner, func, attributes, operands, block))
         }
     }
 }
\ No newline at end of file
@@ -7,13 +7,20 @@ import common.assertion
 import ir.instruction.utils.IRInstructionVisitor
 import ir.module.block.Block
 import ir.value.UsableValue
+import ir.value.Use
 import ir.value.constant.UndefValue
 
 
 typealias Identity = Int
 typealias InstBuilder<T> = (Identity, Block) -> T
 
-abstract class Instruction(protected val id: Identity, protected val owner: Block, protected val operands: Array<Value>): LListNode() {
+abstract class Instruction(id: Identity, owner: Block, protected val operands: Array<Value>): LListNode() {
+    protected var id: Identity = id
+        private set
+    protected var owner: Block = owner
+        private set
+    private val operandUses = arrayOfNulls<Use>(operands.size)
+
     final override fun next(): Instruction? = next as Instruction?
     final override fun prev(): Instruction? = prev as Instruction?
 
@@ -36,6 +43,12 @@ abstract class Instruction(protected val id: Identity, protected val owner: Bloc
 
     fun isNoOperands(): Boolean = operands.isEmpty()
 
+    /** Moves the instruction to [newOwner]. Must be called only when the instruction is linked into [newOwner]. */
+    internal fun relocate(newOwner: Block, newId: Identity) {
+        owner = newOwner
+        id    = newId
+    }
+
     fun update(closure: (Value) -> Value) = owner.df {
         for ((i, v) in operands.withIndex()) {
             update(i, closure(v))
@@ -47,21 +60,34 @@ abstract class Instruction(protected val id: Identity, protected val owner: Bloc
             "out of range in $this"
         }
 
+        unlinkUse(index)
+        operands[index] = new
+        linkUse(index)
+    }
+
+    private fun linkUse(index: Int) {
         val op = operands[index]
-        if (op is UsableValue) {
-            op.killUser(this)
+        if (op !is UsableValue) {
+            return
         }
 
-        operands[index] = new
+        val use = operandUses[index] ?: Use(this, index).also { operandUses[index] = it }
+        op.uses.add(use)
+    }
 
-        if (new is UsableValue) {
-            new.addUser(this)
+    private fun unlinkUse(index: Int) {
+        val op = operands[index]
+        if (op !is UsableValue) {
+            return
         }
+
+        val use = operandUses[index] ?: return
+        op.uses.remove(use)
     }
 
     private fun destroy() {
         if (this is UsableValue) {
-            assertion(usedIn().isEmpty()) {
+            assertion(uses.isEmpty()) {
                 "removed useful instruction: removed=$this, users=${usedIn()}"
             }
         }
@@ -73,11 +99,7 @@ abstract class Instruction(protected val id: Identity, protected val owner: Bloc
         }
 
         for (idx in operands.indices) {
-            val op = operands[idx]
-            if (op is UsableValue) {
-                op.killUser(this)
-            }
-
+            unlinkUse(idx)
             operands[idx] = UndefValue
         }
     }
@@ -111,17 +133,10 @@ abstract class Instruction(protected val id: Identity, protected val owner: Bloc
     abstract fun dump(): String
 
     companion object {
-        internal fun<T: Instruction> registerUser(user: T, vararg operands: Value): T {
-            return registerUser(user, operands.iterator())
-        }
-
-        internal fun<T: Instruction> registerUser(user: T, operands: Iterator<Value>): T {
-            for (i in operands) {
-                if (i !is UsableValue) {
-                    continue
-                }
-
-                i.addUser(user)
+        /** Links every operand slot of the new instruction into the use list of its value. */
+        internal fun<T: Instruction> registerUser(user: T): T {
+            for (idx in user.operands.indices) {
+                user.linkUse(idx)
             }
 
             return user
@@ -35,7 +35,7 @@ class Int2Float private constructor(id: Identity, owner: Block, toType: Floating
                 "inconsistent types in '$id': ty=$toType, value=$value:$valueType"
             }
 
-            return registerUser(Int2Float(id, owner, toType, value), value)
+            return registerUser(Int2Float(id, owner, toType, value))
         }
 
         private fun isAppropriateType(valueType: Type): Boolean {
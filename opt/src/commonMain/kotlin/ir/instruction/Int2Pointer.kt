@@ -31,7 +31,7 @@ class Int2Pointer private constructor(id: Identity, owner: Block, value: Value):
                 "inconsistent types in '$id': ty=$PtrType, value=$value:$valueType"
             }
 
-            return registerUser(Int2Pointer(id, owner, value), value)
+            return registerUser(Int2Pointer(id, owner, value))
         }
 
         private fun isAppropriateType(valueType: Type): Boolean {
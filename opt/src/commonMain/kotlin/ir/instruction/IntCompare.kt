@@ -61,7 +61,7 @@ class IntCompare private constructor(id: Identity, owner: Block, operandsType: P
                 "should be the same integer or pointer types in '$id', but a=$a:$aType, b=$b:$bType"
             }
 
-            return registerUser(IntCompare(id, owner, aType.asType(), a, predicate, b), a, b)
+            return registerUser(IntCompare(id, owner, aType.asType(), a, predicate, b))
         }
 
         private fun isAppropriateType(aType: Type, bType: Type): Boolean {
@@ -45,7 +45,7 @@ class Intrinsic private constructor(id: Identity, owner: Block, private val inpu
         }
 
         private fun make(id: Identity, owner: Block, inputs: Array<Value>, implementor: IntrinsicProvider, cont: Block): Intrinsic {
-            return registerUser(Intrinsic(id, owner, inputs, implementor, cont), *inputs)
+            return registerUser(Intrinsic(id, owner, inputs, implementor, cont))
         }
 
         fun typeCheck(intrinsic: Intrinsic): Boolean {
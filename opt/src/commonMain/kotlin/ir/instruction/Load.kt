@@ -31,7 +31,7 @@ class Load private constructor(id: Identity, owner: Block, loadedType: Primitive
                 "inconsistent types in '$id' type=${loadedType}, but operand=${operand}:$type"
             }
 
-            return registerUser(Load(id, owner, loadedType, operand), operand)
+            return registerUser(Load(id, owner, loadedType, operand))
         }
 
         private fun isAppropriateTypes(tp: Type): Boolean {
@@ -66,7 +66,7 @@ class Memcpy private constructor(id: Identity, owner: Block, dst: Value, src: Va
                 "inconsistent types: dst=$dst:${dst.type()}, src=$src:${src.type()}"
             }
 
-            return registerUser(Memcpy(id, owner, dst, src, length), dst, src)
+            return registerUser(Memcpy(id, owner, dst, src, length))
         }
 
         private fun isAppropriateTypes(dstType: Type, srcType: Type, length: UnsignedIntegerConstant): Boolean {
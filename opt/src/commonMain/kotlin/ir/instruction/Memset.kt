@@ -0,0 +1,76 @@
+package ir.instruction
+
+import common.assertion
+import ir.value.Value
+import ir.value.constant.U8Value
+import ir.value.constant.UnsignedIntegerConstant
+import ir.instruction.utils.IRInstructionVisitor
+import ir.module.block.Block
+
+
+class Memset private constructor(id: Identity, owner: Block, dst: Value, value: U8Value, length: UnsignedIntegerConstant):
+    Instruction(id, owner, arrayOf(dst, value, length)) {
+    override fun <T> accept(visitor: IRInstructionVisitor<T>): T {
+        return visitor.visit(this)
+    }
+
+    override fun dump(): String {
+        return "$NAME ${destination().type()} ${destination()}, ${value().type()} ${value()}, ${length().type()} ${length()}"
+    }
+
+    fun destination(): Value {
+        assertion(operands.size == 3) {
+            "size should be 3 in $this instruction"
+        }
+
+        return operands[DESTINATION]
+    }
+
+    fun destination(newValue: Value) {
+        update(DESTINATION, newValue)
+    }
+
+    fun value(): U8Value {
+        assertion(operands.size == 3) {
+            "size should be 3 in $this instruction"
+        }
+
+        return operands[VALUE] as U8Value
+    }
+
+    fun length(): UnsignedIntegerConstant {
+        assertion(operands.size == 3) {
+            "size should be 3 in $this instruction"
+        }
+
+        return operands[LENGTH] as UnsignedIntegerConstant
+    }
+
+    companion object {
+        const val NAME = "memset"
+        private const val DESTINATION = 0
+        private const val VALUE = 1
+        private const val LENGTH = 2
+
+        fun memset(dst: Value, value: U8Value, length: UnsignedIntegerConstant): InstBuilder<Memset> = {
+            id: Identity, owner: Block -> make(id, owner, dst, value, length)
+        }
+
+        private fun make(id: Identity, owner: Block, dst: Value, value: U8Value, length: UnsignedIntegerConstant): Memset {
+            require(isAppropriateTypes(length)) {
+                "inconsistent types: dst=$dst:${dst.type()}, length=$length"
+            }
+
+            return registerUser(Memset(id, owner, dst, value, length))
+        }
+
+        private fun isAppropriateTypes(length: UnsignedIntegerConstant): Boolean {
+            // Destination is either pointer or stack/global aggregate, which is addressed after lowering
+            return length.value() != 0L
+        }
+
+        fun typeCheck(memset: Memset): Boolean {
+            return isAppropriateTypes(memset.length())
+        }
+    }
+}
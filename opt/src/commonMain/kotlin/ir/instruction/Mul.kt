@@ -29,7 +29,7 @@ class Mul private constructor(id: Identity, owner: Block, tp: ArithmeticType, a:
                 "incorrect types in '$id' but type=$aType, a=$a:$aType, b=$b:$bType"
             }
 
-            return registerUser(Mul(id, owner, aType as ArithmeticType, a, b), a, b)
+            return registerUser(Mul(id, owner, aType as ArithmeticType, a, b))
         }
 
         private fun isAppropriateTypes(tp: Type, aType: Type, bType: Type): Boolean {
@@ -28,7 +28,7 @@ class Neg private constructor(id: Identity, owner: Block, tp: ArithmeticType, va
         }
 
         private fun make(id: Identity, owner: Block, value: Value): Neg {
-            return registerUser(Neg(id, owner, value.asType(), value), value)
+            return registerUser(Neg(id, owner, value.asType(), value))
         }
 
         fun typeCheck(unary: Neg): Boolean {
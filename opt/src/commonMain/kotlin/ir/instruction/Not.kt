@@ -28,7 +28,7 @@ class Not private constructor(id: Identity, owner: Block, tp: IntegerType, value
 
         private fun make(id: Identity, owner: Block, value: Value): Not {
             val valueType = value.type()
-            return registerUser(Not(id, owner, valueType.asType(), value), value)
+            return registerUser(Not(id, owner, valueType.asType(), value))
         }
 
         fun typeCheck(unary: Not): Boolean {
@@ -30,7 +30,7 @@ class Or private constructor(id: Identity, owner: Block, tp: IntegerType, a: Val
                 "incorrect types in '$id' a=$a:$aType, b=$b:$bType"
             }
 
-            return registerUser(Or(id, owner, aType as IntegerType, a, b), a, b)
+            return registerUser(Or(id, owner, aType as IntegerType, a, b))
         }
 
         private fun isAppropriateTypes(tp: Type, aType: Type, bType: Type): Boolean {
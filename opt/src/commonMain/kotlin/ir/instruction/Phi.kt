@@ -79,7 +79,7 @@ class Phi private constructor(id: Identity, owner: Block, private val ty: Primit
         }
 
         private fun make(id: Identity, owner: Block, ty: PrimitiveType, incoming: Array<Block>, incomingValue: Array<Value>): Phi {
-            return registerUser(Phi(id, owner, ty, incoming, incomingValue), incomingValue.iterator())
+            return registerUser(Phi(id, owner, ty, incoming, incomingValue))
         }
 
         private fun isAppropriateTypes(type: PrimitiveType, incomingValue: Array<Value>): Boolean {
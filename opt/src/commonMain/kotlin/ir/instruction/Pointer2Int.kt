@@ -31,7 +31,7 @@ class Pointer2Int private constructor(id: Identity, owner: Block, toType: Intege
                 "inconsistent types in '$id': ty=$toType, value=$value:$valueType"
             }
 
-            return registerUser(Pointer2Int(id, owner, toType, value), value)
+            return registerUser(Pointer2Int(id, owner, toType, value))
         }
 
         private fun isAppropriateType(valueType: Type): Boolean {
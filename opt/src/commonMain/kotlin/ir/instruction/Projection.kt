@@ -41,7 +41,7 @@ class Projection private constructor(id: Identity, owner: Block, private val typ
         private fun make(id: Identity, owner: Block, tuple: Value, index: Int): Projection {
             val tupleType = tuple.asType<TupleType>()
             val retType = tupleType.innerType(index)
-            return registerUser(Projection(id, owner, retType, tuple, index), tuple) // TODO
+            return registerUser(Projection(id, owner, retType, tuple, index)) // TODO
         }
 
         fun typeCheck(proj: Projection): Boolean {
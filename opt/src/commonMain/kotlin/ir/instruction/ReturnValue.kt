@@ -46,7 +46,7 @@ class ReturnValue private constructor(id: Identity, owner: Block, val returnType
                 "cannot be $returnType, but values=${values.joinToString { it.toString() }}"
             }
 
-            return registerUser(ReturnValue(id, owner, returnType, values), values.iterator())
+            return registerUser(ReturnValue(id, owner, returnType, values))
         }
 
         private fun isAppropriateType(retType: Type, values: Array<Value>): Boolean {
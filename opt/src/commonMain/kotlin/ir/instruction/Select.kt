@@ -66,7 +66,7 @@ class Select private constructor(id: Identity, owner: Block, private val ty: Int
                 "inconsistent types: type=$ty, condition=$cond:$condType, onTrue=$onTrue:$onTrueType, onFalse=$onFalse:$onFalseType"
             }
 
-            return registerUser(Select(id, owner, ty, cond, onTrue, onFalse), cond, onTrue, onFalse)
+            return registerUser(Select(id, owner, ty, cond, onTrue, onFalse))
         }
 
         private fun isAppropriateType(ty: IntegerType, condType: Type, onTrueType: Type, onFalseType: Type): Boolean {
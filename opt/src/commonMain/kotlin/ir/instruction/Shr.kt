@@ -31,7 +31,7 @@ class Shr private constructor(id: Identity, owner: Block, tp: IntegerType, a: Va
                 "incorrect types in '$id' but type=$aType, a=$a:$aType, b=$b:$bType"
             }
 
-            return registerUser(Shr(id, owner, aType.asType(), a, b), a, b)
+            return registerUser(Shr(id, owner, aType.asType(), a, b))
         }
 
         private fun isAppropriateTypes(tp: Type, aType: Type, bType: Type): Boolean {
@@ -32,7 +32,7 @@ class SignExtend private constructor(id: Identity, owner: Block, toType: SignedI
                 "inconsistent types in '$id' type=$toType, value=$value:$valueType"
             }
 
-            return registerUser(SignExtend(id, owner, toType, value), value)
+            return registerUser(SignExtend(id, owner, toType, value))
         }
 
         private fun isAppropriateType(toType: SignedIntType, valueType: Type): Boolean {
@@ -60,7 +60,7 @@ class Store private constructor(id: Identity, owner: Block, pointer: Value, valu
                 "inconsistent types: pointer=$pointer:$pointerType, value=$value:$valueType"
             }
 
-            return registerUser(Store(id, owner, pointer, value, value.asType()), pointer, value)
+            return registerUser(Store(id, owner, pointer, value, value.asType()))
         }
 
         private fun isAppropriateTypes(pointerType: Type, valueType: Type): Boolean {
@@ -29,7 +29,7 @@ class Sub private constructor(id: Identity, owner: Block, tp: ArithmeticType, a:
                 "incorrect types in '$id' a=$a:$aType, b=$b:$bType"
             }
 
-            return registerUser(Sub(id, owner, aType as ArithmeticType, a, b), a, b)
+            return registerUser(Sub(id, owner, aType as ArithmeticType, a, b))
         }
 
         private fun isAppropriateTypes(tp: Type, aType: Type, bType: Type): Boolean {
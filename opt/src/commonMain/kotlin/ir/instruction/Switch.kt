@@ -67,7 +67,7 @@ class Switch private constructor(id: Identity, owner: Block,
                 "inconsistent types in '$id': value='${value}:${value.type()}', table='${table.joinToString { it.type().toString() }}'"
             }
 
-            return registerUser(Switch(id, owner, value, default, table, targets), value)
+            return registerUser(Switch(id, owner, value, default, table, targets))
         }
 
         private fun isAppropriateType(value: Value): Boolean {
@@ -4,8 +4,11 @@ import ir.value.Value
 import ir.module.block.Block
 
 
-sealed class TerminateInstruction(id: Identity, owner: Block, usages: Array<Value>, val targets: Array<Block>):
+sealed class TerminateInstruction(id: Identity, owner: Block, usages: Array<Value>, targets: Array<Block>):
     Instruction(id, owner, usages) {
+    var targets: Array<Block> = targets
+        private set
+
     fun targets(): Array<Block> = targets
 
     fun target(newBB: Block, old: Block) = owner.cf {
@@ -17,4 +20,16 @@ sealed class TerminateInstruction(id: Identity, owner: Block, usages: Array<Valu
 
         owner.updatePhi(old, newBB)
     }
-}
\ No newline at end of file
+
+    /**
+     * Drops all control flow edges of the instruction.
+     * Only calls may lose their continuation, see [Callable.isInBlock].
+     */
+    internal fun detachTargets() = owner.cf {
+        for (target in targets) {
+            owner.removeEdge(target)
+        }
+
+        targets = arrayOf()
+    }
+}
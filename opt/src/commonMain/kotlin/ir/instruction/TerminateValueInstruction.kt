@@ -13,7 +13,7 @@ sealed class TerminateValueInstruction(
 ) :
     TerminateInstruction(id, owner, usages, targets),
     LocalValue {
-    override var usedIn: MutableList<Instruction> = arrayListOf()
+    final override val uses: UseList = UseList()
 
     final override fun name(): String {
         return "${owner().index}x${id}"
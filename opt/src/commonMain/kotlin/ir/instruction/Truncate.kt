@@ -30,7 +30,7 @@ class Truncate private constructor(id: Identity, owner: Block, toType: IntegerTy
                 "inconsistent types in '$id' type=$toType, value=$value:$valueType"
             }
 
-            return registerUser(Truncate(id, owner, toType, value), value)
+            return registerUser(Truncate(id, owner, toType, value))
         }
 
         private fun isAppropriateType(toType: IntegerType, valueType: Type): Boolean {
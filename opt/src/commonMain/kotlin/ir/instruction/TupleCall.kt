@@ -71,7 +71,7 @@ class TupleCall private constructor(id: Identity,
                 { "$it: ${it.type()}" }
             }
             val argsArray = args.toTypedArray()
-            return registerUser(TupleCall(id, owner, func, attributes, argsArray, target), args.iterator())
+            return registerUser(TupleCall(id, owner, func, attributes, argsArray, target))
         }
     }
 }
\ No newline at end of file
@@ -68,7 +68,7 @@ class TupleDiv private constructor(id: Identity, owner: Block, private val tp: T
                 "incorrect types in '$id' but a=$a:$aType, b=$b:$bType"
             }
 
-            return registerUser(TupleDiv(id, owner, tp, a, b), a, b)
+            return registerUser(TupleDiv(id, owner, tp, a, b))
         }
 
         private fun isAppropriateTypes(tp: TupleType, aType: Type, bType: Type): Boolean {
@@ -37,7 +37,7 @@ class Unsigned2Float private constructor(id: Identity, owner: Block, toType: Flo
                 "inconsistent types in '$id': ty=$toType, value=$value:$valueType"
             }
 
-            return registerUser(Unsigned2Float(id, owner, toType, value), value)
+            return registerUser(Unsigned2Float(id, owner, toType, value))
         }
 
         private fun isAppropriateType(valueType: Type): Boolean {
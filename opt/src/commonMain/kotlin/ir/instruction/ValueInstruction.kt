@@ -7,7 +7,7 @@ import ir.module.block.Block
 abstract class ValueInstruction(id: Identity, owner: Block, operands: Array<Value>):
     Instruction(id, owner, operands),
     LocalValue {
-    override var usedIn: MutableList<Instruction> = arrayListOf()
+    final override val uses: UseList = UseList()
 
     final override fun name(): String {
         return "${owner().index}x${id}"
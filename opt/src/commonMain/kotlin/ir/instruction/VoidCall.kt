@@ -63,7 +63,7 @@ class VoidCall private constructor(id: Identity,
                 { "$it: ${it.type()}" }
             }
             val argsArray = args.toTypedArray()
-            return registerUser(VoidCall(id, owner, func, attributes, argsArray, target), args.iterator())
+            return registerUser(VoidCall(id, owner, func, attributes, argsArray, target))
         }
     }
 }
\ No newline at end of file
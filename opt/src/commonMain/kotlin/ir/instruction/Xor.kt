@@ -31,7 +31,7 @@ class Xor private constructor(id: Identity, owner: Block, tp: IntegerType, a: Va
                 "incorrect types in '$id' a=$a:$aType, b=$b:$bType"
             }
 
-            return registerUser(Xor(id, owner, aType.asType(), a, b), a, b)
+            return registerUser(Xor(id, owner, aType.asType(), a, b))
         }
 
         private fun isAppropriateTypes(tp: Type, aType: Type, bType: Type): Boolean {
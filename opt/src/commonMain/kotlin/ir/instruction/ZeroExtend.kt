@@ -31,7 +31,7 @@ class ZeroExtend private constructor(id: Identity, owner: Block, toType: Unsigne
                 "inconsistent types in '$id': type=$toType, value=$value:$valueType"
             }
 
-            return registerUser(ZeroExtend(id, owner, toType, value), value)
+            return registerUser(ZeroExtend(id, owner, toType, value))
         }
 
         private fun isAppropriateType(toType: UnsignedIntType, valueType: Type): Boolean {
@@ -32,7 +32,7 @@ class Fxor private constructor(id: Identity, owner: Block, tp: ArithmeticType, a
                 "incorrect types in '$id' a=$a:$aType, b=$b:$bType"
             }
 
-            return registerUser(Fxor(id, owner, aType.asType(), a, b), a, b)
+            return registerUser(Fxor(id, owner, aType.asType(), a, b))
         }
 
         private fun isAppropriateTypes(tp: Type, aType: Type, bType: Type): Boolean {
@@ -57,7 +57,7 @@ class Lea private constructor(id: Identity, owner: Block, value: Value):
                 "should be '$NAME' or global constant, but '$value'"
             }
 
-            return registerUser(Lea(id, owner, value), value)
+            return registerUser(Lea(id, owner, value))
         }
 
         fun typeCheck(lea: Lea): Boolean {
@@ -52,7 +52,7 @@ class Move private constructor(id: Identity, owner: Block, destination: Value, s
                 "inconsistent types: toValue=$dst:${dst.type()}, fromValue=$src:${src.type()}"
             }
 
-            return registerUser(Move(id, owner, dst, src), dst, src)
+            return registerUser(Move(id, owner, dst, src))
         }
 
         fun typeCheck(copy: Move): Boolean {
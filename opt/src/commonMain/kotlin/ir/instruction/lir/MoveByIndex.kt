@@ -48,7 +48,7 @@ class MoveByIndex private constructor(id: Identity, owner: Block, destination: V
                 "inconsistent types: dst=$dst:${dst.type()}, index=$index:${index.type()}, src=$src:${src.type()}"
             }
 
-            return registerUser(MoveByIndex(id, owner, dst, index, src), dst, index, src)
+            return registerUser(MoveByIndex(id, owner, dst, index, src))
         }
 
         fun typeCheck(copy: MoveByIndex): Boolean {
@@ -60,7 +60,7 @@ class StoreOnStack private constructor(id: Identity, owner: Block, destination:
                 "inconsistent types: toValue=$dst:${dst.type()}, base=$src:${src.type()}"
             }
 
-            return registerUser(StoreOnStack(id, owner, dst, index, src), dst, index, src)
+            return registerUser(StoreOnStack(id, owner, dst, index, src))
         }
 
         fun typeCheck(copy: StoreOnStack): Boolean {
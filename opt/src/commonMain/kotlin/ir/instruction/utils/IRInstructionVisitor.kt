@@ -20,6 +20,7 @@ abstract class IRInstructionVisitor<T> {
     abstract fun visit(div: Div): T
     abstract fun visit(neg: Neg): T
     abstract fun visit(not: Not): T
+    abstract fun visit(bitop: BitOp): T
     abstract fun visit(branch: Branch): T
     abstract fun visit(branchCond: BranchCond): T
     abstract fun visit(call: Call): T
@@ -55,6 +56,7 @@ abstract class IRInstructionVisitor<T> {
     abstract fun visit(int2ptr: Int2Pointer): T
     abstract fun visit(ptr2Int: Pointer2Int): T
     abstract fun visit(memcpy: Memcpy): T
+    abstract fun visit(memset: Memset): T
     abstract fun visit(indexedLoad: IndexedLoad): T
     abstract fun visit(store: StoreOnStack): T
     abstract fun visit(loadst: LoadFromStack): T
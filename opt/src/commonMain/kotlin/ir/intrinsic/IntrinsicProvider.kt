@@ -6,4 +6,10 @@ import ir.platform.MacroAssembler
 
 abstract class IntrinsicProvider(val name: String) {
     abstract fun<Masm: MacroAssembler> implement(masm: Masm, inputs: List<VReg>)
-}
\ No newline at end of file
+
+    /**
+     * Configuration of the provider, which is written to the binary IR with the [name].
+     * [IntrinsicResolver] creates an equal provider from both.
+     */
+    open fun parameters(): IntArray = IntArray(0)
+}
@@ -0,0 +1,14 @@
+package ir.intrinsic
+
+
+/**
+ * Creates intrinsic providers of the binary IR by [IntrinsicProvider.name] and [IntrinsicProvider.parameters].
+ * Providers are defined by front ends, so the reader of the binary IR gets the resolver of the front end.
+ */
+fun interface IntrinsicResolver {
+    fun resolve(name: String, parameters: IntArray): IntrinsicProvider?
+
+    companion object {
+        val NONE = IntrinsicResolver { _, _ -> null }
+    }
+}
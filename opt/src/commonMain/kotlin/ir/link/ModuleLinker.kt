@@ -0,0 +1,240 @@
+package ir.link
+
+import ir.attributes.FunctionAttribute
+import ir.attributes.GlobalValueAttribute
+import ir.global.*
+import ir.module.*
+import ir.module.auxiliary.CopyCFG
+import ir.pass.analysis.VerifySSA
+import ir.types.AggregateType
+import ir.types.StructType
+import ir.types.asType
+import ir.value.constant.InitializerListValue
+import ir.value.constant.NonTrivialConstant
+import ir.value.constant.PointerLiteral
+
+
+class LinkerException(message: String): Exception(message)
+
+/**
+ * Merges translation units into a single module, so that optimisations see the whole program.
+ * Extern functions and values are resolved against definitions of the other modules by name,
+ * internal symbols and constants are renamed when their names clash.
+ * If [exported] is not null, definitions missing in it become internal.
+ */
+class ModuleLinker private constructor(private val modules: List<SSAModule>, private val exported: Set<String>?) {
+    private val localNames = modules.map { hashMapOf<String, String>() }
+    private val definitions = hashMapOf<String, Int>()
+    private val usedNames = hashSetOf<String>()
+    private val inProgress = hashSetOf<String>()
+
+    private val prototypes = hashMapOf<String, DirectFunctionPrototype>()
+    private val functions = linkedMapOf<String, FunctionData>()
+    private val constantPool = hashMapOf<String, GlobalConstant>()
+    private val globals = linkedMapOf<String, AnyGlobalValue>()
+    private val types = hashMapOf<String, StructType>()
+
+    private fun link(): SSAModule {
+        collectDefinitions()
+        assignLocalNames()
+        createPrototypes()
+        for ((index, module) in modules.withIndex()) {
+            for ((name, type) in module.types) {
+                types.getOrPut(name) { type }
+            }
+            for (constant in module.constantPool.values) {
+                resolve(index, constant)
+            }
+            for (global in module.globals.values) {
+                resolve(index, global)
+            }
+        }
+        for ((index, module) in modules.withIndex()) {
+            for (fd in module.functions()) {
+                val prototype = resolve(index, fd.prototype) as FunctionPrototype
+                functions[prototype.name] = CopyCFG.copy(fd, prototype) { resolve(index, it) }
+            }
+        }
+
+        val externFunctions = prototypes.filterValues { it is ExternFunction }
+        return VerifySSA.run(SSAModule(functions, externFunctions, constantPool, globals, types))
+    }
+
+    private fun isInternal(attributes: Set<FunctionAttribute>): Boolean {
+        return attributes.contains(GlobalValueAttribute.INTERNAL)
+    }
+
+    private fun define(index: Int, name: String) {
+        val owner = definitions.put(name, index)
+        if (owner != null) {
+            throw LinkerException("Multiple definition of '$name'")
+        }
+    }
+
+    private fun collectDefinitions() {
+        for ((index, module) in modules.withIndex()) {
+            for (fd in module.functions()) {
+                if (!isInternal(fd.prototype.attributes)) {
+                    define(index, fd.name())
+                }
+            }
+            for (global in module.globals.values) {
+                when (global) {
+                    is GlobalValue -> if (global.attribute() != GlobalValueAttribute.INTERNAL) {
+                        define(index, global.name())
+                    }
+                    is ExternValue -> usedNames.add(global.name())
+                }
+            }
+            usedNames.addAll(module.externFunctions.keys)
+        }
+
+        usedNames.addAll(definitions.keys)
+    }
+
+    private fun uniqueName(name: String): String {
+        if (usedNames.add(name)) {
+            return name
+        }
+
+        var suffix = 1
+        while (!usedNames.add("$name.$suffix")) {
+            suffix += 1
+        }
+        return "$name.$suffix"
+    }
+
+    private fun assignLocalNames() {
+        for ((index, module) in modules.withIndex()) {
+            val names = localNames[index]
+            for (fd in module.functions()) {
+                if (isInternal(fd.prototype.attributes)) {
+                    names[fd.name()] = uniqueName(fd.name())
+                }
+            }
+            for (global in module.globals.values) {
+                if (global is GlobalValue && global.attribute() == GlobalValueAttribute.INTERNAL) {
+                    names[global.name()] = uniqueName(global.name())
+                }
+            }
+            for (name in module.constantPool.keys) {
+                names[name] = uniqueName(name)
+            }
+        }
+    }
+
+    private fun linkName(index: Int, name: String): String {
+        return localNames[index][name] ?: name
+    }
+
+    private fun isExported(name: String): Boolean {
+        return exported == null || exported.contains(name)
+    }
+
+    private fun linkAttributes(name: String, attributes: Set<FunctionAttribute>): Set<FunctionAttribute> {
+        if (isExported(name)) {
+            return attributes
+        }
+
+        val internal = attributes.filterTo(hashSetOf()) { it !is GlobalValueAttribute }
+        internal.add(GlobalValueAttribute.INTERNAL)
+        return internal
+    }
+
+    private fun createPrototypes() {
+        for ((index, module) in modules.withIndex()) {
+            for (fd in module.functions()) {
+                val name = linkName(index, fd.name())
+                val prototype = fd.prototype
+                prototypes[name] = FunctionPrototype(name, prototype.returnType(), prototype.arguments(), linkAttributes(name, prototype.attributes))
+            }
+        }
+        for ((index, module) in modules.withIndex()) {
+            for (prototype in module.externFunctions.values) {
+                val name = linkName(index, prototype.name)
+                prototypes.getOrPut(name) {
+                    ExternFunction(name, prototype.returnType(), prototype.arguments(), prototype.attributes)
+                }
+            }
+        }
+    }
+
+    private fun resolve(index: Int, symbol: GlobalSymbol): GlobalSymbol = when (symbol) {
+        is FunctionSymbol -> prototypes[linkName(index, symbol.name())]
+            ?: throw LinkerException("Function '${symbol.name()}' is not declared")
+        is GlobalConstant -> resolveConstant(index, symbol)
+        is AnyGlobalValue -> resolveGlobal(index, symbol)
+    }
+
+    private fun resolveConstant(index: Int, constant: GlobalConstant): GlobalConstant {
+        val name = linkName(index, constant.name())
+        val linked = constantPool[name]
+        if (linked != null) {
+            return linked
+        }
+
+        val original = constant.constant()
+        val content = linkConstant(index, original)
+        val newConstant = if (name == constant.name() && content === original) {
+            constant
+        } else {
+            GlobalConstant.of(name, content) ?: throw LinkerException("Unsupported constant '$name': $content")
+        }
+        constantPool[name] = newConstant
+        return newConstant
+    }
+
+    private fun resolveGlobal(index: Int, global: AnyGlobalValue): AnyGlobalValue {
+        val name = linkName(index, global.name())
+        val linked = globals[name]
+        if (linked != null) {
+            return linked
+        }
+
+        val owner = if (localNames[index].containsKey(global.name())) index else definitions[name]
+        if (owner == null) {
+            val extern = ExternValue(name, (global as ExternValue).type)
+            globals[name] = extern
+            return extern
+        }
+
+        val definition = modules[owner].globals[global.name()] as? GlobalValue
+            ?: throw LinkerException("Symbol '$name' is not a global value")
+        if (!inProgress.add(name)) {
+            // Initializers referencing each other, the pointer is resolved by name in the code generator.
+            return ExternValue(name, definition.contentType())
+        }
+
+        val initializer = linkConstant(owner, definition.initializer())
+        val newGlobal = GlobalValue.create(name, initializer, linkAttribute(name, definition.attribute()))
+        inProgress.remove(name)
+        globals[name] = newGlobal
+        return newGlobal
+    }
+
+    private fun linkAttribute(name: String, attribute: GlobalValueAttribute): GlobalValueAttribute {
+        return if (isExported(name)) attribute else GlobalValueAttribute.INTERNAL
+    }
+
+    private fun linkConstant(index: Int, constant: NonTrivialConstant): NonTrivialConstant = when (constant) {
+        is PointerLiteral -> {
+            val symbol = resolve(index, constant.gConstant)
+            if (symbol === constant.gConstant) constant else PointerLiteral.of(symbol, constant.index)
+        }
+        is InitializerListValue -> {
+            val elements = constant.elements.map { linkConstant(index, it) }
+            if (elements.indices.all { elements[it] === constant.elements[it] }) {
+                constant
+            } else {
+                InitializerListValue(constant.type().asType<AggregateType>(), elements)
+            }
+        }
+        else -> constant
+    }
+
+    companion object {
+        fun link(modules: List<SSAModule>, exported: Set<String>? = null): SSAModule {
+            return ModuleLinker(modules, exported).link()
+        }
+    }
+}
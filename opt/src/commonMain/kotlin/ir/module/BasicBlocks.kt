@@ -51,6 +51,24 @@ class BasicBlocks private constructor(): LabelResolver, AnyBasicBlocks<Block>()
         return block
     }
 
+    /**
+     * Removes an empty block without predecessors.
+     * The block with the highest index takes over the index of the removed one, so block indices stay dense.
+     */
+    internal fun removeBlock(block: Block) = modificationCounter.cf {
+        assertion(block.isEmpty() && block.predecessors().isEmpty()) {
+            "block=$block must be empty and unreachable"
+        }
+        assertion(block.index != Label.entry.index) {
+            "cannot remove entry block"
+        }
+
+        basicBlocks.remove(block)
+        maxBBIndex -= 1
+        val last = basicBlocks.find { it.index == maxBBIndex } ?: return@cf
+        last.index = block.index
+    }
+
     override operator fun iterator(): Iterator<Block> {
         return basicBlocks.iterator()
     }
@@ -10,16 +10,23 @@ import ir.instruction.*
 import ir.instruction.Copy
 import ir.instruction.lir.*
 import ir.instruction.utils.IRInstructionVisitor
+import ir.module.DirectFunctionPrototype
 import ir.module.FunctionData
+import ir.module.FunctionPrototype
 import ir.module.block.Block
+import ir.pass.analysis.dominance.DominatorTreeFabric
 import ir.pass.analysis.traverse.PreOrderFabric
 import ir.value.*
 import ir.value.constant.Constant
+import ir.value.constant.PointerLiteral
 
 
-internal class CopyCFG private constructor(private val fd: FunctionData) : IRInstructionVisitor<InstBuilder<Instruction>>() {
+/**
+ * Copies [fd] under [prototype], references to global symbols are replaced by [mapSymbol].
+ */
+internal class CopyCFG private constructor(private val fd: FunctionData, prototype: FunctionPrototype, private val mapSymbol: (GlobalSymbol) -> GlobalSymbol) : IRInstructionVisitor<InstBuilder<Instruction>>() {
     private val oldValuesToNew = hashMapOf<LocalValue, LocalValue>()
-    private val newCFG         = FunctionData.create(fd.prototype, copyArguments())
+    private val newCFG         = FunctionData.create(prototype, copyArguments())
     private val oldToNewBlock  = setupNewBasicBlock()
     private var currentBB: Block? = null
 
@@ -56,9 +63,18 @@ internal class CopyCFG private constructor(private val fd: FunctionData) : IRIns
 
     fun copy(): FunctionData {
         copyBasicBlocks()
+        transferAnalyses()
         return newCFG
     }
 
+    /**
+     * The copy has the same control flow graph, so the cached dominator tree is remapped instead of recomputed.
+     */
+    private fun transferAnalyses() {
+        val dominatorTree = fd.cache().get(DominatorTreeFabric, fd.marker()) ?: return
+        newCFG.cache().put(DominatorTreeFabric, dominatorTree.copy(oldToNewBlock, newCFG.marker()))
+    }
+
     private fun copyBasicBlocks() {
         for (bb in fd.analysis(PreOrderFabric)) {
             copyBasicBlocks(bb)
@@ -93,8 +109,19 @@ internal class CopyCFG private constructor(private val fd: FunctionData) : IRIns
         }
     }
 
+    private fun mapPrototype(old: DirectFunctionPrototype): DirectFunctionPrototype {
+        return mapSymbol(old) as DirectFunctionPrototype
+    }
+
     private inline fun<reified T> mapUsage(old: Value): T {
-        if (old is Constant || old is GlobalSymbol) {
+        if (old is GlobalSymbol) {
+            return mapSymbol(old) as T
+        }
+        if (old is PointerLiteral) {
+            val symbol = mapSymbol(old.gConstant)
+            return if (symbol === old.gConstant) old as T else PointerLiteral.of(symbol, old.index) as T
+        }
+        if (old is Constant) {
             return old as T
         }
         val value = oldValuesToNew[old]
@@ -235,6 +262,11 @@ internal class CopyCFG private constructor(private val fd: FunctionData) : IRIns
         return Not.not(operand)
     }
 
+    override fun visit(bitop: BitOp): InstBuilder<Instruction> {
+        val operand = mapUsage<Value>(bitop.operand())
+        return BitOp.bitop(bitop.op(), operand)
+    }
+
     override fun visit(branch: Branch): InstBuilder<Instruction> {
         return Branch.br(mapBlock(branch.target()))
     }
@@ -250,14 +282,14 @@ internal class CopyCFG private constructor(private val fd: FunctionData) : IRIns
         val newUsages = mapArguments(call)
         val target    = mapBlock(call.target())
 
-        return Call.call(call.prototype(), newUsages, cloneAttributes(call), target)
+        return Call.call(mapPrototype(call.prototype()), newUsages, cloneAttributes(call), target)
     }
 
     override fun visit(tupleCall: TupleCall): InstBuilder<Instruction> {
         val newUsages = mapArguments(tupleCall)
         val target    = mapBlock(tupleCall.target())
 
-        return TupleCall.call(tupleCall.prototype(), newUsages, cloneAttributes(tupleCall), target)
+        return TupleCall.call(mapPrototype(tupleCall.prototype()), newUsages, cloneAttributes(tupleCall), target)
     }
 
     override fun visit(bitcast: Bitcast): InstBuilder<Instruction> {
@@ -409,7 +441,7 @@ internal class CopyCFG private constructor(private val fd: FunctionData) : IRIns
     override fun visit(voidCall: VoidCall): InstBuilder<Instruction> {
         val newUsages = mapArguments(voidCall)
         val target    = mapBlock(voidCall.target())
-        return VoidCall.call(voidCall.prototype(), newUsages, cloneAttributes(voidCall), target)
+        return VoidCall.call(mapPrototype(voidCall.prototype()), newUsages, cloneAttributes(voidCall), target)
     }
 
     override fun visit(int2ptr: Int2Pointer): InstBuilder<Instruction> {
@@ -494,6 +526,12 @@ internal class CopyCFG private constructor(private val fd: FunctionData) : IRIns
         return Memcpy.memcpy(dst, src, memcpy.length())
     }
 
+    override fun visit(memset: Memset): InstBuilder<Instruction> {
+        val dst = mapUsage<Value>(memset.destination())
+
+        return Memset.memset(dst, memset.value(), memset.length())
+    }
+
     override fun visit(move: MoveByIndex): InstBuilder<Instruction> {
         val index   = mapUsage<Value>(move.index())
         val toValue = mapUsage<Value>(move.destination())
@@ -504,7 +542,11 @@ internal class CopyCFG private constructor(private val fd: FunctionData) : IRIns
 
     companion object {
         fun copy(old: FunctionData): FunctionData {
-            return CopyCFG(old).copy()
+            return CopyCFG(old, old.prototype) { it }.copy()
+        }
+
+        fun copy(old: FunctionData, prototype: FunctionPrototype, mapSymbol: (GlobalSymbol) -> GlobalSymbol): FunctionData {
+            return CopyCFG(old, prototype, mapSymbol).copy()
         }
     }
 }
\ No newline at end of file
@@ -3,7 +3,10 @@ package ir.module.block
 import common.LListNode
 import common.LeakedLinkedList
 
-abstract class AnyBlock<Inst : LListNode>(override val index: Int): Label, Iterable<Inst> {
+abstract class AnyBlock<Inst : LListNode>(index: Int): Label, Iterable<Inst> {
+    final override var index: Int = index
+        internal set
+
     protected val instructions = object : LeakedLinkedList<Inst>() {}
 
     abstract fun predecessors(): List<AnyBlock<Inst>>
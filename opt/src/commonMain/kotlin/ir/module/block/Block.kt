@@ -96,6 +96,39 @@ class Block private constructor(private val mc: ModificationCounter, index: Int)
         return instruction.next()
     }
 
+    /**
+     * Moves all instructions of the continuation block of [call] to the end of this block,
+     * so that [call] becomes an ordinary in-block instruction.
+     * The continuation block is left empty and must be removed by the caller.
+     */
+    internal fun fuseContinuation(call: Callable): Block = mc.dfANDcf {
+        assertion(call === lastOrNull()) {
+            "call=$call must be the last instruction in bb=$this"
+        }
+        val cont = call.target()
+        assertion(cont.predecessors.size == 1 && cont.predecessors[0] === this) {
+            "continuation=$cont must have the only predecessor bb=$this"
+        }
+
+        call as TerminateInstruction
+        call.detachTargets()
+        for (succ in cont.successors()) {
+            val idx = succ.predecessors.indexOf(cont)
+            succ.predecessors[idx] = this
+            succ.phis { phi ->
+                phi.incoming { bb, _ -> if (bb === cont) this else bb }
+            }
+        }
+
+        while (cont.instructions.isNotEmpty()) {
+            val instruction = cont.instructions.removeFirst()
+            instruction.relocate(this, allocateValue())
+            instructions.add(instruction)
+        }
+
+        return@dfANDcf cont
+    }
+
     private fun makeEdge(to: Block) = mc.cf {
         to.predecessors.add(this)
     }
@@ -104,6 +137,9 @@ class Block private constructor(private val mc: ModificationCounter, index: Int)
         to.predecessors.remove(this)
     }
 
+    /** Upper bound of identities of the instructions in this block. */
+    internal fun identityBound(): Int = instructionIndex
+
     private fun allocateValue(): Int {
         val currentValue = instructionIndex
         instructionIndex += 1
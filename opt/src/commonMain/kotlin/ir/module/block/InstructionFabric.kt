@@ -7,6 +7,7 @@ import ir.intrinsic.IntrinsicProvider
 import ir.module.DirectFunctionPrototype
 import ir.module.IndirectFunctionPrototype
 import ir.value.constant.IntegerConstant
+import ir.value.constant.U8Value
 import ir.value.constant.UnsignedIntegerConstant
 import ir.value.Value
 
@@ -14,6 +15,7 @@ import ir.value.Value
 interface InstructionFabric {
     fun neg(value: Value): Neg
     fun not(value: Value): Not
+    fun bitop(op: BitOpType, value: Value): BitOp
     fun add(a: Value, b: Value): Add
     fun and(a: Value, b: Value): And
     fun or(a: Value, b: Value): Or
@@ -56,6 +58,7 @@ interface InstructionFabric {
     fun int2ptr(value: Value): Int2Pointer
     fun ptr2int(value: Value, toType: IntegerType): Pointer2Int
     fun memcpy(dst: Value, src: Value, length: UnsignedIntegerConstant): Memcpy
+    fun memset(dst: Value, value: U8Value, length: UnsignedIntegerConstant): Memset
     fun proj(tuple: Value, index: Int): Projection
     fun switch(value: Value, default: Label, table: List<IntegerConstant>, targets: List<Label>): Switch
     fun intrinsic(inputs: List<Value>, implementor: IntrinsicProvider, target: Label): Intrinsic
@@ -16,6 +16,7 @@ import ir.module.block.Label
 import ir.module.block.InstructionFabric
 import ir.module.builder.AnyFunctionDataBuilder
 import ir.value.constant.IntegerConstant
+import ir.value.constant.U8Value
 import ir.value.constant.UnsignedIntegerConstant
 
 
@@ -44,6 +45,10 @@ class FunctionDataBuilder private constructor(prototype: FunctionPrototype, argu
         return bb.put(Neg.neg(value))
     }
 
+    override fun bitop(op: BitOpType, value: Value): BitOp {
+        return bb.put(BitOp.bitop(op, value))
+    }
+
     override fun add(a: Value, b: Value): Add {
         return bb.put(Add.add(a, b))
     }
@@ -243,6 +248,11 @@ class FunctionDataBuilder private constructor(prototype: FunctionPrototype, argu
         return bb.put(memcpy)
     }
 
+    override fun memset(dst: Value, value: U8Value, length: UnsignedIntegerConstant): Memset {
+        val memset = Memset.memset(dst, value, length)
+        return bb.put(memset)
+    }
+
     override fun proj(tuple: Value, index: Int): Projection {
         val proj = Projection.proj(tuple, index)
         return bb.put(proj)
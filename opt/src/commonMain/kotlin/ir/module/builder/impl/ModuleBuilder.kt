@@ -13,9 +13,10 @@ import ir.types.NonTrivialType
 
 class ModuleBuilder private constructor(): AnyModuleBuilder() {
     private val functions = arrayListOf<FunctionDataBuilder>()
+    private val builtFunctions = hashMapOf<String, DirectFunctionPrototype>()
 
     fun findFunction(name: String): DirectFunctionPrototype? {
-        return functions.find { it.prototype().name() == name }?.prototype() ?: functionDeclarations[name]
+        return functions.find { it.prototype().name() == name }?.prototype() ?: builtFunctions[name] ?: functionDeclarations[name]
     }
 
     fun createFunction(name: String, returnType: Type, argumentTypes: List<NonTrivialType>, attributes: Set<FunctionAttribute> = hashSetOf()): FunctionDataBuilder {
@@ -30,6 +31,26 @@ class ModuleBuilder private constructor(): AnyModuleBuilder() {
         return data
     }
 
+    /**
+     * Builds functions created since the previous call and drops their builders.
+     * Already built functions are declared as external ones, so that calls to them pass verification.
+     * Returned module shares constant pool and globals with this builder.
+     */
+    fun buildPendingFunctions(): SSAModule {
+        val fns = functions.map { it.build() }
+            .associateBy { it.name() }
+        functions.clear()
+
+        val externFunctions = HashMap(functionDeclarations)
+        externFunctions.putAll(builtFunctions)
+        for (fn in fns.values) {
+            builtFunctions[fn.name()] = fn.prototype
+        }
+
+        val module = SSAModule(fns, externFunctions, constantPool, globals, structs)
+        return VerifySSA.run(module)
+    }
+
     override fun build(): SSAModule {
         val fns = functions.map { it.build() }
             .associateBy { it.name() }
@@ -6,18 +6,23 @@ import ir.module.Sensitivity
 import ir.pass.common.AnalysisResult
 import ir.pass.common.AnalysisType
 import ir.pass.common.FunctionAnalysisPassFabric
+import ir.pass.common.PreservedAnalyses
 
 /**
  * Cache for analysis pass result.
  */
 class AnalysisPassCache {
     private val cache by lazy { intMapOf<FunctionAnalysisPassFabric<AnalysisResult>, AnalysisResult>(AnalysisType.size()) { it.type().ordinal } }
+    // Mutation marker at which the cached result is known to be valid.
+    private val validAt = arrayOfNulls<MutationMarker>(AnalysisType.size())
 
     fun getResult(type: FunctionAnalysisPassFabric<AnalysisResult>, mutationMarker: MutationMarker): AnalysisResult? {
         val result = cache[type] ?: return null
-        val mutationType = mutationMarker.mutationType(result.marker()) ?: return result
+        val marker = validAt[type.type().ordinal] ?: result.marker()
+        val mutationType = mutationMarker.mutationType(marker) ?: return result
         if (mutationType.isIntersection(type.sensitivity())) {
             cache.remove(type)
+            validAt[type.type().ordinal] = null
             return null
         }
 
@@ -31,6 +36,44 @@ class AnalysisPassCache {
 
     fun<T: AnalysisResult> put(key: FunctionAnalysisPassFabric<T>, value: T): T {
         cache[key] = value
+        validAt[key.type().ordinal] = value.marker()
         return value
     }
-}
\ No newline at end of file
+
+    /**
+     * Returns types of cached analyses which are valid at [mutationMarker] and belong to [preserved].
+     */
+    fun validAnalyses(preserved: PreservedAnalyses, mutationMarker: MutationMarker): List<AnalysisType> {
+        if (preserved.isEmpty()) {
+            return emptyList()
+        }
+
+        val types = arrayListOf<AnalysisType>()
+        for (fabric in cache.keys.toList()) {
+            if (!preserved.isPreserved(fabric.type())) {
+                continue
+            }
+            if (getResult(fabric, mutationMarker) == null) {
+                continue
+            }
+
+            types.add(fabric.type())
+        }
+
+        return types
+    }
+
+    /**
+     * Marks cached results of [types] as valid at [mutationMarker].
+     * A transformation calls it for analyses it has kept up to date, see [validAnalyses].
+     */
+    fun revalidate(types: List<AnalysisType>, mutationMarker: MutationMarker) {
+        for (type in types) {
+            if (validAt[type.ordinal] == null) {
+                continue // Result was dropped meanwhile.
+            }
+
+            validAt[type.ordinal] = mutationMarker
+        }
+    }
+}
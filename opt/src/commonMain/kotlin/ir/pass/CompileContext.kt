@@ -1,37 +1,67 @@
 package ir.pass
 
-import java.nio.file.Path
+import ir.platform.x64.MArch
 
 
 sealed interface CompileContext{
     fun pic(): Boolean
-    fun outputFile(passName: String): Path?
+    fun inBlockCalls(): Boolean
+    fun omitFramePointer(): Boolean
+    fun optimizeSiblingCalls(): Boolean
+    fun verboseAsm(): Boolean
+    fun march(): MArch
+    fun outputFile(passName: String): String?
 
     companion object {
          fun empty(): CompileContext {
-             return CompileContextImpl("", "", null, false)
+             return CompileContextImpl("", "", null, false, false, false, false, false, MArch.DEFAULT)
          }
     }
 }
 
-class CompileContextImpl(private val filename: String, private val suffix: String, private val outputDir: String?, val picEnabled: Boolean): CompileContext {
-    override fun outputFile(passName: String): Path? {
+class CompileContextImpl(private val filename: String, private val suffix: String, private val outputDir: String?, val picEnabled: Boolean, val inBlockCallsEnabled: Boolean, val omitFramePointerEnabled: Boolean, val siblingCallsEnabled: Boolean, val verboseAsmEnabled: Boolean, val targetArch: MArch): CompileContext {
+    override fun outputFile(passName: String): String? {
         if (outputDir == null) {
             return null
         }
 
-        return Path.of("${outputDir}/$filename/${passName}${suffix}.ir")
+        return "${outputDir}/$filename/${passName}${suffix}.ir"
     }
 
     override fun pic(): Boolean {
         return picEnabled
     }
+
+    override fun inBlockCalls(): Boolean {
+        return inBlockCallsEnabled
+    }
+
+    override fun omitFramePointer(): Boolean {
+        return omitFramePointerEnabled
+    }
+
+    override fun optimizeSiblingCalls(): Boolean {
+        return siblingCallsEnabled
+    }
+
+    override fun verboseAsm(): Boolean {
+        return verboseAsmEnabled
+    }
+
+    override fun march(): MArch {
+        return targetArch
+    }
 }
 
 class CompileContextBuilder(private val filename: String) {
     private var suffix: String? = null
     private var dumpIr: String? = null
     private var picEnabled: Boolean = false
+    private var inBlockCalls: Boolean = false
+    private var omitFramePointer: Boolean = false
+    private var siblingCalls: Boolean = false
+    private var verboseAsm: Boolean = false
+    private var march: MArch = MArch.DEFAULT
 
     fun setSuffix(name: String): CompileContextBuilder {
         suffix = name
@@ -48,7 +78,32 @@ class CompileContextBuilder(private val filename: String) {
         return this
     }
 
+    fun setInBlockCalls(enabled: Boolean): CompileContextBuilder {
+        inBlockCalls = enabled
+        return this
+    }
+
+    fun setOmitFramePointer(enabled: Boolean): CompileContextBuilder {
+        omitFramePointer = enabled
+        return this
+    }
+
+    fun setOptimizeSiblingCalls(enabled: Boolean): CompileContextBuilder {
+        siblingCalls = enabled
+        return this
+    }
+
+    fun setVerboseAsm(enabled: Boolean): CompileContextBuilder {
+        verboseAsm = enabled
+        return this
+    }
+
+    fun setMArch(march: MArch): CompileContextBuilder {
+        this.march = march
+        return this
+    }
+
     fun construct(): CompileContext {
-        return CompileContextImpl(filename, suffix ?: "", dumpIr, picEnabled) //TODO: fix this
+        return CompileContextImpl(filename, suffix ?: "", dumpIr, picEnabled, inBlockCalls, omitFramePointer, siblingCalls, verboseAsm, march) //TODO: fix this
     }
 }
\ No newline at end of file
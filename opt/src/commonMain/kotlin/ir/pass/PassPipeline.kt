@@ -6,9 +6,9 @@ import ir.pass.common.TransformPassFabric
 import ir.pass.transform.DeadCodeElimination
 import ir.pass.transform.Mem2RegFabric
 import ir.pass.transform.normalizer.Normalizer
-import java.io.FileOutputStream
-import java.io.OutputStream
-import java.io.OutputStreamWriter
+import common.FileUtils
+import common.createDirectories
+import common.openTextFile
 
 
 class PassPipeline private constructor(private val name: String, private val passFabrics: List<TransformPassFabric<SSAModule>>, private val ctx: CompileContext) {
@@ -18,7 +18,7 @@ class PassPipeline private constructor(private val name: String, private val pas
         for (fabric in passFabrics) {
             try {
                 val pass = fabric.create(current, ctx)
-                current = pass.run()
+                current = pass.runPreserving()
                 VerifySSA.run(current)
                 dumpIr(pass.name()) { current.toString() }
             } catch (ex: Throwable) {
@@ -32,13 +32,8 @@ class PassPipeline private constructor(private val name: String, private val pas
     private fun dumpIr(passName: String, message: () -> String) {
         val filename = ctx.outputFile(passName) ?: return
 
-        if (!filename.parent.toFile().exists()) {
-            filename.parent.toFile().mkdirs()
-        }
-        val outputStream: OutputStream = FileOutputStream(filename.toFile())
-        outputStream.use {
-            OutputStreamWriter(outputStream).use { it.write(message()) }
-        }
+        createDirectories(FileUtils.getDirName(filename))
+        openTextFile(filename).use { it.append(message()) }
     }
 
     companion object {
@@ -1,5 +1,7 @@
 package ir.pass.analysis
 
+import common.IdMap
+import common.idMapOf
 import ir.value.*
 import ir.instruction.*
 import ir.module.FunctionData
@@ -44,50 +46,63 @@ enum class EscapeState {
 
 private class EscapeAnalysis(private val functionData: FunctionData): FunctionAnalysisPass<EscapeAnalysisResult>() {
     private val preorder = functionData.analysis(PreOrderFabric)
+    private val localEscapeState = idMapOf<LocalValue, EscapeState>(functionData.analysis(ValueNumberingFabric))
     private val escapeState = hashMapOf<Value, EscapeState>()
 
+    private fun state(operand: Value): EscapeState? = when (operand) {
+        is LocalValue -> localEscapeState[operand]
+        else -> escapeState[operand]
+    }
+
+    private fun setState(operand: Value, state: EscapeState) {
+        when (operand) {
+            is LocalValue -> localEscapeState[operand] = state
+            else -> escapeState[operand] = state
+        }
+    }
+
     private fun union(operand: Value, newState: EscapeState): EscapeState {
-        val state = escapeState[operand] ?: EscapeState.Unknown
+        val state = state(operand) ?: EscapeState.Unknown
         return state.union(newState)
     }
 
     private fun visitAlloc(alloc: Alloc) {
-        escapeState[alloc] = EscapeState.NoEscape
+        setState(alloc, EscapeState.NoEscape)
     }
 
     private fun visitStore(store: Store) {
-        escapeState[store.pointer()] = union(store.pointer(), EscapeState.NoEscape)
+        setState(store.pointer(), union(store.pointer(), EscapeState.NoEscape))
         when (val value = store.value()) {
-            is Constant -> escapeState[value] = EscapeState.Constant
-            is LocalValue -> escapeState[value] = union(value, EscapeState.Field)
+            is Constant -> setState(value, EscapeState.Constant)
+            is LocalValue -> setState(value, union(value, EscapeState.Field))
         }
     }
 
     private fun visitLoad(load: Load) {
         val operand = load.operand()
         if (operand is LocalValue) {
-            escapeState[operand] = union(operand, EscapeState.NoEscape)
+            setState(operand, union(operand, EscapeState.NoEscape))
         } else {
-            escapeState[operand] = union(operand, EscapeState.Unknown)
+            setState(operand, union(operand, EscapeState.Unknown))
         }
     }
 
     private fun visitPointer2Int(pointer2Int: Pointer2Int) {
-        escapeState[pointer2Int.operand()] = union(pointer2Int.operand(), EscapeState.Unknown)
+        setState(pointer2Int.operand(), union(pointer2Int.operand(), EscapeState.Unknown))
     }
 
     private fun visitCall(call: Callable) {
         for (argument in call.arguments()) {
-            escapeState[argument] = union(argument, EscapeState.Argument)
+            setState(argument, union(argument, EscapeState.Argument))
         }
     }
 
     private fun visitGetElementPtr(getElementPtr: GetElementPtr) {
-        escapeState[getElementPtr.source()] = union(getElementPtr.source(), EscapeState.Field)
+        setState(getElementPtr.source(), union(getElementPtr.source(), EscapeState.Field))
     }
 
     private fun visitGetFieldPtr(getFieldPtr: GetFieldPtr) {
-        escapeState[getFieldPtr.source()] = union(getFieldPtr.source(), EscapeState.Field)
+        setState(getFieldPtr.source(), union(getFieldPtr.source(), EscapeState.Field))
     }
 
     override fun run(): EscapeAnalysisResult {
@@ -104,12 +119,15 @@ private class EscapeAnalysis(private val functionData: FunctionData): FunctionAn
                 }
             }
         }
-        return EscapeAnalysisResult(escapeState, functionData.marker())
+        return EscapeAnalysisResult(localEscapeState, escapeState, functionData.marker())
     }
 }
 
-class EscapeAnalysisResult(private val escapeState: Map<Value, EscapeState>, marker: MutationMarker): AnalysisResult(marker) {
+class EscapeAnalysisResult(private val localEscapeState: IdMap<LocalValue, EscapeState>, private val escapeState: Map<Value, EscapeState>, marker: MutationMarker): AnalysisResult(marker) {
     override fun toString(): String = buildString {
+        localEscapeState.forEachEntry { value, state ->
+            append("Value: $value: $state\n")
+        }
         for ((value, state) in escapeState) {
             append("Value: $value: $state\n")
         }
@@ -120,7 +138,12 @@ class EscapeAnalysisResult(private val escapeState: Map<Value, EscapeState>, mar
             return EscapeState.Constant
         }
 
-        return escapeState[value] ?: EscapeState.Unknown
+        val state = when (value) {
+            is LocalValue -> localEscapeState[value]
+            else -> escapeState[value]
+        }
+
+        return state ?: EscapeState.Unknown
     }
 
     fun isNoEscape(value: Value): Boolean {
@@ -1,62 +1,113 @@
 package ir.pass.analysis
 
+import common.BitVector
 import ir.value.LocalValue
 import ir.instruction.Phi
 import ir.module.FunctionData
 import ir.module.MutationMarker
 import ir.module.Sensitivity
+import ir.module.block.Block
 import ir.module.block.Label
-import ir.pass.analysis.traverse.PreOrderFabric
+import ir.pass.analysis.traverse.PostOrderFabric
 import ir.pass.common.AnalysisResult
 import ir.pass.common.AnalysisType
 import ir.pass.common.FunctionAnalysisPass
 import ir.pass.common.FunctionAnalysisPassFabric
 
 
-data class LiveInfo(internal val liveIn: MutableSet<LocalValue>, internal val liveOut: MutableSet<LocalValue>) {
+/**
+ * Read-only view of a live set: bits are ids of [ValueNumbering], [values] maps ids back to local values.
+ */
+class LiveSet internal constructor(private val bits: BitVector, private val numbering: ValueNumbering, private val values: Array<LocalValue?>): AbstractSet<LocalValue>() {
+    override val size: Int
+        get() = bits.cardinality()
+
+    override fun contains(element: LocalValue): Boolean {
+        val id = numbering.id(element)
+        return bits[id] && values[id] === element
+    }
+
+    override fun iterator(): Iterator<LocalValue> {
+        val result = arrayListOf<LocalValue>()
+        bits.forEachSetBit { result.add(values[it]!!) }
+        return result.iterator()
+    }
+}
+
+class LiveInfo internal constructor(private val liveIn: LiveSet, private val liveOut: LiveSet) {
     fun liveIn(): Set<LocalValue> = liveIn
     fun liveOut(): Set<LocalValue> = liveOut
 }
 
-class LivenessAnalysisInfo internal constructor(private val liveness: Map<Label, LiveInfo>, marker: MutationMarker): AnalysisResult(marker) {
+class LivenessAnalysisInfo internal constructor(private val liveness: Array<LiveInfo?>, marker: MutationMarker): AnalysisResult(marker) {
     override fun toString(): String = buildString {
-        for ((label, liveInfo) in liveness) {
-            append("Label: $label\n")
-            append("LiveIn: ${liveInfo.liveIn}\n")
-            append("LiveOut: ${liveInfo.liveOut}\n")
+        for ((index, liveInfo) in liveness.withIndex()) {
+            if (liveInfo == null) {
+                continue
+            }
+
+            append("Label: L$index\n")
+            append("LiveIn: ${liveInfo.liveIn()}\n")
+            append("LiveOut: ${liveInfo.liveOut()}\n")
         }
     }
 
     fun liveOut(label: Label): Set<LocalValue> {
-        return liveness[label]!!.liveOut()
+        return liveness[label.index]!!.liveOut()
     }
 
     fun liveIn(label: Label): Set<LocalValue> {
-        return liveness[label]!!.liveIn()
+        return liveness[label.index]!!.liveIn()
     }
 
     val size: Int
-        get() = liveness.size
+        get() = liveness.count { it != null }
 }
 
-private data class KillGenSet(val kill: MutableSet<LocalValue>, val gen: MutableSet<LocalValue>)
-
+/**
+ * Backward dataflow over bit vectors indexed by [ValueNumbering] ids.
+ * Kill and gen sets are computed once, then a worklist revisits only predecessors of blocks whose live-in set grew.
+ */
 private class LivenessAnalysis(private val functionData: FunctionData): FunctionAnalysisPass<LivenessAnalysisInfo>() {
-    private val order = functionData.analysis(PreOrderFabric)
-    private val liveness = run {
-        val mapOf = hashMapOf<Label, LiveInfo>()
+    private val postorder = functionData.analysis(PostOrderFabric)
+    private val numbering = functionData.analysis(ValueNumberingFabric)
+    private val blockCount = run {
+        var maxIndex = 0
         for (bb in functionData) {
-            mapOf[bb] = LiveInfo(hashSetOf(), hashSetOf())
+            maxIndex = maxOf(maxIndex, bb.index)
         }
 
-        mapOf
+        maxIndex + 1
+    }
+    private val values = arrayOfNulls<LocalValue>(numbering.capacity())
+
+    private val reachable = BooleanArray(blockCount)
+    private val kill      = arrayOfNulls<BitVector>(blockCount)
+    private val gen       = arrayOfNulls<BitVector>(blockCount)
+    private val liveIn    = arrayOfNulls<BitVector>(blockCount)
+    private val liveOut   = arrayOfNulls<BitVector>(blockCount)
+
+    private fun newVector(): BitVector = BitVector(numbering.capacity())
+
+    private fun setupValues() {
+        for (arg in functionData.arguments()) {
+            values[numbering.id(arg)] = arg
+        }
+        for (bb in functionData) {
+            for (inst in bb) {
+                if (inst !is LocalValue) {
+                    continue
+                }
+
+                values[numbering.id(inst)] = inst
+            }
+        }
     }
 
-    private fun computeLocalLiveSets(): Map<Label, KillGenSet> {
-        val killGenSet = mutableMapOf<Label, KillGenSet>()
-        for (bb in order) {
-            val gen = hashSetOf<LocalValue>()
-            val kill = hashSetOf<LocalValue>()
+    private fun computeLocalLiveSets() {
+        for (bb in postorder) {
+            val genSet = newVector()
+            val killSet = newVector()
 
             for (inst in bb) {
                 // Handle input operands
@@ -66,68 +117,94 @@ private class LivenessAnalysis(private val functionData: FunctionData): Function
                             continue
                         }
 
-                        if (kill.contains(operand)) {
+                        val id = numbering.id(operand)
+                        if (killSet[id]) {
                             continue
                         }
 
-                        gen.add(operand)
+                        genSet.set(id)
                     }
                 }
 
-
                 // Handle output operand
                 if (inst is LocalValue) {
-                    kill.add(inst)
+                    killSet.set(numbering.id(inst))
                 }
             }
 
-            killGenSet[bb] = KillGenSet(kill, gen)
+            reachable[bb.index] = true
+            gen[bb.index]       = genSet
+            kill[bb.index]      = killSet
+            liveIn[bb.index]    = newVector()
+            liveOut[bb.index]   = newVector()
         }
 
-        for (bb in order) {
+        for (bb in postorder) {
             bb.phis { phi ->
                 phi.zip { block, value ->
                     if (value !is LocalValue) {
                         return@zip
                     }
 
-                    val killGen = killGenSet[block] ?: throw NoSuchElementException("No kill/gen set for block $bb")
-
-                    if (!killGen.kill.contains(value)) {
-                        killGen.gen.add(value)
+                    val killSet = kill[block.index] ?: throw NoSuchElementException("No kill/gen set for block $bb")
+                    val id = numbering.id(value)
+                    if (!killSet[id]) {
+                        gen[block.index]!!.set(id)
                     }
                 }
             }
         }
-        return killGenSet
     }
 
     private fun computeGlobalLiveSets() {
-        val killGenSet = computeLocalLiveSets()
-        do {
-            var changed = false
-            for (bb in order.reversed()) {
-                val bbLiveness = liveness[bb] ?: throw NoSuchElementException("No liveness info for block $bb")
-
-                val liveOut = bbLiveness.liveOut
-                for (succ in bb.successors()) {
-                    // live_out = b.live_out ∪ succ.live_in
-                    changed = changed or liveOut.addAll(liveness[succ]!!.liveIn)
-                }
+        val worklist = ArrayDeque<Block>(postorder.size)
+        val inWorklist = BooleanArray(blockCount)
+        for (bb in postorder) {
+            worklist.add(bb)
+            inWorklist[bb.index] = true
+        }
+
+        while (worklist.isNotEmpty()) {
+            val bb = worklist.removeFirst()
+            inWorklist[bb.index] = false
+
+            // live_out = ∪ succ.live_in
+            val out = liveOut[bb.index]!!
+            for (succ in bb.successors()) {
+                out.union(liveIn[succ.index]!!)
+            }
 
-                // union = (b.old_live_in ∪ b.old_live_out
-                // live_in = (union – b.live_kill) ∪ b.live_gen
-                bbLiveness.liveIn.addAll(liveOut)
+            // live_in = (live_out – live_kill) ∪ live_gen
+            val bbLiveIn = liveIn[bb.index]!!
+            val changed = bbLiveIn.union(gen[bb.index]!!) or bbLiveIn.unionDifference(out, kill[bb.index]!!)
+            if (!changed) {
+                continue
+            }
+
+            for (pred in bb.predecessors()) {
+                if (!reachable[pred.index] || inWorklist[pred.index]) {
+                    continue
+                }
 
-                val killGen = killGenSet[bb] ?: throw NoSuchElementException("No kill/gen set for block $bb")
-                bbLiveness.liveIn.removeAll(killGen.kill)
-                bbLiveness.liveIn.addAll(killGen.gen)
+                worklist.add(pred)
+                inWorklist[pred.index] = true
             }
-        } while (changed)
+        }
     }
 
     override fun run(): LivenessAnalysisInfo {
+        setupValues()
+        computeLocalLiveSets()
         computeGlobalLiveSets()
+
+        val emptySet = newVector()
+        val liveness = arrayOfNulls<LiveInfo>(blockCount)
+        for (bb in functionData) {
+            val bbLiveIn  = liveIn[bb.index] ?: emptySet
+            val bbLiveOut = liveOut[bb.index] ?: emptySet
+            liveness[bb.index] = LiveInfo(LiveSet(bbLiveIn, numbering, values), LiveSet(bbLiveOut, numbering, values))
+        }
+
         return LivenessAnalysisInfo(liveness, functionData.marker())
     }
 }
@@ -144,4 +221,4 @@ object LivenessAnalysisPassFabric: FunctionAnalysisPassFabric<LivenessAnalysisIn
     override fun create(functionData: FunctionData): LivenessAnalysisInfo {
         return LivenessAnalysis(functionData).run()
     }
-}
\ No newline at end of file
+}
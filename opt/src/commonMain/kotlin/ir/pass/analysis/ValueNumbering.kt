@@ -0,0 +1,73 @@
+package ir.pass.analysis
+
+import common.IdNumbering
+import ir.instruction.Instruction
+import ir.module.FunctionData
+import ir.module.MutationMarker
+import ir.module.Sensitivity
+import ir.pass.common.AnalysisResult
+import ir.pass.common.AnalysisType
+import ir.pass.common.FunctionAnalysisPass
+import ir.pass.common.FunctionAnalysisPassFabric
+import ir.value.ArgumentValue
+import ir.value.LocalValue
+
+
+/**
+ * Dense numbering of local values of the function.
+ * Arguments take ids [0, arguments), instruction ids of every block follow as a contiguous range,
+ * so the id of an instruction is the base of its block plus [Instruction.identity].
+ */
+class ValueNumbering internal constructor(private val argumentsCount: Int, private val blockBase: IntArray, private val capacity: Int, marker: MutationMarker):
+    AnalysisResult(marker), IdNumbering<LocalValue> {
+    override fun capacity(): Int = capacity
+
+    override fun id(key: LocalValue): Int = when (key) {
+        is ArgumentValue -> key.position()
+        is Instruction -> {
+            val blockIndex = key.owner().index
+            if (blockIndex < blockBase.size) blockBase[blockIndex] + key.identity() else -1
+        }
+        else -> -1
+    }
+
+    override fun toString(): String = buildString {
+        append("arguments: $argumentsCount\n")
+        for ((index, base) in blockBase.withIndex()) {
+            append("L$index -> $base\n")
+        }
+    }
+}
+
+private class ValueNumberingBuilder(private val functionData: FunctionData): FunctionAnalysisPass<ValueNumbering>() {
+    override fun run(): ValueNumbering {
+        var maxBlockIndex = 0
+        for (bb in functionData) {
+            maxBlockIndex = maxOf(maxBlockIndex, bb.index)
+        }
+
+        val argumentsCount = functionData.arguments().size
+        val blockBase = IntArray(maxBlockIndex + 1)
+        var capacity = argumentsCount
+        for (bb in functionData) {
+            blockBase[bb.index] = capacity
+            capacity += bb.identityBound()
+        }
+
+        return ValueNumbering(argumentsCount, blockBase, capacity, functionData.marker())
+    }
+}
+
+object ValueNumberingFabric: FunctionAnalysisPassFabric<ValueNumbering>() {
+    override fun type(): AnalysisType {
+        return AnalysisType.VALUE_NUMBERING
+    }
+
+    override fun sensitivity(): Sensitivity {
+        return Sensitivity.CONTROL_AND_DATA_FLOW
+    }
+
+    override fun create(functionData: FunctionData): ValueNumbering {
+        return ValueNumberingBuilder(functionData).run()
+    }
+}
@@ -97,7 +97,9 @@ class VerifySSA private constructor(private val functionData: FunctionData,
     }
 
     private fun validateBlock(block: Block) {
-        assert(block.lastOrNull() is TerminateInstruction) { "Block '$block' must have a terminator." }
+        val last = block.lastOrNull()
+        assert(last is TerminateInstruction) { "Block '$block' must have a terminator." }
+        assert(last !is Callable || !last.isInBlock()) { "Block '$block' must not be terminated by in-block call." }
         bb = block
         validateInstructions(block)
     }
@@ -142,6 +144,12 @@ class VerifySSA private constructor(private val functionData: FunctionData,
                 validateDefUse(instruction, block)
             }
 
+            if (instruction is TerminateInstruction && instruction !== block.last()) {
+                assert(instruction is Callable && instruction.isInBlock()) {
+                    "Terminator '${instruction.dump()}' must be the last instruction in block '$block'."
+                }
+            }
+
             if (instruction is UsableValue) {
                 for (user in instruction.usedIn()) {
                     assert(user.containsOperand(instruction)) {
@@ -244,6 +252,12 @@ class VerifySSA private constructor(private val functionData: FunctionData,
         }
     }
 
+    override fun visit(bitop: BitOp) {
+        assert(BitOp.typeCheck(bitop)) {
+            "Instruction '${bitop.dump()}' requires integer operand of appropriate size: operand=${bitop.operand().type()}"
+        }
+    }
+
     override fun visit(branch: Branch) {
         val target = branch.target()
         val successors = bb.successors()
@@ -591,6 +605,12 @@ class VerifySSA private constructor(private val functionData: FunctionData,
         }
     }
 
+    override fun visit(memset: Memset) {
+        assert(Memset.typeCheck(memset)) {
+            "Instruction '${memset.dump()}' has inconsistent types."
+        }
+    }
+
     override fun visit(proj: Projection) {
         assert(Projection.typeCheck(proj)) {
             "Instruction '${proj.dump()}' has inconsistent types."
@@ -1,5 +1,6 @@
 package ir.pass.analysis.dominance
 
+import common.assertion
 import common.intMapOf
 import ir.module.FunctionData
 import ir.module.block.Block
@@ -10,100 +11,79 @@ import ir.pass.common.FunctionAnalysisPass
 
 
 sealed class DominatorCalculate<T: AnalysisResult>: FunctionAnalysisPass<T>() {
-    private fun initializeDominator(length: Int): MutableMap<Int, Int> {
-        val dominators = intMapOf<Int, Int>(length) { it }
-
-        for (idx in 0 until length) {
-            if (idx == length - 1) { /* this is first block */
-                dominators[length - 1] = length - 1
-            } else {
-                dominators[idx] = UNDEFINED
-            }
-        }
-
+    private fun initializeDominator(length: Int): IntArray {
+        val dominators = IntArray(length) { UNDEFINED }
+        dominators[length - 1] = length - 1 /* this is first block */
         return dominators
     }
 
-    private fun intersect(postDominators: Map<Int, Int>, _finger1: Int, _finger2: Int): Int {
+    private fun intersect(dominators: IntArray, _finger1: Int, _finger2: Int): Int {
         var finger1 = _finger1
         var finger2 = _finger2
 
         while (finger1 != finger2) {
             while (finger1 < finger2) {
-                finger1 = postDominators[finger1]!!
+                finger1 = dominators[finger1]
             }
 
             while (finger2 < finger1) {
-                finger2 = postDominators[finger2]!!
+                finger2 = dominators[finger2]
             }
         }
 
         return finger1
     }
 
-    private fun indexBlocks(blocksOrder: BlockOrder): Map<Block, Int> {
-        val blockToIndex = intMapOf<Block, Int>(blocksOrder.size) { it : Label -> it.index }
-        for ((idx, bb) in blocksOrder.withIndex()) {
-            blockToIndex[bb] = idx
-        }
-
-        return blockToIndex
-    }
-
-    private fun evaluateIdom(dominators: Map<Int, Int>, incomingMap: Map<Int, List<Int>>, idx: Int): Int {
-        val incoming = incomingMap[idx]!!
+    private fun evaluateIdom(dominators: IntArray, incoming: IntArray): Int {
+        var idom = UNDEFINED
+        for (pred in incoming) {
+            if (dominators[pred] == UNDEFINED) {
+                continue
+            }
 
-        val definedSuccessors = incoming.filter { dominators[it] != UNDEFINED }
-        return definedSuccessors.fold(definedSuccessors.first()) { idom, pred ->
-            intersect(dominators, pred, idom)
+            idom = if (idom == UNDEFINED) pred else intersect(dominators, pred, idom)
         }
+
+        assertion(idom != UNDEFINED) { "no processed incoming block" }
+        return idom
     }
 
-    private fun enumerationToEntryMap(blocks: BlockOrder, indexToBlock: Map<Int, Block>, dominators: MutableMap<Int, Int>): Map<Block, DomTreeEntry> {
-        val dominatorTree = intMapOf<Block, DomTreeEntryImpl>(blocks.size) { l: Label -> l.index }
-        for (key in dominators.keys) {
-            val block = indexToBlock[key]!!
-            dominatorTree[block] = DomTreeEntryImpl(null, block, hashSetOf())
+    private fun enumerationToEntryMap(blocks: BlockOrder, dominators: IntArray): MutableMap<Block, DomTreeEntry> {
+        val dominatorTree = intMapOf<Block, DomTreeEntry>(blocks.size) { l: Label -> l.index }
+        val entries = Array<DomTreeEntry>(blocks.size) { idx ->
+            val entry = DomTreeEntryImpl(null, blocks[idx], hashSetOf())
+            dominatorTree[blocks[idx]] = entry
+            entry
         }
 
-        dominators.remove(blocks.size - 1)
-        for ((key, value) in dominators) {
-            val block = indexToBlock[key]!!
-            val idom = indexToBlock[value]!!
-
-            val idomEntry = dominatorTree[idom]!!
-            dominatorTree[block]!!.iDom = idomEntry
-            idomEntry.dominates.add(dominatorTree[block]!!)
+        for (idx in 0 until blocks.size - 1) {
+            val entry = entries[idx]
+            val idomEntry = entries[dominators[idx]]
+            entry.iDom = idomEntry
+            idomEntry.dominates.add(entry)
         }
 
         return dominatorTree
     }
 
-    abstract fun calculateIncoming(postorder: BlockOrder, blockToIndex: Map<Block, Int>): Map<Int, List<Int>> //TODO not necessary to evaluate it
+    /**
+     * Positions of incoming blocks in the [order] for every block position.
+     */
+    abstract fun calculateIncoming(order: BlockOrder): Array<IntArray>
 
     abstract fun blockOrdering(basicBlocks: FunctionData): BlockOrder
 
-    private fun evalIndexToBlock(blockToIndex: Map<Block, Int>): Map<Int, Block> {
-        val indexToBlock = intMapOf<Int, Block>(blockToIndex.size) { it }
-        for ((key, value) in blockToIndex) {
-            indexToBlock[value] = key
-        }
-
-        return indexToBlock
-    }
-
-    fun calculate(basicBlocks: FunctionData): Map<Block, DomTreeEntry> {
+    fun calculate(basicBlocks: FunctionData): MutableMap<Block, DomTreeEntry> {
         val blocksOrder = blockOrdering(basicBlocks)
-        val blockToIndex = indexBlocks(blocksOrder)
 
         val length = blocksOrder.size
-        val predecessorsMap = calculateIncoming(blocksOrder, blockToIndex)
+        val predecessorsMap = calculateIncoming(blocksOrder)
         val dominators = initializeDominator(length)
         var changed = true
         while (changed) {
             changed = false
             for (idx in (0 until length - 1).reversed()) {
-                val newDom = evaluateIdom(dominators, predecessorsMap, idx)
+                val newDom = evaluateIdom(dominators, predecessorsMap[idx])
 
                 if (newDom != dominators[idx]) {
                     dominators[idx] = newDom
@@ -112,8 +92,7 @@ sealed class DominatorCalculate<T: AnalysisResult>: FunctionAnalysisPass<T>() {
             }
         }
 
-        val indexToBlock = evalIndexToBlock(blockToIndex)
-        return enumerationToEntryMap(blocksOrder, indexToBlock, dominators)
+        return enumerationToEntryMap(blocksOrder, dominators)
     }
 
     companion object {
@@ -3,14 +3,57 @@ package ir.pass.analysis.dominance
 import ir.module.MutationMarker
 import ir.module.block.Label
 import ir.module.block.Block
+import common.assertion
+import common.intMapOf
 
-class DominatorTree internal constructor(head: DomTreeEntry, bbToEntry: Map<Block, DomTreeEntry>, marker: MutationMarker): AnyDominatorTree(head,bbToEntry, marker) {
+class DominatorTree internal constructor(private val head: DomTreeEntry, private val entries: MutableMap<Block, DomTreeEntry>, marker: MutationMarker): AnyDominatorTree(head, entries, marker) {
+    // Preorder and postorder numbers of the tree nodes by block index, built on the first query.
+    private var enter: IntArray? = null
+    private var exit: IntArray? = null
+
+    /**
+     * Constant time check: [dominator] is an ancestor of [target] iff its preorder-postorder interval encloses the target's one.
+     */
     fun dominates(dominator: Label, target: Label): Boolean {
-        for (entry in traverseDominators(target)) {
-            if (entry == dominator) return true
+        val enter = enter ?: numberEntries()
+        val exit = exit!!
+        if (target.index >= enter.size || enter[target.index] == UNNUMBERED) {
+            throw NoSuchElementException("No dominator tree entry for '$target'")
+        }
+        if (dominator.index >= enter.size || enter[dominator.index] == UNNUMBERED) {
+            return false
+        }
+
+        return enter[dominator.index] <= enter[target.index] && exit[target.index] <= exit[dominator.index]
+    }
+
+    private fun numberEntries(): IntArray {
+        var maxIndex = 0
+        for (bb in entries.keys) {
+            maxIndex = maxOf(maxIndex, bb.index)
         }
 
-        return false
+        val enter = IntArray(maxIndex + 1) { UNNUMBERED }
+        val exit = IntArray(maxIndex + 1) { UNNUMBERED }
+        var counter = 0
+        val stack = arrayListOf(head to head.dominates.iterator())
+        enter[head.bb.index] = counter++
+        while (stack.isNotEmpty()) {
+            val (entry, children) = stack.last()
+            if (!children.hasNext()) {
+                exit[entry.bb.index] = counter++
+                stack.removeLast()
+                continue
+            }
+
+            val child = children.next()
+            enter[child.bb.index] = counter++
+            stack.add(child to child.dominates.iterator())
+        }
+
+        this.enter = enter
+        this.exit = exit
+        return enter
     }
 
     fun dominators(target: Block): Iterator<Block> = traverseDominators(target)
@@ -44,4 +87,47 @@ class DominatorTree internal constructor(head: DomTreeEntry, bbToEntry: Map<Bloc
 
         return dominanceFrontiers
     }
-}
\ No newline at end of file
+
+    /**
+     * Incremental update after [inserted] block was placed on the edge [from] -> [to].
+     * The only predecessor of [inserted] is [from], so it is immediately dominated by [from].
+     * [to] keeps another incoming edge, so dominators of the existing blocks don't change.
+     */
+    internal fun splitEdge(from: Block, inserted: Block, to: Block) {
+        assertion(inserted.predecessors().size == 1 && inserted.successors().singleOrNull() == to) {
+            "bb=$inserted must be placed on the edge $from -> $to"
+        }
+
+        val idom = entries[from] ?: throw NoSuchElementException("No dominator tree entry for '$from'")
+        val entry = DomTreeEntryImpl(idom, inserted, hashSetOf())
+        idom.dominates.add(entry)
+        entries[inserted] = entry
+        enter = null
+        exit = null
+    }
+
+    /**
+     * Rebuilds the tree over blocks of a copied function, [oldToNew] maps original blocks to their copies.
+     */
+    internal fun copy(oldToNew: Map<Block, Block>, marker: MutationMarker): DominatorTree {
+        val newEntries = intMapOf<Block, DomTreeEntry>(entries.size) { l: Label -> l.index }
+        for (old in entries.keys) {
+            val bb = oldToNew[old]!!
+            newEntries[bb] = DomTreeEntryImpl(null, bb, hashSetOf())
+        }
+
+        for ((old, entry) in entries) {
+            val idom = entry.iDom ?: continue
+            val newEntry = newEntries[oldToNew[old]!!]!!
+            val newIdom = newEntries[oldToNew[idom.bb]!!]!!
+            newEntry.iDom = newIdom
+            newIdom.dominates.add(newEntry)
+        }
+
+        return DominatorTree(newEntries[oldToNew[head.bb]!!]!!, newEntries, marker)
+    }
+
+    companion object {
+        private const val UNNUMBERED = -1
+    }
+}
@@ -3,7 +3,6 @@ package ir.pass.analysis.dominance
 import common.assertion
 import ir.module.FunctionData
 import ir.module.Sensitivity
-import ir.module.block.Block
 import ir.pass.analysis.traverse.BlockOrder
 import ir.pass.analysis.traverse.PostOrderFabric
 import ir.pass.common.AnalysisType
@@ -13,25 +12,16 @@ import ir.pass.common.FunctionAnalysisPassFabric
 private class DominatorTreeCalculate(private val basicBlocks: FunctionData) : DominatorCalculate<DominatorTree>() {
     private val postorder = basicBlocks.analysis(PostOrderFabric)
 
-    override fun calculateIncoming(postorder: BlockOrder, blockToIndex: Map<Block, Int>): Map<Int, List<Int>> {
-        val predecessors = hashMapOf<Int, List<Int>>()
-
-        for (bb in postorder) {
+    override fun calculateIncoming(order: BlockOrder): Array<IntArray> {
+        return Array(order.size) { idx ->
+            val bb = order[idx]
             val blockPredecessors = bb.predecessors()
-            if (blockPredecessors.isEmpty()) {
-                continue
-            }
-
-            val idx = blockToIndex[bb]
-            assertion(idx != null) { "Block not found in index: bb=${bb}" }
-            predecessors[idx!!] = blockPredecessors.map {
-                val i = blockToIndex[it]
-                assertion(i != null) { "Block not found in index: predecessor=$it, bb=${bb}" }
-                i!!
+            IntArray(blockPredecessors.size) { i ->
+                val position = order.indexOf(blockPredecessors[i])
+                assertion(position != -1) { "Block not found in index: predecessor=${blockPredecessors[i]}, bb=${bb}" }
+                position
             }
         }
-
-        return predecessors
     }
 
     override fun blockOrdering(basicBlocks: FunctionData): BlockOrder {
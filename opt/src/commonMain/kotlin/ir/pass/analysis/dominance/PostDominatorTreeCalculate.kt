@@ -2,7 +2,6 @@ package ir.pass.analysis.dominance
 
 import ir.module.FunctionData
 import ir.module.Sensitivity
-import ir.module.block.Block
 import ir.pass.analysis.traverse.BackwardPostOrderFabric
 import ir.pass.analysis.traverse.BlockOrder
 import ir.pass.common.AnalysisType
@@ -12,19 +11,11 @@ import ir.pass.common.FunctionAnalysisPassFabric
 private class PostDominatorTreeCalculate(private val basicBlocks: FunctionData) : DominatorCalculate<PostDominatorTree>() {
     private val backwardPostorder = basicBlocks.analysis(BackwardPostOrderFabric)
 
-    override fun calculateIncoming(postorder: BlockOrder, blockToIndex: Map<Block, Int>): Map<Int, List<Int>> {
-        val successors = hashMapOf<Int, List<Int>>()
-
-        for (bb in postorder) {
-            val blockSuccessors = bb.successors()
-            if (blockSuccessors.isEmpty()) {
-                continue
-            }
-
-            successors[blockToIndex[bb]!!] = blockSuccessors.map { blockToIndex[it]!! }
+    override fun calculateIncoming(order: BlockOrder): Array<IntArray> {
+        return Array(order.size) { idx ->
+            val blockSuccessors = order[idx].successors()
+            IntArray(blockSuccessors.size) { i -> order.indexOf(blockSuccessors[i]) }
         }
-
-        return successors
     }
 
     override fun blockOrdering(basicBlocks: FunctionData): BlockOrder {
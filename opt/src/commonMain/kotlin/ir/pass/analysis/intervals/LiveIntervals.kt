@@ -9,9 +9,15 @@ import ir.platform.x64.pass.analysis.regalloc.Group
 
 data class LiveIntervalsException(override val message: String): Exception(message)
 
-class LiveIntervals(private val liveIntervals: Map<LocalValue, LiveRange>, private val valueToGroup: Map<LocalValue, Group>, marker: MutationMarker): AnalysisResult(marker) {
+/**
+ * Live ranges of local values. [iterator] yields them sorted by the beginning of the range.
+ */
+class LiveIntervals(private val liveIntervals: Map<LocalValue, LiveRange>,
+                    private val sortedIntervals: List<Map.Entry<LocalValue, LiveRange>>,
+                    private val valueToGroup: Map<LocalValue, Group>,
+                    marker: MutationMarker): AnalysisResult(marker) {
     override fun toString(): String = buildString {
-        for ((v, ranges) in liveIntervals) {
+        for ((v, ranges) in sortedIntervals) {
             append("$v -> $ranges\n")
         }
     }
@@ -30,6 +36,6 @@ class LiveIntervals(private val liveIntervals: Map<LocalValue, LiveRange>, priva
     }
 
     operator fun iterator(): Iterator<Map.Entry<LocalValue, LiveRange>> {
-        return liveIntervals.iterator()
+        return sortedIntervals.iterator()
     }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 package ir.pass.analysis.intervals
 
 import common.assertion
+import common.idMapOf
 import ir.instruction.Copy
 import ir.value.LocalValue
 import ir.module.FunctionData
@@ -13,16 +14,18 @@ import ir.module.Sensitivity
 import ir.pass.common.FunctionAnalysisPass
 import ir.pass.common.FunctionAnalysisPassFabric
 import ir.pass.analysis.LivenessAnalysisPassFabric
-import ir.pass.analysis.traverse.PreOrderFabric
+import ir.pass.analysis.ValueNumberingFabric
+import ir.pass.analysis.traverse.LinearScanOrderFabric
 import ir.pass.common.AnalysisType
 import ir.platform.x64.pass.analysis.regalloc.Group
 import ir.value.TupleValue
 
 
 private class LiveIntervalsBuilder(private val data: FunctionData): FunctionAnalysisPass<LiveIntervals>() {
-    private val intervals       = hashMapOf<LocalValue, LiveRangeImpl>()
-    private val groups          = hashMapOf<LocalValue, Group>()
-    private val linearScanOrder = data.analysis(PreOrderFabric)
+    private val numbering       = data.analysis(ValueNumberingFabric)
+    private val intervals       = idMapOf<LocalValue, LiveRangeImpl>(numbering)
+    private val groups          = idMapOf<LocalValue, Group>(numbering)
+    private val linearScanOrder = data.analysis(LinearScanOrderFabric)
     private val liveness        = data.analysis(LivenessAnalysisPassFabric)
 
     private fun setupArguments() {
@@ -34,16 +37,14 @@ private class LiveIntervalsBuilder(private val data: FunctionData): FunctionAnal
     }
 
     private fun setupLiveRanges() {
-        var ordering = -1
-        for (bb in linearScanOrder) {
+        for (bb in linearScanOrder.blocks()) {
             for (inst in bb) {
-                ordering += 1
                 if (inst !is LocalValue) {
                     continue
                 }
 
                 /** New definition. */
-                intervals[inst] = LiveRangeImpl(ordering)
+                intervals[inst] = LiveRangeImpl(linearScanOrder.position(inst))
             }
         }
     }
@@ -60,22 +61,19 @@ private class LiveIntervalsBuilder(private val data: FunctionData): FunctionAnal
     }
 
     private fun evaluateUsages() {
-        var ordering = -1
-        for (bb in linearScanOrder) {
+        for (bb in linearScanOrder.blocks()) {
             // TODO Improvement: skip this step if CFG doesn't have any loops.
+            val end = linearScanOrder.end(bb)
             for (op in liveness.liveOut(bb)) {
                 val liveRange = intervals[op] ?: let {
                     throw LiveIntervalsException("cannot find $op")
                 }
 
-                val index = bb.size
-                liveRange.registerUsage(ordering + index)
+                liveRange.registerUsage(end)
             }
 
             for (inst in bb) {
-                ordering += 1
-
-                updateLiveRange(inst, ordering)
+                updateLiveRange(inst, linearScanOrder.position(inst))
             }
         }
     }
@@ -93,7 +91,7 @@ private class LiveIntervalsBuilder(private val data: FunctionData): FunctionAnal
             intervals[used] = range
             groupList.add(used)
         }
-        assertion(phi.usedIn().size == 1) {
+        assertion(phi.uses.size == 1) {
             "phi=$phi, usedIn=${phi.usedIn()}"
         }
 
@@ -117,7 +115,7 @@ private class LiveIntervalsBuilder(private val data: FunctionData): FunctionAnal
     }
 
     private fun mergeInstructionIntervals() {
-        for ((value, range) in intervals) {
+        intervals.forEachEntry { value, range ->
             when (value) {
                 is Phi -> handlePhiOperands(value, range)
                 is TupleValue -> handleTuple(value, range)
@@ -131,17 +129,11 @@ private class LiveIntervalsBuilder(private val data: FunctionData): FunctionAnal
         evaluateUsages()
         mergeInstructionIntervals()
 
-        return LiveIntervals(sortIntervals(), groups, data.marker())
+        return LiveIntervals(intervals, sortIntervals(), groups, data.marker())
     }
 
-    private fun sortIntervals(): Map<LocalValue, LiveRange> {
-        val sorted = intervals.toList().sortedBy { it.second.begin() }
-        val linkedMap = linkedMapOf<LocalValue, LiveRange>()
-        for ((v, r) in sorted) {
-            linkedMap[v] = r
-        }
-
-        return linkedMap
+    private fun sortIntervals(): List<Map.Entry<LocalValue, LiveRange>> {
+        return intervals.entries.sortedBy { it.value.begin() }
     }
 }
 
@@ -1,11 +1,31 @@
 package ir.pass.analysis.traverse
 
+import common.ArrayWrapper
 import ir.module.MutationMarker
 import ir.module.block.Block
+import ir.module.block.Label
 import ir.pass.common.AnalysisResult
 
 
-class BlockOrder internal constructor(private val order: List<Block>, marker: MutationMarker): AnalysisResult(marker), Collection<Block> {
+/**
+ * Immutable sequence of blocks. Position of a block in the order is looked up by [Label.index] without a walk.
+ */
+class BlockOrder internal constructor(order: List<Block>, marker: MutationMarker): AnalysisResult(marker), Collection<Block> {
+    private val order: Array<Block> = order.toTypedArray()
+    private val positions: IntArray = run {
+        var maxIndex = -1
+        for (bb in this.order) {
+            maxIndex = maxOf(maxIndex, bb.index)
+        }
+
+        val positions = IntArray(maxIndex + 1) { NOT_FOUND }
+        for ((position, bb) in this.order.withIndex()) {
+            positions[bb.index] = position
+        }
+
+        positions
+    }
+
     override fun toString(): String = buildString {
         for (bb in order) {
             append("BB: $bb\n")
@@ -23,15 +43,39 @@ class BlockOrder internal constructor(private val order: List<Block>, marker: Mu
         return order[index]
     }
 
+    /**
+     * Position of the [label] in the order or -1 if the block isn't contained.
+     */
+    fun indexOf(label: Label): Int {
+        val index = label.index
+        if (index < 0 || index >= positions.size) {
+            return NOT_FOUND
+        }
+
+        return positions[index]
+    }
+
     override fun isEmpty(): Boolean {
         return order.isEmpty()
     }
 
     override fun containsAll(elements: Collection<Block>): Boolean {
-        return order.containsAll(elements)
+        return elements.all { contains(it) }
     }
 
     override fun contains(element: Block): Boolean {
-        return order.contains(element)
+        val position = indexOf(element)
+        return position != NOT_FOUND && order[position] === element
+    }
+
+    /**
+     * Blocks in reversed order.
+     */
+    fun reversed(): List<Block> {
+        return ArrayWrapper(order.reversedArray())
+    }
+
+    companion object {
+        private const val NOT_FOUND = -1
     }
-}
\ No newline at end of file
+}
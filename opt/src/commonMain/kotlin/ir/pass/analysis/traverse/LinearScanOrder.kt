@@ -0,0 +1,109 @@
+package ir.pass.analysis.traverse
+
+import ir.instruction.Instruction
+import ir.module.FunctionData
+import ir.module.MutationMarker
+import ir.module.Sensitivity
+import ir.module.block.Block
+import ir.module.block.Label
+import ir.pass.common.AnalysisResult
+import ir.pass.common.AnalysisType
+import ir.pass.common.FunctionAnalysisPass
+import ir.pass.common.FunctionAnalysisPassFabric
+
+
+/**
+ * Global numbering of instructions in the preorder of blocks.
+ * Instructions of a block occupy the contiguous range [begin(bb), end(bb)].
+ */
+class LinearScanOrder internal constructor(private val blocks: BlockOrder,
+                                           private val blockBegin: IntArray,
+                                           private val identityBase: IntArray,
+                                           private val positions: IntArray,
+                                           marker: MutationMarker): AnalysisResult(marker) {
+    fun blocks(): BlockOrder = blocks
+
+    /**
+     * Position of the first instruction of the [bb].
+     */
+    fun begin(bb: Label): Int = blockBegin[blocks.indexOf(bb)]
+
+    /**
+     * Position of the last instruction of the [bb].
+     */
+    fun end(bb: Label): Int = blockBegin[blocks.indexOf(bb) + 1] - 1
+
+    /**
+     * Position of the [instruction] or -1 if its block isn't reachable.
+     */
+    fun position(instruction: Instruction): Int {
+        val index = instruction.owner().index
+        if (index >= identityBase.size || identityBase[index] < 0) {
+            return -1
+        }
+
+        return positions[identityBase[index] + instruction.identity()]
+    }
+
+    fun size(): Int = blockBegin.last()
+
+    override fun toString(): String = buildString {
+        for (bb in blocks) {
+            append("BB: $bb [${begin(bb)}, ${end(bb)}]\n")
+        }
+    }
+}
+
+private class LinearScanOrderPass(private val functionData: FunctionData): FunctionAnalysisPass<LinearScanOrder>() {
+    private val preorder = functionData.analysis(PreOrderFabric)
+
+    override fun run(): LinearScanOrder {
+        var maxIndex = -1
+        for (bb in preorder) {
+            maxIndex = maxOf(maxIndex, bb.index)
+        }
+
+        // Positions are stored by (identityBase[bb] + identity), identities of a block are dense.
+        val identityBase = IntArray(maxIndex + 1) { -1 }
+        var identities = 0
+        for (bb in preorder) {
+            identityBase[bb.index] = identities
+            identities += bb.identityBound()
+        }
+
+        val blockBegin = IntArray(preorder.size + 1)
+        val positions = IntArray(identities)
+        var position = 0
+        for ((idx, bb) in preorder.withIndex()) {
+            blockBegin[idx] = position
+            position = numberInstructions(bb, identityBase[bb.index], positions, position)
+        }
+        blockBegin[preorder.size] = position
+
+        return LinearScanOrder(preorder, blockBegin, identityBase, positions, functionData.marker())
+    }
+
+    private fun numberInstructions(bb: Block, base: Int, positions: IntArray, begin: Int): Int {
+        var position = begin
+        for (inst in bb) {
+            positions[base + inst.identity()] = position
+            position += 1
+        }
+
+        return position
+    }
+}
+
+object LinearScanOrderFabric : FunctionAnalysisPassFabric<LinearScanOrder>() {
+    override fun type(): AnalysisType {
+        return AnalysisType.LINEAR_SCAN_ORDER
+    }
+
+    override fun sensitivity(): Sensitivity {
+        return Sensitivity.CONTROL_AND_DATA_FLOW
+    }
+
+    override fun create(functionData: FunctionData): LinearScanOrder {
+        return LinearScanOrderPass(functionData).run()
+    }
+}
@@ -31,7 +31,9 @@ enum class AnalysisType {
     BACKWARD_POST_ORDER,
     BFS_ORDER,
     CALL_INFO,
-    LINEAR_SCAN;
+    LINEAR_SCAN,
+    OMIT_FRAME_POINTER_LINEAR_SCAN,
+    VALUE_NUMBERING;
 
     companion object {
         fun size(): Int = entries.size
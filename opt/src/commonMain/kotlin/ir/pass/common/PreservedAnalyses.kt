@@ -0,0 +1,42 @@
+package ir.pass.common
+
+
+/**
+ * Analyses which a transformation keeps valid, either untouched or updated incrementally.
+ * Cached results of these analyses survive the mutations made by the transformation.
+ */
+class PreservedAnalyses private constructor(private val preserved: BooleanArray) {
+    fun isPreserved(type: AnalysisType): Boolean = preserved[type.ordinal]
+
+    fun isEmpty(): Boolean = preserved.none { it }
+
+    companion object {
+        private val NONE = PreservedAnalyses(BooleanArray(AnalysisType.size()))
+        private val CFG = of(
+            AnalysisType.DOMINATOR_TREE,
+            AnalysisType.POST_DOMINATOR_TREE,
+            AnalysisType.LOOP_INFO,
+            AnalysisType.POST_ORDER,
+            AnalysisType.PRE_ORDER,
+            AnalysisType.BACKWARD_POST_ORDER,
+            AnalysisType.BFS_ORDER
+        )
+
+        fun none(): PreservedAnalyses = NONE
+
+        /**
+         * Analyses computed from blocks and edges alone. Transformations which never add or remove
+         * blocks and edges keep them valid, even when they bump the control flow counter.
+         */
+        fun cfg(): PreservedAnalyses = CFG
+
+        fun of(vararg types: AnalysisType): PreservedAnalyses {
+            val preserved = BooleanArray(AnalysisType.size())
+            for (type in types) {
+                preserved[type.ordinal] = true
+            }
+
+            return PreservedAnalyses(preserved)
+        }
+    }
+}
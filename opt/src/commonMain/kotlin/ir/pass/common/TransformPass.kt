@@ -1,5 +1,6 @@
 package ir.pass.common
 
+import ir.module.FunctionData
 import ir.module.Module
 import ir.pass.CompileContext
 
@@ -7,4 +8,26 @@ import ir.pass.CompileContext
 abstract class TransformPass<M: Module<*>>(protected val module: M, protected val ctx: CompileContext) {
     abstract fun name(): String
     abstract fun run(): M
+
+    /**
+     * Analyses which [run] keeps valid, like LLVM's PreservedAnalyses.
+     * By default a cached result survives only mutations its sensitivity ignores.
+     */
+    open fun preservedAnalyses(): PreservedAnalyses = PreservedAnalyses.none()
+
+    /**
+     * Runs the pass so that cached results of [preservedAnalyses] stay valid after it.
+     */
+    fun runPreserving(): M {
+        val preserved = preservedAnalyses()
+        val functions = module.functions().filterIsInstance<FunctionData>()
+        val valid = functions.map { it.cache().validAnalyses(preserved, it.marker()) }
+
+        val result = run()
+        for ((fn, types) in functions.zip(valid)) {
+            fn.cache().revalidate(types, fn.marker())
+        }
+
+        return result
+    }
 }
\ No newline at end of file
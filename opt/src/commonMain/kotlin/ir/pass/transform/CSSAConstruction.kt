@@ -4,6 +4,8 @@ import ir.module.SSAModule
 import ir.pass.CompileContext
 import ir.pass.common.TransformPassFabric
 import ir.pass.common.TransformPass
+import ir.pass.common.AnalysisType
+import ir.pass.common.PreservedAnalyses
 import ir.pass.transform.auxiliary.CopyInsertion
 import ir.pass.transform.auxiliary.SplitCriticalEdge
 
@@ -11,10 +13,17 @@ import ir.pass.transform.auxiliary.SplitCriticalEdge
 class CSSAConstruction internal constructor(module: SSAModule, ctx: CompileContext): TransformPass<SSAModule>(module, ctx) {
     override fun name(): String = "cssa-construction"
 
+    override fun preservedAnalyses(): PreservedAnalyses = PRESERVED
+
     override fun run(): SSAModule {
         val transformed = CopyInsertion.run(SplitCriticalEdge.run(module), ctx)
         return SSAModule(transformed.functions, transformed.externFunctions, transformed.constantPool, transformed.globals, transformed.types)
     }
+
+    companion object {
+        // Split critical edges update the dominator tree, copy insertion doesn't change control flow.
+        private val PRESERVED = PreservedAnalyses.of(AnalysisType.DOMINATOR_TREE)
+    }
 }
 
 object CSSAConstructionFabric: TransformPassFabric<SSAModule>() {
@@ -9,6 +9,7 @@ import ir.module.SSAModule
 import ir.pass.CompileContext
 import ir.pass.common.TransformPass
 import ir.pass.common.TransformPassFabric
+import ir.pass.common.PreservedAnalyses
 import ir.value.ArgumentValue
 import ir.value.LocalValue
 import ir.value.constant.UndefValue
@@ -16,6 +17,9 @@ import ir.value.constant.UndefValue
 
 class DeadCodeEliminationPass internal constructor(module: SSAModule, ctx: CompileContext): TransformPass<SSAModule>(module, ctx) {
     override fun name(): String = "dce"
+
+    override fun preservedAnalyses(): PreservedAnalyses = PreservedAnalyses.cfg()
+
     override fun run(): SSAModule {
         module.functions.values.forEach { fnData ->
             DeadCodeEliminationPassImpl(fnData).pass()
@@ -45,7 +49,7 @@ internal class DeadCodeEliminationPassImpl(private val cfg: FunctionData) {
             // TODO: handle projection correctly
             return true
         }
-        if (vInst.usedIn().isNotEmpty()) {
+        if (!vInst.uses.isEmpty()) {
             return true
         }
 
@@ -0,0 +1,117 @@
+package ir.pass.transform
+
+import ir.attributes.GlobalValueAttribute
+import ir.global.AnyGlobalValue
+import ir.global.GlobalConstant
+import ir.global.GlobalSymbol
+import ir.global.GlobalValue
+import ir.instruction.Callable
+import ir.module.DirectFunctionPrototype
+import ir.module.FunctionData
+import ir.module.SSAModule
+import ir.pass.CompileContext
+import ir.pass.common.TransformPass
+import ir.pass.common.TransformPassFabric
+import ir.pass.common.PreservedAnalyses
+import ir.value.constant.Constant
+import ir.value.constant.InitializerListValue
+import ir.value.constant.PointerLiteral
+
+
+class DeadGlobalEliminationPass internal constructor(module: SSAModule, ctx: CompileContext): TransformPass<SSAModule>(module, ctx) {
+    override fun name(): String = "dge"
+
+    override fun preservedAnalyses(): PreservedAnalyses = PreservedAnalyses.cfg()
+
+    override fun run(): SSAModule {
+        return DeadGlobalEliminationPassImpl(module).pass()
+    }
+}
+
+/**
+ * Removes internal functions, internal globals and constants unreachable from externally visible symbols.
+ * The module must hold the whole translation unit, so the pass is not applicable to streamed functions.
+ */
+object DeadGlobalElimination: TransformPassFabric<SSAModule>() {
+    override fun create(module: SSAModule, ctx: CompileContext): TransformPass<SSAModule> {
+        return DeadGlobalEliminationPass(module, ctx)
+    }
+}
+
+/**
+ * Symbols are tracked by name, because initializers may point to a global through its forward declaration.
+ */
+private class DeadGlobalEliminationPassImpl(private val module: SSAModule) {
+    private val live = hashSetOf<String>()
+    private val worklist = arrayListOf<String>()
+
+    private fun markLive(symbol: GlobalSymbol) {
+        if (live.add(symbol.name())) {
+            worklist.add(symbol.name())
+        }
+    }
+
+    private fun markConstant(constant: Constant) {
+        when (constant) {
+            is PointerLiteral       -> markLive(constant.gConstant)
+            is InitializerListValue -> constant.elements.forEach { markConstant(it) }
+            else -> {}
+        }
+    }
+
+    private fun markFunction(fd: FunctionData) {
+        for (bb in fd) {
+            for (inst in bb) {
+                if (inst is Callable) {
+                    val prototype = inst.prototype()
+                    if (prototype is DirectFunctionPrototype) {
+                        markLive(prototype)
+                    }
+                }
+
+                for (operand in inst.operands()) {
+                    when (operand) {
+                        is GlobalSymbol -> markLive(operand)
+                        is Constant     -> markConstant(operand)
+                    }
+                }
+            }
+        }
+    }
+
+    private fun setup() {
+        for (fd in module.functions()) {
+            if (!fd.prototype.attributes.contains(GlobalValueAttribute.INTERNAL)) {
+                markLive(fd.prototype)
+            }
+        }
+        for (global in module.globals.values) {
+            if (global is GlobalValue && global.attribute() != GlobalValueAttribute.INTERNAL) {
+                markLive(global)
+            }
+        }
+    }
+
+    private fun isDead(global: AnyGlobalValue): Boolean {
+        return global is GlobalValue && global.attribute() == GlobalValueAttribute.INTERNAL && !live.contains(global.name())
+    }
+
+    fun pass(): SSAModule {
+        setup()
+        while (worklist.isNotEmpty()) {
+            val name = worklist.removeLast()
+            module.functions[name]?.let { markFunction(it) }
+            (module.globals[name] as? GlobalValue)?.let { markConstant(it.initializer()) }
+            module.constantPool[name]?.let { markConstant(it.constant()) }
+        }
+
+        val functions = module.functions.filterValues { live.contains(it.name()) }
+        if (functions.size == module.functions.size && module.constantPool.keys.all { live.contains(it) } && module.globals.values.none { isDead(it) }) {
+            return module
+        }
+
+        val constantPool = module.constantPool.filterTo(hashMapOf<String, GlobalConstant>()) { live.contains(it.key) }
+        val globals = module.globals.filterValues { !isDead(it) }
+        return SSAModule(functions, module.externFunctions, constantPool, globals, module.types)
+    }
+}
@@ -8,6 +8,7 @@ import ir.module.SSAModule
 import ir.module.block.Block
 import ir.pass.CompileContext
 import ir.pass.common.TransformPassFabric
+import ir.pass.common.PreservedAnalyses
 import ir.pass.common.TransformPass
 import ir.pass.analysis.JoinPointSetPassFabric
 import ir.pass.analysis.dominance.DominatorTreeFabric
@@ -23,6 +24,9 @@ import ir.value.constant.UndefValue
 
 class Mem2Reg internal constructor(module: SSAModule, ctx: CompileContext): TransformPass<SSAModule>(module, ctx) {
     override fun name(): String = "mem2reg"
+
+    override fun preservedAnalyses(): PreservedAnalyses = PreservedAnalyses.cfg()
+
     override fun run(): SSAModule {
         module.functions.values.forEach { fnData ->
             val dominatorTree = fnData.analysis(DominatorTreeFabric)
@@ -11,7 +11,8 @@ import ir.platform.x64.auxiliary.Lowering
 class SSADestruction(module: SSAModule, ctx: CompileContext): TransformPass<SSAModule>(module, ctx) {
     override fun name(): String = "ssa-destruction"
     override fun run(): SSAModule {
-        val transformed = Lowering.run(FunctionsIsolation.run(module, ctx), ctx)
+        val lowered = Lowering.run(FunctionsIsolation.run(module, ctx), ctx)
+        val transformed = if (ctx.inBlockCalls()) FuseCallBlocks.run(lowered) else lowered
         return SSAModule(transformed.functions, transformed.externFunctions, transformed.constantPool, transformed.globals, transformed.types)
     }
 }
@@ -0,0 +1,62 @@
+package ir.pass.transform.auxiliary
+
+import ir.instruction.*
+import ir.module.FunctionData
+import ir.module.SSAModule
+import ir.module.block.Block
+import ir.module.block.Label
+import ir.pass.analysis.traverse.PreOrderFabric
+
+
+/**
+ * Turns calls into ordinary in-block instructions.
+ * The continuation block of the call is merged into the block of the call if it has the only predecessor.
+ * Must be run after [ir.platform.x64.auxiliary.Lowering] since the earlier passes rely on the call continuation.
+ */
+internal class FuseCallBlocks private constructor(private val cfg: FunctionData) {
+    private fun canBeFused(bb: Block, last: TerminateInstruction): Boolean {
+        if (last !is Callable) {
+            return false
+        }
+
+        val cont = last.target()
+        if (cont === bb || cont.index == Label.entry.index) {
+            return false
+        }
+        if (cont.predecessors().size != 1) {
+            return false
+        }
+
+        return cont.begin() !is Phi
+    }
+
+    private fun fuseBlock(bb: Block) {
+        while (true) {
+            val last = bb.last()
+            if (!canBeFused(bb, last)) {
+                return
+            }
+
+            val cont = bb.fuseContinuation(last as Callable)
+            cfg.blocks().removeBlock(cont)
+        }
+    }
+
+    fun pass() {
+        for (bb in cfg.analysis(PreOrderFabric)) {
+            if (bb.isEmpty()) {
+                // Already fused into its predecessor
+                continue
+            }
+
+            fuseBlock(bb)
+        }
+    }
+
+    companion object {
+        fun run(module: SSAModule): SSAModule {
+            module.functions().forEach { FuseCallBlocks(it).pass() }
+            return module
+        }
+    }
+}
@@ -4,9 +4,13 @@ import ir.instruction.Branch
 import ir.module.FunctionData
 import ir.module.SSAModule
 import ir.module.block.Block
+import ir.pass.analysis.dominance.DominatorTreeFabric
 
 
 internal class SplitCriticalEdge private constructor(private val functionData: FunctionData) {
+    // Cached dominator tree is updated incrementally instead of being recomputed after the pass.
+    private val dominatorTree = functionData.cache().get(DominatorTreeFabric, functionData.marker())
+
     fun pass() {
         val criticalEdgeBetween = hashMapOf<Block, MutableList<Block>>()
         for (bb in functionData) {
@@ -33,6 +37,7 @@ internal class SplitCriticalEdge private constructor(private val functionData: F
 
         val last = p.last()
         last.target(newBlock, bb)
+        dominatorTree?.splitEdge(p, newBlock, bb)
     }
 
     companion object {
@@ -182,6 +182,8 @@ internal object NormalizeInstruction: IRInstructionVisitor<Value>() {
 
     override fun visit(not: Not): Value = not
 
+    override fun visit(bitop: BitOp): Value = bitop
+
     override fun visit(branch: Branch): Value {
         TODO("Not yet implemented")
     }
@@ -359,6 +361,10 @@ internal object NormalizeInstruction: IRInstructionVisitor<Value>() {
         TODO("Not yet implemented")
     }
 
+    override fun visit(memset: Memset): Value {
+        TODO("Not yet implemented")
+    }
+
     override fun visit(indexedLoad: IndexedLoad): Value = indexedLoad
 
     override fun visit(store: StoreOnStack): Value {
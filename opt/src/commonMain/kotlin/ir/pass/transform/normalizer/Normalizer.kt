@@ -9,11 +9,15 @@ import ir.pass.CompileContext
 import ir.pass.analysis.traverse.PreOrderFabric
 import ir.pass.common.TransformPass
 import ir.pass.common.TransformPassFabric
+import ir.pass.common.PreservedAnalyses
 import ir.value.constant.UndefValue
 
 
 class NormalizerPass internal constructor(module: SSAModule, ctx: CompileContext): TransformPass<SSAModule>(module, ctx) {
     override fun name(): String = "normalizer"
+
+    override fun preservedAnalyses(): PreservedAnalyses = PreservedAnalyses.cfg()
+
     override fun run(): SSAModule {
         module.functions.values.forEach { fnData ->
             NormalizerPassImpl(fnData).pass()
@@ -33,13 +37,14 @@ internal class NormalizerPassImpl(private val cfg: FunctionData) {
     private val worklist = arrayListOf<LocalValue>()
     private val deadPool = hashSetOf<TupleDiv>()
 
-    private fun addToWorkList(operands: List<Instruction>) {
-        for (operand in operands) {
-            if (operand !is LocalValue) {
-                continue
+    private fun addUsersToWorkList(value: UsableValue) {
+        value.uses.forEach { use ->
+            val user = use.user
+            if (user !is LocalValue) {
+                return@forEach
             }
 
-            worklist.add(operand)
+            worklist.add(user)
         }
     }
 
@@ -50,7 +55,7 @@ internal class NormalizerPassImpl(private val cfg: FunctionData) {
             return vInst
         }
 
-        addToWorkList(vInst.usedIn())
+        addUsersToWorkList(vInst)
         vInst.updateUsages(new)
         if (vInst is TupleDiv) {
             deadPool.add(vInst)
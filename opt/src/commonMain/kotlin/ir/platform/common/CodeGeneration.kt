@@ -7,9 +7,11 @@ import ir.pass.PassPipeline
 import ir.pass.PassPipeline.Companion.create
 import ir.pass.transform.CSSAConstructionFabric
 import ir.pass.transform.DeadCodeElimination
+import ir.pass.transform.DeadGlobalElimination
 import ir.pass.transform.SSADestructionFabric
 import ir.platform.x64.LModule
 import ir.platform.x64.codegen.X64CodeGenerator
+import ir.platform.x64.codegen.X64CodeGenerationStream
 
 
 enum class TargetPlatform {
@@ -46,18 +48,59 @@ class CodeGenerationFactory {
             throw IllegalStateException("Compile context is not set")
         }
 
-        val transformed = beforeCodegen(ctx!!)
+        val transformed = beforeModuleCodegen(ctx!!)
             .run(module)
 
-        val preparedModule = LModule(transformed.functions, transformed.externFunctions, transformed.constantPool, transformed.globals, transformed.types)
+        return when (target as TargetPlatform) {
+            TargetPlatform.X64 -> X64CodeGenerator(prepare(transformed), ctx!!).emit()
+        }
+    }
+
+    fun stream(out: Appendable): CodeGenerationStream {
+        if (ctx == null) {
+            throw IllegalStateException("Compile context is not set")
+        }
 
         return when (target as TargetPlatform) {
-            TargetPlatform.X64 -> X64CodeGenerator(preparedModule, ctx!!).emit()
+            TargetPlatform.X64 -> CodeGenerationStream(ctx!!, X64CodeGenerationStream(ctx!!, out))
         }
     }
 
     companion object {
-        private fun beforeCodegen(ctx: CompileContext): PassPipeline = create("before-codegen", arrayListOf(CSSAConstructionFabric, SSADestructionFabric,
+        internal fun prepare(module: SSAModule): LModule {
+            return LModule(module.functions, module.externFunctions, module.constantPool, module.globals, module.types)
+        }
+
+        internal fun beforeCodegen(ctx: CompileContext): PassPipeline = create("before-codegen", arrayListOf(CSSAConstructionFabric, SSADestructionFabric,
             DeadCodeElimination), ctx)
+
+        /**
+         * The module holds the whole translation unit, so unreferenced internal symbols are dropped before lowering.
+         */
+        private fun beforeModuleCodegen(ctx: CompileContext): PassPipeline = create("before-codegen", arrayListOf(DeadGlobalElimination,
+            CSSAConstructionFabric, SSADestructionFabric, DeadCodeElimination), ctx)
+    }
+}
+
+/**
+ * Generates code of a translation unit function by function: functions of every module
+ * passed to [emit] are appended to the output right away, so their IR may be dropped afterward.
+ * Constants and globals are collected in the shared pool and emitted by [finish] with the last module.
+ */
+class CodeGenerationStream internal constructor(private val ctx: CompileContext, private val emitter: X64CodeGenerationStream) {
+    fun emit(module: SSAModule) {
+        val transformed = CodeGenerationFactory.beforeCodegen(ctx)
+            .run(module)
+
+        emitter.emitFunctions(CodeGenerationFactory.prepare(transformed))
+    }
+
+    fun finish(module: SSAModule) {
+        val transformed = CodeGenerationFactory.beforeCodegen(ctx)
+            .run(module)
+
+        val preparedModule = CodeGenerationFactory.prepare(transformed)
+        emitter.emitFunctions(preparedModule)
+        emitter.finish(preparedModule)
     }
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 package ir.platform.common
 
 
-interface CompiledModule
\ No newline at end of file
+interface CompiledModule {
+    fun emit(out: Appendable)
+}
\ No newline at end of file
@@ -127,4 +127,5 @@ object CallConvention {
 
     const val CONSTANT_POOL_PREFIX = ".LCP_"
     const val STACK_ALIGNMENT = 16L
+    const val RED_ZONE_SIZE = 128
 }
\ No newline at end of file
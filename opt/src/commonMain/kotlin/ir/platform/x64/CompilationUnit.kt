@@ -13,7 +13,9 @@ import ir.platform.x64.auxiliary.LinearizeInitializerList
 // The GNU Assembler
 //
 // https://ftp.gnu.org/old-gnu/Manuals/gas-2.9.1/html_node/as_toc.html
-class CompilationUnit: CompiledModule, ObjModule(NameAssistant()) {
+class CompilationUnit(nameAssistant: NameAssistant): CompiledModule, ObjModule(nameAssistant) {
+    constructor(): this(NameAssistant())
+
     fun mkConstant(globalConstant: GlobalConstant): ObjLabel = when (globalConstant) {
         is StringLiteralGlobalConstant -> {
             // name:
@@ -0,0 +1,33 @@
+package ir.platform.x64
+
+import ir.platform.x64.CpuFeature.*
+
+
+enum class CpuFeature {
+    POPCNT,
+    LZCNT,
+    BMI1
+}
+
+// Reference: https://gcc.gnu.org/onlinedocs/gcc/x86-Options.html
+enum class MArch(val archName: String, private val features: Set<CpuFeature>) {
+    X86_64("x86-64", setOf()),
+    X86_64_V2("x86-64-v2", setOf(POPCNT)),
+    X86_64_V3("x86-64-v3", setOf(POPCNT, LZCNT, BMI1)),
+    X86_64_V4("x86-64-v4", setOf(POPCNT, LZCNT, BMI1)),
+    NEHALEM("nehalem", setOf(POPCNT)),
+    HASWELL("haswell", setOf(POPCNT, LZCNT, BMI1)),
+    ZNVER1("znver1", setOf(POPCNT, LZCNT, BMI1)),
+    // Host features aren't detected, so 'native' is the baseline every x86-64 host supports
+    NATIVE("native", setOf());
+
+    fun has(feature: CpuFeature): Boolean = features.contains(feature)
+
+    override fun toString(): String = archName
+
+    companion object {
+        val DEFAULT = X86_64
+
+        fun of(name: String): MArch? = values().find { it.archName == name }
+    }
+}
@@ -22,7 +22,7 @@ import ir.pass.analysis.traverse.BfsOrderOrderFabric
 import ir.platform.x64.CallConvention
 
 
-internal class Lowering private constructor(private val cfg: FunctionData, private val module: SSAModule, private val ctx: CompileContext, private val idx: Int): IRInstructionVisitor<Instruction?>() {
+internal class Lowering private constructor(private val cfg: FunctionData, private val module: SSAModule, private val ctx: CompileContext): IRInstructionVisitor<Instruction?>() {
     private var bb: Block = cfg.begin()
     private var constantIndex = 0
 
@@ -34,7 +34,8 @@ internal class Lowering private constructor(private val cfg: FunctionData, priva
         module.addConstant(F64ConstantValue(constName(), F64_SUBZERO))
     }
 
-    private fun constName(): String = "${PREFIX}.$idx.${constantIndex++}"
+    // Function name keeps constant names unique when functions are lowered in separate modules.
+    private fun constName(): String = "${PREFIX}.${cfg.name()}.${constantIndex++}"
 
     private fun pass() {
         isolateArgumentValues()
@@ -237,6 +238,10 @@ internal class Lowering private constructor(private val cfg: FunctionData, priva
         return not
     }
 
+    override fun visit(bitop: BitOp): Instruction {
+        return bitop
+    }
+
     override fun visit(branch: Branch): Instruction {
         return branch
     }
@@ -1081,6 +1086,34 @@ internal class Lowering private constructor(private val cfg: FunctionData, priva
         return memcpy
     }
 
+    override fun visit(memset: Memset): Instruction {
+        val dst = memset.destination()
+        if (dst.isa(extern())) {
+            // Before:
+            //  memset @extern, %value, %size
+            //
+            // After:
+            //  %dst = copy PtrType, @extern
+            //  memset %dst, %value, %size
+
+            val copy = bb.putBefore(memset, Copy.copy(PtrType, dst))
+            memset.destination(copy)
+
+        } else if (dst.isa(gValue(anytype())) || dst.isa(gAggregate()) || dst.isa(stackAlloc())) {
+            // Before:
+            //  memset %dst, %value, %size
+            //
+            // After:
+            //  %lea = lea %dst
+            //  memset %lea, %value, %size
+
+            val lea = bb.putBefore(memset, Lea.lea(dst))
+            memset.destination(lea)
+        }
+
+        return memset
+    }
+
     override fun visit(indexedLoad: IndexedLoad): Instruction {
         return indexedLoad
     }
@@ -1240,8 +1273,8 @@ internal class Lowering private constructor(private val cfg: FunctionData, priva
         private const val PREFIX = CallConvention.CONSTANT_POOL_PREFIX
 
         fun run(module: SSAModule, context: CompileContext): SSAModule {
-            for ((idx, fn) in module.functions().withIndex()) {
-                Lowering(fn, module, context, idx).pass()
+            for (fn in module.functions()) {
+                Lowering(fn, module, context).pass()
             }
 
             return module
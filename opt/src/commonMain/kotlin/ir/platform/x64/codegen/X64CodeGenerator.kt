@@ -38,8 +38,11 @@ import ir.platform.common.AnyCodeGenerator
 import ir.platform.common.CompiledModule
 import ir.platform.x64.codegen.impl.*
 import ir.platform.x64.CallConvention.retReg
+import ir.platform.x64.pass.analysis.TailCallAnalysis
+import ir.platform.x64.pass.analysis.TailCallAnalysisResult
 import ir.platform.x64.pass.analysis.callinfo.CallInfoAnalysis
 import ir.platform.x64.pass.analysis.regalloc.LinearScanFabric
+import ir.platform.x64.pass.analysis.regalloc.OmitFramePointerLinearScanFabric
 import ir.value.*
 import ir.value.constant.*
 
@@ -52,9 +55,36 @@ internal class X64CodeGenerator(val module: LModule, private val ctx: CompileCon
     }
 }
 
+internal class X64CodeGenerationStream(private val ctx: CompileContext, private val out: Appendable) {
+    private val nameAssistant = NameAssistant()
+
+    fun emitFunctions(module: LModule) {
+        val unit = CompilationUnit(nameAssistant)
+        CodeEmitter.declareFunctions(module, unit)
+        CodeEmitter.emitText(module, unit, ctx)
+        unit.emit(out)
+    }
+
+    fun finish(module: LModule) {
+        val unit = CompilationUnit(nameAssistant)
+        CodeEmitter.emitData(module, unit)
+        CodeEmitter.emitNoteSection(unit)
+        unit.emit(out)
+    }
+}
+
 private class CodeEmitter(private val data: FunctionData, private val unit: CompilationUnit, private val ctx: CompileContext): IRInstructionVisitor<Unit>() {
-    private val registerAllocation = data.analysis(LinearScanFabric)
+    private val registerAllocation = if (ctx.omitFramePointer()) {
+        data.analysis(OmitFramePointerLinearScanFabric)
+    } else {
+        data.analysis(LinearScanFabric)
+    }
     private val callInfo = data.analysis(CallInfoAnalysis)
+    private val tailCalls = if (ctx.optimizeSiblingCalls()) {
+        TailCallAnalysis.run(data, registerAllocation)
+    } else {
+        TailCallAnalysisResult(setOf())
+    }
 
     private val asm = unit.function(data.prototype.name)
     private var next: Block? = null
@@ -112,7 +142,28 @@ private class CodeEmitter(private val data: FunctionData, private val unit: Comp
             is ExternFunction -> ExternalFunSymbol(prototype.name())
         }
 
-        asm.callFunction(call, sym)
+        if (tailCalls.isTailCall(call)) {
+            emitEpilogue()
+            asm.tailCallFunction(call, sym)
+        } else {
+            asm.callFunction(call, sym)
+        }
+    }
+
+    private fun callIndirect(call: Callable, pointer: Operand) {
+        if (!tailCalls.isTailCall(call)) {
+            asm.indirectCall(call, pointer)
+            return
+        }
+
+        // Epilogue restores callee save registers, so move the pointer to scratch register before it.
+        when (pointer) {
+            is GPRegister -> asm.copy(POINTER_SIZE, pointer, temp2)
+            is Address    -> asm.mov(POINTER_SIZE, pointer, temp2)
+            else -> throw CodegenException("invalid operand: pointer=$pointer")
+        }
+        emitEpilogue()
+        asm.indirectTailCall(call, temp2)
     }
 
     private fun emitPrologue() {
@@ -122,6 +173,14 @@ private class CodeEmitter(private val data: FunctionData, private val unit: Comp
         // Stack frame layout check.
         //asm.assertStackFrameLayout()
 
+        if (registerAllocation.isFramePointerOmitted()) {
+            // Spilled locals are in the red zone below callee save registers.
+            for (reg in calleeSaveRegisters) {
+                asm.push(QWORD_SIZE, reg)
+            }
+            return
+        }
+
         asm.push(QWORD_SIZE, rbp)
         asm.copy(QWORD_SIZE, rsp, rbp)
 
@@ -139,6 +198,10 @@ private class CodeEmitter(private val data: FunctionData, private val unit: Comp
             asm.pop(QWORD_SIZE, calleeSaveRegisters[idx])
         }
 
+        if (registerAllocation.isFramePointerOmitted()) {
+            return
+        }
+
         asm.leave()
     }
 
@@ -287,10 +350,19 @@ private class CodeEmitter(private val data: FunctionData, private val unit: Comp
         NotCodegen(not.type(), asm)(result, operand)
     }
 
+    override fun visit(bitop: BitOp) {
+        val operand = operand(bitop.operand())
+        val result  = vReg(bitop)
+        BitOpCodegen(bitop.type(), bitop.op(), ctx.march(), asm)(result, operand)
+    }
+
     override fun visit(voidCall: VoidCall) {
         callFunction(voidCall, voidCall.prototype())
+        if (tailCalls.isTailCall(voidCall)) {
+            return
+        }
 
-        assertion(voidCall.target() === next()) {
+        assertion(voidCall.isInBlock() || voidCall.target() === next()) {
             // This is a bug in the compiler if this assertion fails
             "expected invariant failed: call.target=${voidCall.target()}, next=${next()}"
         }
@@ -351,6 +423,11 @@ private class CodeEmitter(private val data: FunctionData, private val unit: Comp
         MemcpyCodegen(memcpy.length(), asm)(dst, src)
     }
 
+    override fun visit(memset: Memset) {
+        val dst = operand(memset.destination())
+        MemsetCodegen(memset.value(), memset.length(), asm)(dst)
+    }
+
     override fun visit(indexedLoad: IndexedLoad) {
         val dst = vReg(indexedLoad)
         val first = operand(indexedLoad.origin())
@@ -437,6 +514,10 @@ private class CodeEmitter(private val data: FunctionData, private val unit: Comp
 
     override fun visit(call: Call) {
         callFunction(call, call.prototype())
+        if (tailCalls.isTailCall(call)) {
+            // Callee returns the value directly to our caller
+            return
+        }
 
         val callOp = operand(call)
         when (val retType = call.type()) {
@@ -445,7 +526,7 @@ private class CodeEmitter(private val data: FunctionData, private val unit: Comp
             is UndefType -> println("UB in call") //TODO remove this
         }
 
-        assertion(call.target() === next()) {
+        assertion(call.isInBlock() || call.target() === next()) {
             // This is a bug in the compiler if this assertion fails
             "expected invariant failed: call.target=${call.target()}, next=${next()}"
         }
@@ -473,7 +554,10 @@ private class CodeEmitter(private val data: FunctionData, private val unit: Comp
 
     override fun visit(indirectionCall: IndirectionCall) {
         val pointer = operand(indirectionCall.pointer())
-        asm.indirectCall(indirectionCall, pointer)
+        callIndirect(indirectionCall, pointer)
+        if (tailCalls.isTailCall(indirectionCall)) {
+            return
+        }
 
         val callOp = operand(indirectionCall)
         when (val retType = indirectionCall.type()) {
@@ -485,7 +569,7 @@ private class CodeEmitter(private val data: FunctionData, private val unit: Comp
 
     override fun visit(indirectionVoidCall: IndirectionVoidCall) {
         val pointer = operand(indirectionVoidCall.pointer())
-        asm.indirectCall(indirectionVoidCall, pointer)
+        callIndirect(indirectionVoidCall, pointer)
     }
 
     override fun visit(store: Store) {
@@ -616,6 +700,10 @@ private class CodeEmitter(private val data: FunctionData, private val unit: Comp
 
     override fun visit(downStackFrame: DownStackFrame) {
         val call = downStackFrame.call()
+        if (tailCalls.isTailCall(call)) {
+            // Arguments are passed in registers only, the frame is torn down right before the jump
+            return
+        }
         val context = callInfo.context(call)
 
         for (arg in context.callerSaveGPRegisters) {
@@ -634,6 +722,9 @@ private class CodeEmitter(private val data: FunctionData, private val unit: Comp
 
     override fun visit(upStackFrame: UpStackFrame) {
         val call = upStackFrame.call()
+        if (tailCalls.isTailCall(call)) {
+            return
+        }
         val context = callInfo.context(call)
 
         val size = context.adjustStackSize()
@@ -778,7 +869,9 @@ private class CodeEmitter(private val data: FunctionData, private val unit: Comp
             }
 
             for (instruction in bb) {
-                asm.comment(instruction.dump())
+                if (ctx.verboseAsm()) {
+                    asm.comment(instruction.dump())
+                }
                 instruction.accept(this)
             }
         }
@@ -786,10 +879,19 @@ private class CodeEmitter(private val data: FunctionData, private val unit: Comp
 
     companion object {
         val temp1 = CallConvention.temp1
+        val temp2 = CallConvention.temp2
         val fpRet = CallConvention.fpRet
 
         fun codegen(module: LModule, ctx: CompileContext): CompilationUnit {
             val unit = CompilationUnit()
+            declareFunctions(module, unit)
+            emitData(module, unit)
+            emitText(module, unit, ctx)
+            emitNoteSection(unit)
+            return unit
+        }
+
+        fun declareFunctions(module: LModule, unit: CompilationUnit) {
             for (data in module.functions()) {
                 if (data.prototype.attributes.contains(GlobalValueAttribute.INTERNAL)) {
                     continue
@@ -797,8 +899,9 @@ private class CodeEmitter(private val data: FunctionData, private val unit: Comp
 
                 unit.global(data.prototype.name)
             }
+        }
 
-            //.data
+        fun emitData(module: LModule, unit: CompilationUnit) {
             unit.section(DataSection)
             for (c in module.constantPool.values) {
                 unit.mkConstant(c)
@@ -806,16 +909,18 @@ private class CodeEmitter(private val data: FunctionData, private val unit: Comp
             for (global in module.globals.values) {
                 unit.makeGlobal(global)
             }
+        }
 
-            //.text
+        fun emitText(module: LModule, unit: CompilationUnit, ctx: CompileContext) {
             unit.section(TextSection)
             for (data in module.functions()) {
                 CodeEmitter(data, unit, ctx).emit()
             }
+        }
 
+        fun emitNoteSection(unit: CompilationUnit) {
             // Ubuntu requires this section to be present
             unit.section(Section("\".note.GNU-stack\"", "\"\"", SectionType.PROGBITS))
-            return unit
         }
     }
 }
\ No newline at end of file
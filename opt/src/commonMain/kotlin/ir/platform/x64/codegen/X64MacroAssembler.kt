@@ -95,6 +95,16 @@ class X64MacroAssembler(name: String, id: Int): Assembler(name, id), MacroAssemb
         call(func)
     }
 
+    fun tailCallFunction(call: Callable, func: FunSymbol) {
+        emitFPVarargsCount(call)
+        jump(func)
+    }
+
+    fun indirectTailCall(call: Callable, pointer: GPRegister) {
+        emitFPVarargsCount(call)
+        jump(pointer)
+    }
+
     private fun emitFPVarargsCount(call: Callable) {
         if (!call.prototype().attributes.contains(VarArgAttribute)) {
             return
@@ -0,0 +1,185 @@
+package ir.platform.x64.codegen.impl
+
+import asm.x64.*
+import ir.types.*
+import ir.instruction.BitOp
+import ir.instruction.BitOpType
+import ir.Definitions.HWORD_SIZE
+import ir.Definitions.QWORD_SIZE
+import ir.Definitions.WORD_SIZE
+import ir.platform.x64.MArch
+import ir.platform.x64.CpuFeature
+import ir.platform.x64.CallConvention.temp1
+import ir.platform.x64.CallConvention.temp2
+import ir.platform.x64.CallConvention.xmmTemp1
+import ir.platform.x64.codegen.X64MacroAssembler
+import ir.platform.x64.codegen.visitors.GPOperandsVisitorUnaryOp
+
+
+internal class BitOpCodegen(val type: IntegerType, private val op: BitOpType, private val march: MArch, val asm: X64MacroAssembler): GPOperandsVisitorUnaryOp {
+    private val size = type.sizeOf()
+
+    operator fun invoke(dst: Operand, src: Operand) {
+        GPOperandsVisitorUnaryOp.apply(dst, src, this)
+    }
+
+    private fun emit(src: Operand, out: GPRegister) {
+        when (op) {
+            BitOpType.Popcount -> if (march.has(CpuFeature.POPCNT)) {
+                when (src) {
+                    is GPRegister -> asm.popcnt(size, src, out)
+                    is Address    -> asm.popcnt(size, src, out)
+                    else -> default(out, src)
+                }
+            } else {
+                popcountFallback(src, out)
+            }
+            BitOpType.CountTrailingZeros -> when (src) {
+                is GPRegister -> if (march.has(CpuFeature.BMI1)) asm.tzcnt(size, src, out) else asm.bsf(size, src, out)
+                is Address    -> if (march.has(CpuFeature.BMI1)) asm.tzcnt(size, src, out) else asm.bsf(size, src, out)
+                else -> default(out, src)
+            }
+            BitOpType.CountLeadingZeros -> {
+                when (src) {
+                    is GPRegister -> if (march.has(CpuFeature.LZCNT)) asm.lzcnt(size, src, out) else asm.bsr(size, src, out)
+                    is Address    -> if (march.has(CpuFeature.LZCNT)) asm.lzcnt(size, src, out) else asm.bsr(size, src, out)
+                    else -> default(out, src)
+                }
+                if (!march.has(CpuFeature.LZCNT)) {
+                    // 'bsr' returns index of the highest set bit: clz(x) = (bits - 1) - bsr(x)
+                    asm.xor(size, Imm32.of(size * 8L - 1), out)
+                }
+            }
+            BitOpType.ByteSwap -> {
+                when (src) {
+                    is GPRegister -> asm.copy(size, src, out)
+                    is Address    -> asm.mov(size, src, out)
+                    else -> default(out, src)
+                }
+                if (size == HWORD_SIZE) {
+                    asm.rol(size, Imm8.of(8), out)
+                } else {
+                    asm.bswap(size, out)
+                }
+            }
+        }
+    }
+
+    /**
+     * Counts bits in parallel when 'popcnt' isn't available.
+     * Reference: https://graphics.stanford.edu/~seander/bithacks.html#CountBitsSetParallel
+     */
+    private fun popcountFallback(src: Operand, out: GPRegister) {
+        when (src) {
+            is GPRegister -> asm.copy(size, src, temp1)
+            is Address    -> asm.mov(size, src, temp1)
+            else -> default(out, src)
+        }
+        if (size == WORD_SIZE) {
+            popcount32()
+            asm.copy(size, temp1, out)
+            return
+        }
+
+        // Count each half separately: all masks fit in imm32 this way.
+        asm.movq(temp1, xmmTemp1)
+        popcount32()
+        asm.movq(xmmTemp1, temp2)
+        asm.movq(temp1, xmmTemp1)
+        asm.copy(QWORD_SIZE, temp2, temp1)
+        asm.shr(QWORD_SIZE, Imm8.of(32), temp1)
+        popcount32()
+        asm.movq(xmmTemp1, temp2)
+        asm.add(QWORD_SIZE, temp2, temp1)
+        asm.copy(size, temp1, out)
+    }
+
+    private fun popcount32() {
+        // x = x - ((x >> 1) & 0x55555555)
+        asm.copy(WORD_SIZE, temp1, temp2)
+        asm.shr(WORD_SIZE, Imm8.of(1), temp2)
+        asm.and(WORD_SIZE, Imm32.of(0x55555555), temp2)
+        asm.sub(WORD_SIZE, temp2, temp1)
+        // x = (x & 0x33333333) + ((x >> 2) & 0x33333333)
+        asm.copy(WORD_SIZE, temp1, temp2)
+        asm.shr(WORD_SIZE, Imm8.of(2), temp2)
+        asm.and(WORD_SIZE, Imm32.of(0x33333333), temp2)
+        asm.and(WORD_SIZE, Imm32.of(0x33333333), temp1)
+        asm.add(WORD_SIZE, temp2, temp1)
+        // x = (x + (x >> 4)) & 0x0f0f0f0f
+        asm.copy(WORD_SIZE, temp1, temp2)
+        asm.shr(WORD_SIZE, Imm8.of(4), temp2)
+        asm.add(WORD_SIZE, temp2, temp1)
+        asm.and(WORD_SIZE, Imm32.of(0x0f0f0f0f), temp1)
+        // x = (x * 0x01010101) >> 24
+        asm.imul(WORD_SIZE, Imm32.of(0x01010101), temp1, temp1)
+        asm.shr(WORD_SIZE, Imm8.of(24), temp1)
+    }
+
+    private fun evaluate(value: Long): Long = when (op) {
+        BitOpType.Popcount -> when (size) {
+            QWORD_SIZE -> value.countOneBits().toLong()
+            else       -> value.toInt().countOneBits().toLong()
+        }
+        BitOpType.CountTrailingZeros -> when (size) {
+            QWORD_SIZE -> value.countTrailingZeroBits().toLong()
+            else       -> value.toInt().countTrailingZeroBits().toLong()
+        }
+        BitOpType.CountLeadingZeros -> when (size) {
+            QWORD_SIZE -> value.countLeadingZeroBits().toLong()
+            else       -> value.toInt().countLeadingZeroBits().toLong()
+        }
+        BitOpType.ByteSwap -> when (size) {
+            QWORD_SIZE -> reverseBytes(value, QWORD_SIZE)
+            WORD_SIZE  -> reverseBytes(value, WORD_SIZE).toInt().toLong()
+            else       -> reverseBytes(value, HWORD_SIZE).toShort().toLong()
+        }
+    }
+
+    private fun reverseBytes(value: Long, bytes: Int): Long {
+        var result = 0L
+        var rest = value
+        repeat(bytes) {
+            result = (result shl 8) or (rest and 0xFF)
+            rest = rest ushr 8
+        }
+
+        return result
+    }
+
+    override fun rr(dst: GPRegister, src: GPRegister) {
+        emit(src, dst)
+    }
+
+    override fun ra(dst: GPRegister, src: Address) {
+        emit(src, dst)
+    }
+
+    override fun ar(dst: Address, src: GPRegister) {
+        emit(src, temp1)
+        asm.mov(size, temp1, dst)
+    }
+
+    override fun aa(dst: Address, src: Address) {
+        emit(src, temp1)
+        asm.mov(size, temp1, dst)
+    }
+
+    override fun ri(dst: GPRegister, src: Imm) {
+        asm.copy(size, Imm64.of(evaluate(src.value())), dst)
+    }
+
+    override fun ai(dst: Address, src: Imm) {
+        val result = evaluate(src.value())
+        if (Imm.canBeImm32(result)) {
+            asm.mov(size, Imm32.of(result), dst)
+        } else {
+            asm.mov(size, Imm64.of(result), temp1)
+            asm.mov(size, temp1, dst)
+        }
+    }
+
+    override fun default(dst: Operand, src: Operand) {
+        throw RuntimeException("Internal error: '${BitOp.NAME} $op' dst=$dst, src=$src")
+    }
+}
@@ -0,0 +1,101 @@
+package ir.platform.x64.codegen.impl
+
+import asm.x64.*
+import asm.x64.GPRegister.*
+import ir.Definitions.BYTE_SIZE
+import ir.Definitions.HWORD_SIZE
+import ir.Definitions.POINTER_SIZE
+import ir.Definitions.QWORD_SIZE
+import ir.Definitions.WORD_SIZE
+import ir.instruction.Memset
+import ir.value.constant.U8Value
+import ir.value.constant.UnsignedIntegerConstant
+import ir.platform.x64.CallConvention.temp1
+import ir.platform.x64.CallConvention.temp2
+import ir.platform.x64.CallConvention.xmmTemp1
+import ir.platform.x64.codegen.CodegenException
+import ir.platform.x64.codegen.X64MacroAssembler
+
+
+internal class MemsetCodegen(value: U8Value, length: UnsignedIntegerConstant, val asm: X64MacroAssembler) {
+    private val fill = value.u8.toLong() and 0xFF
+    private val size = length.value()
+
+    operator fun invoke(dst: Operand) {
+        if (size >= REP_STOS_THRESHOLD) {
+            repStos(dst)
+            return
+        }
+
+        val base = when (dst) {
+            is GPRegister -> dst
+            is Address -> {
+                asm.mov(POINTER_SIZE, dst, temp2)
+                temp2
+            }
+            else -> throw CodegenException("Internal error: '${Memset.NAME}' dst=$dst")
+        }
+
+        if (fill == 0L && size >= XMM_SIZE) {
+            xmmStores(base)
+        } else {
+            scalarStores(base, 0)
+        }
+    }
+
+    private fun pattern(): Long {
+        var result = 0L
+        for (i in 0 until QWORD_SIZE) {
+            result = result or (fill shl (i * 8))
+        }
+
+        return result
+    }
+
+    private fun xmmStores(base: GPRegister) {
+        asm.pxor(xmmTemp1, xmmTemp1)
+        val iterations = size / XMM_SIZE
+        for (i in 0 until iterations.toInt()) {
+            asm.movdqu(xmmTemp1, Address.from(base, i * XMM_SIZE))
+        }
+
+        scalarStores(base, iterations.toInt() * XMM_SIZE)
+    }
+
+    private fun scalarStores(base: GPRegister, from: Int) {
+        if (from.toLong() == size) {
+            return
+        }
+
+        asm.mov(QWORD_SIZE, Imm64.of(pattern()), temp1)
+        var offset = from
+        for (chunk in arrayOf(QWORD_SIZE, WORD_SIZE, HWORD_SIZE, BYTE_SIZE)) {
+            while (size - offset >= chunk) {
+                asm.mov(chunk, temp1, Address.from(base, offset))
+                offset += chunk
+            }
+        }
+    }
+
+    private fun repStos(dst: Operand) {
+        // 'rep stosb' uses rdi, rcx and al implicitly. rdi and rcx may hold live values, so keep them in scratch registers.
+        asm.copy(POINTER_SIZE, rdi, temp2)
+        asm.movq(rcx, xmmTemp1)
+        when (dst) {
+            is GPRegister -> asm.copy(POINTER_SIZE, dst, rdi)
+            is Address    -> asm.mov(POINTER_SIZE, dst, rdi)
+            else -> throw CodegenException("Internal error: '${Memset.NAME}' dst=$dst")
+        }
+        asm.mov(POINTER_SIZE, Imm64.of(size), rcx)
+        asm.mov(WORD_SIZE, Imm32.of(fill), temp1)
+        asm.repStosb()
+
+        asm.copy(POINTER_SIZE, temp2, rdi)
+        asm.movq(xmmTemp1, rcx)
+    }
+
+    companion object {
+        private const val XMM_SIZE = 16
+        private const val REP_STOS_THRESHOLD = 256
+    }
+}
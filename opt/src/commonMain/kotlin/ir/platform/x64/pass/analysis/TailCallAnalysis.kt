@@ -0,0 +1,137 @@
+package ir.platform.x64.pass.analysis
+
+import asm.x64.Address
+import ir.value.*
+import ir.instruction.*
+import ir.attributes.ByValue
+import ir.module.FunctionData
+import ir.module.block.Block
+import ir.instruction.lir.Generate
+import ir.platform.x64.pass.analysis.regalloc.RegisterAllocation
+
+
+internal class TailCallAnalysisResult(private val tailCalls: Set<Callable>) {
+    fun isTailCall(call: Callable): Boolean = tailCalls.contains(call)
+}
+
+/**
+ * Finds calls which result is returned from the function immediately.
+ * Such calls can be replaced by 'jmp' after the frame is torn down.
+ */
+internal class TailCallAnalysis private constructor(private val cfg: FunctionData, private val registerAllocation: RegisterAllocation) {
+    private val tailCalls = hashSetOf<Callable>()
+
+    private fun hasStackSlots(): Boolean {
+        // Callee might get an address of the caller's stack slot, so the frame must stay alive
+        for (bb in cfg) {
+            for (inst in bb) {
+                if (inst is Generate) {
+                    return true
+                }
+            }
+        }
+
+        return false
+    }
+
+    private fun isCandidate(call: Callable): Boolean {
+        if (call !is Call && call !is VoidCall && call !is IndirectionCall && call !is IndirectionVoidCall) {
+            return false
+        }
+        if (call.attributes().any { it is ByValue }) {
+            return false
+        }
+
+        // Callee's stack-argument area has to fit the caller's one. Keep it simple: allow only register arguments.
+        for (arg in call.arguments()) {
+            if (arg !is LocalValue) {
+                continue
+            }
+            if (registerAllocation.vRegOrNull(arg) is Address) {
+                return false
+            }
+        }
+
+        return true
+    }
+
+    /**
+     * Walks from the call to the return instruction. Only stack frame adjustment, copies of the call result,
+     * unconditional branches and phi functions of the call result are allowed on the way.
+     */
+    private fun isReturnedImmediately(call: Callable): Boolean {
+        call as TerminateInstruction
+        var returned: Value? = call as? LocalValue
+        var prev: Block = call.owner()
+        var inst: Instruction? = if (call.isInBlock()) call.next() else call.target().begin()
+        val visited = hashSetOf<Block>()
+        while (inst != null) {
+            when (inst) {
+                is UpStackFrame -> {}
+                is Copy -> {
+                    if (returned == null || inst.operand() != returned || inst.type() != returned.type()) {
+                        return false
+                    }
+                    returned = inst
+                }
+                is Phi -> {
+                    if (returned == null) {
+                        return false
+                    }
+                    var found = false
+                    inst.zip { incoming, value ->
+                        if (incoming == prev && value == returned) {
+                            found = true
+                        }
+                    }
+                    if (!found) {
+                        return false
+                    }
+                    returned = inst
+                }
+                is Branch -> {
+                    if (!visited.add(inst.target())) {
+                        return false
+                    }
+                    prev = inst.owner()
+                    inst = inst.target().begin()
+                    continue
+                }
+                is ReturnValue -> return returned != null && inst.operands().size == 1 && inst.returnValue(0) == returned
+                is ReturnVoid -> return returned == null
+                else -> return false
+            }
+
+            inst = inst.next()
+        }
+
+        return false
+    }
+
+    private fun pass(): TailCallAnalysisResult {
+        if (hasStackSlots()) {
+            return TailCallAnalysisResult(tailCalls)
+        }
+
+        for (bb in cfg) {
+            for (inst in bb) {
+                if (inst !is Callable) {
+                    continue
+                }
+                if (!isCandidate(inst) || !isReturnedImmediately(inst)) {
+                    continue
+                }
+
+                tailCalls.add(inst)
+            }
+        }
+
+        return TailCallAnalysisResult(tailCalls)
+    }
+
+    companion object {
+        fun run(cfg: FunctionData, registerAllocation: RegisterAllocation): TailCallAnalysisResult {
+            return TailCallAnalysis(cfg, registerAllocation).pass()
+        }
+    }
+}
@@ -2,13 +2,18 @@ package ir.platform.x64.pass.analysis.callinfo
 
 import asm.x64.*
 import common.assertion
+import common.idSetOf
 import ir.Definitions
 import ir.Definitions.POINTER_SIZE
 import ir.Definitions.QWORD_SIZE
 import ir.instruction.Callable
+import ir.instruction.Instruction
+import ir.instruction.Phi
 import ir.module.FunctionData
+import ir.module.block.Block
 import ir.module.Sensitivity
 import ir.pass.analysis.LivenessAnalysisPassFabric
+import ir.pass.analysis.ValueNumberingFabric
 import ir.pass.common.AnalysisType
 import ir.pass.common.FunctionAnalysisPass
 import ir.pass.common.FunctionAnalysisPassFabric
@@ -22,8 +27,9 @@ import ir.value.LocalValue
 
 
 private class CallInfoAnalysisImpl(private val data: FunctionData): FunctionAnalysisPass<CallInfo>() {
-    private val registerAllocation = data.analysis(LinearScanFabric)
+    private val registerAllocation by lazy { data.analysis(LinearScanFabric) }
     private val liveness = data.analysis(LivenessAnalysisPassFabric)
+    private val numbering = data.analysis(ValueNumberingFabric)
 
     private val savedContexts = hashMapOf<Callable, SavedContext>()
 
@@ -107,16 +113,50 @@ private class CallInfoAnalysisImpl(private val data: FunctionData): FunctionAnal
         return SavedContext(registers, xmmRegisters, frameSize, overflowAreaSize(call))
     }
 
+    /**
+     * Walks the block backward starting from its live-out set,
+     * so calls in the middle of the block see values which are used after them in the same block.
+     */
+    private fun evaluateSavedContexts(bb: Block) {
+        val live = idSetOf(numbering)
+        live.addAll(liveness.liveOut(bb))
+
+        var inst: Instruction? = bb.last()
+        while (inst != null) {
+            if (inst is Callable) {
+                savedContexts[inst] = callerSaveRegisters(live, inst)
+            }
+            if (inst is LocalValue) {
+                live.remove(inst)
+            }
+            if (inst !is Phi) {
+                for (operand in inst.operands()) {
+                    if (operand !is LocalValue) {
+                        continue
+                    }
+
+                    live.add(operand)
+                }
+            }
+
+            inst = inst.prev()
+        }
+    }
+
     override fun run(): CallInfo {
         for (bb in data) {
-            for (inst in bb) {
-                if (inst !is Callable) {
-                    continue
-                }
+            if (bb.any { it is Callable && it.isInBlock() }) {
+                evaluateSavedContexts(bb)
+                continue
+            }
 
-                val liveOut = liveness.liveOut(inst.owner())
-                savedContexts[inst] = callerSaveRegisters(liveOut, inst)
+            val last = bb.last()
+            if (last !is Callable) {
+                continue
             }
+
+            // The call terminates the block, so live-out set of the block is live across the call
+            savedContexts[last] = callerSaveRegisters(liveness.liveOut(bb), last)
         }
 
         return CallInfo(savedContexts, data.marker())
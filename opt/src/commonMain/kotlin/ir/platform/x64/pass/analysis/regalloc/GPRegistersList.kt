@@ -4,11 +4,15 @@ import asm.x64.*
 import ir.platform.x64.CallConvention
 
 
-internal class GPRegistersList(usedArgumentRegisters: List<GPRegister>) {
+internal class GPRegistersList(usedArgumentRegisters: List<GPRegister>, omitFramePointer: Boolean) {
     private var freeRegisters = CallConvention.availableRegisters(usedArgumentRegisters).toMutableList()
     private val usedCalleeSaveRegisters = hashSetOf<GPRegister>()
 
     init {
+        if (omitFramePointer) {
+            // rbp isn't a frame pointer anymore. Put it first, so it is picked last.
+            freeRegisters.add(0, GPRegister.rbp)
+        }
         for (reg in usedArgumentRegisters) {
             if (CallConvention.gpCalleeSaveRegs.contains(reg)) {
                 usedCalleeSaveRegisters.add(reg)
@@ -7,7 +7,9 @@ import ir.value.LocalValue
 import asm.x64.GPRegister.rcx
 import asm.x64.GPRegister.rdx
 import asm.x64.VReg
+import asm.x64.Address
 import common.assertion
+import common.idMapOf
 import common.forEachWith
 import ir.instruction.*
 import ir.value.asType
@@ -15,18 +17,20 @@ import ir.module.FunctionData
 import ir.instruction.lir.Generate
 import ir.instruction.lir.Lea
 import ir.module.Sensitivity
+import ir.pass.analysis.ValueNumberingFabric
 import ir.pass.analysis.intervals.LiveIntervalsFabric
 import ir.pass.analysis.intervals.LiveRange
+import ir.platform.x64.CallConvention.RED_ZONE_SIZE
 import ir.platform.x64.pass.analysis.FixedRegisterInstructionsAnalysis
 
 
-private class LinearScan(private val data: FunctionData): FunctionAnalysisPass<RegisterAllocation>() {
+private class LinearScan(private val data: FunctionData, private val omitFramePointer: Boolean): FunctionAnalysisPass<RegisterAllocation>() {
     private val liveRanges = data.analysis(LiveIntervalsFabric)
     private val fixedRegistersInfo = FixedRegisterInstructionsAnalysis.run(data)
 
-    private val registerMap = hashMapOf<LocalValue, VReg>()
+    private val registerMap = idMapOf<LocalValue, VReg>(data.analysis(ValueNumberingFabric))
     private val active      = linkedMapOf<LocalValue, VReg>()
-    private val pool        = VirtualRegistersPool.create(data.arguments())
+    private val pool        = VirtualRegistersPool.create(data.arguments(), omitFramePointer)
 
     private val activeFixedIntervals = arrayListOf<Pair<LiveRange, VReg>>()
 
@@ -39,6 +43,7 @@ private class LinearScan(private val data: FunctionData): FunctionAnalysisPass<R
             pool.spilledLocalsAreaSize(),
             registerMap,
             pool.usedGPCalleeSaveRegisters(),
+            omitFramePointer,
             data.marker()
         )
     }
@@ -70,8 +75,11 @@ private class LinearScan(private val data: FunctionData): FunctionAnalysisPass<R
 
     private fun allocFixedRegisters() {
         for (bb in data) {
-            val inst = bb.last()
-            if (inst is Callable) {
+            for (inst in bb) {
+                if (inst !is Callable) {
+                    continue
+                }
+
                 allocFunctionArguments(inst)
             }
         }
@@ -179,6 +187,51 @@ object LinearScanFabric: FunctionAnalysisPassFabric<RegisterAllocation>() {
     }
 
     override fun create(functionData: FunctionData): RegisterAllocation {
-        return LinearScan(functionData).run()
+        return LinearScan(functionData, false).run()
+    }
+}
+
+/**
+ * Register allocation for '-fomit-frame-pointer'.
+ * Leaf functions get rsp-addressed frame in the red zone and rbp as an allocatable register,
+ * others fall back to the cached [LinearScanFabric] result, so call info analysis sees the same allocation.
+ * The frame layouts differ, so the fabric has its own cache slot.
+ */
+object OmitFramePointerLinearScanFabric: FunctionAnalysisPassFabric<RegisterAllocation>() {
+    override fun type(): AnalysisType {
+        return AnalysisType.OMIT_FRAME_POINTER_LINEAR_SCAN
+    }
+
+    override fun sensitivity(): Sensitivity {
+        return Sensitivity.CONTROL_AND_DATA_FLOW
+    }
+
+    private fun isLeaf(functionData: FunctionData): Boolean {
+        for (bb in functionData) {
+            for (inst in bb) {
+                if (inst is Callable || inst is Intrinsic) {
+                    return false
+                }
+            }
+        }
+
+        return true
+    }
+
+    private fun hasStackArguments(functionData: FunctionData): Boolean {
+        return CalleeArgumentAllocator.allocate(functionData.arguments()).any { it is Address }
+    }
+
+    override fun create(functionData: FunctionData): RegisterAllocation {
+        if (!isLeaf(functionData) || hasStackArguments(functionData)) {
+            return functionData.analysis(LinearScanFabric)
+        }
+
+        val allocation = LinearScan(functionData, true).run()
+        if (allocation.spilledLocalsSize() > RED_ZONE_SIZE) {
+            return functionData.analysis(LinearScanFabric)
+        }
+
+        return allocation
     }
 }
\ No newline at end of file
@@ -9,6 +9,7 @@ import ir.pass.common.AnalysisResult
 class RegisterAllocation internal constructor(private val spilledLocalsAreaSize: Int,
                                               private val registerMap: Map<LocalValue, VReg>,
                                               val calleeSaveRegisters: List<GPRegister>,
+                                              private val omitFramePointer: Boolean,
                                               marker: MutationMarker): AnalysisResult(marker) {
     fun spilledLocalsSize(): Int = spilledLocalsAreaSize
 
@@ -16,6 +17,9 @@ class RegisterAllocation internal constructor(private val spilledLocalsAreaSize:
         return calleeSaveRegisters
     }
 
+    /** Returns true if the stack frame is addressed relative to rsp and rbp is allocatable. */
+    fun isFramePointerOmitted(): Boolean = omitFramePointer
+
     fun vRegOrNull(value: LocalValue): VReg? = registerMap[value]
 
     override fun toString(): String = buildString {
@@ -6,8 +6,8 @@ import asm.x64.ArgumentSlot
 import asm.x64.GPRegister.*
 import asm.x64.LocalAddress
 import asm.x64.VReg
-import common.assertion
 import ir.Definitions
+import ir.platform.x64.codegen.CodegenException
 import ir.instruction.lir.Generate
 import ir.types.NonTrivialType
 
@@ -20,7 +20,10 @@ sealed interface StackFrame {
 
     companion object {
         fun create(isBasePointerAddressed: Boolean = true): StackFrame {
-            assertion(isBasePointerAddressed) { "unsupported other approach" }
+            if (!isBasePointerAddressed) {
+                return RedZoneStackFrame()
+            }
+
             return BasePointerAddressedStackFrame()
         }
     }
@@ -71,4 +74,37 @@ private class BasePointerAddressedStackFrame : StackFrame {
     override fun takeArgument(offset: Int): LocalAddress {
         return ArgumentSlot(rsp, offset)
     }
+}
+
+/**
+ * Stack frame of a leaf function without frame pointer.
+ * Slots are addressed relative to rsp and live in the red zone below it, so the prologue doesn't adjust rsp at all.
+ */
+private class RedZoneStackFrame : StackFrame {
+    private var frameSize: Int = 0
+
+    override fun takeSlot(value: LocalValue): LocalAddress {
+        val ty = when (value) {
+            is Generate -> value.type()
+            else -> value.asType<NonTrivialType>()
+        }
+
+        val alignment = ty.alignmentOf()
+        frameSize += ty.sizeOf()
+        if (alignment != 0) {
+            frameSize = Definitions.alignTo(frameSize, alignment)
+        }
+
+        return Address.from(rsp, -frameSize)
+    }
+
+    override fun returnSlot(slot: Address, size: Int) {}
+
+    override fun size(): Int {
+        return frameSize
+    }
+
+    override fun takeArgument(offset: Int): LocalAddress {
+        throw CodegenException("leaf function doesn't pass arguments on stack")
+    }
 }
\ No newline at end of file
@@ -10,9 +10,9 @@ import ir.Definitions.QWORD_SIZE
 import ir.instruction.lir.Generate
 
 
-internal class VirtualRegistersPool private constructor(private val argumentSlots: List<VReg>) {
-    private val frame = StackFrame.create()
-    private val gpRegisters = GPRegistersList(argumentSlots.filterIsInstance<GPRegister>()) //TODO
+internal class VirtualRegistersPool private constructor(private val argumentSlots: List<VReg>, omitFramePointer: Boolean) {
+    private val frame = StackFrame.create(!omitFramePointer)
+    private val gpRegisters = GPRegistersList(argumentSlots.filterIsInstance<GPRegister>(), omitFramePointer) //TODO
     private val xmmRegisters = XmmRegisterList(argumentSlots.filterIsInstance<XmmRegister>()) //TODO
 
     fun allocSlot(value: LocalValue, excludeIf: (Register) -> Boolean): VReg = when (value) {
@@ -55,8 +55,8 @@ internal class VirtualRegistersPool private constructor(private val argumentSlot
     }
 
     companion object {
-        fun create(argumentValues: List<ArgumentValue>): VirtualRegistersPool {
-            return VirtualRegistersPool(CalleeArgumentAllocator.allocate(argumentValues))
+        fun create(argumentValues: List<ArgumentValue>, omitFramePointer: Boolean): VirtualRegistersPool {
+            return VirtualRegistersPool(CalleeArgumentAllocator.allocate(argumentValues), omitFramePointer)
         }
     }
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 package ir.read
 
+import ir.value.constant.U8Value
 import ir.value.constant.UnsignedIntegerConstant
 import ir.types.*
 import ir.instruction.*
@@ -398,6 +399,14 @@ class FunctionBlockReader private constructor(private val iterator: TokenIterato
         builder.neg(currentTok, source, type)
     }
 
+    private fun parseBitOp(currentTok: LocalValueToken) {
+        // %$identifier = bitop {operation} {operand type} {value}
+        val operation = iterator.expect<Identifier>("bit operation")
+        val type      = iterator.expect<IntegerTypeToken>("type")
+        val source    = iterator.expect<AnyValueToken>("source value")
+        builder.bitop(currentTok, operation, source, type)
+    }
+
     private fun parseSelect(currentTok: LocalValueToken) {
         // %$identifier = select u1 <v0>, <t1> <v1>, <t2> <v2>
         iterator.expect<BooleanTypeToken>("'$FlagType' type")
@@ -481,6 +490,24 @@ class FunctionBlockReader private constructor(private val iterator: TokenIterato
         builder.memcpy(dst, dstType, src, srcType, constant)
     }
 
+    private fun parseMemset() {
+        // memset %{dstType} %{dst}, u8 %{value}, %{lengthType} %{length}
+        val dstType = iterator.expect<PointerTypeToken>("destination type")
+        val dst = iterator.expect<ValueToken>("destination value")
+        iterator.expect<Comma>("','")
+
+        val valueType = iterator.expect<UnsignedIntegerTypeToken>("value type")
+        val value = iterator.expect<IntValue>("fill value")
+        val fill = UnsignedIntegerConstant.of(valueType.type(), value.int) as? U8Value
+            ?: throw ParseErrorException("'u8' fill value", valueType)
+        iterator.expect<Comma>("','")
+
+        val lengthType = iterator.expect<UnsignedIntegerTypeToken>("length type")
+        val length = iterator.expect<IntValue>("length value")
+        val constant = UnsignedIntegerConstant.of(lengthType.type(), length.int)
+        builder.memset(dst, dstType, fill, constant)
+    }
+
     private fun parseInstruction(currentTok: Token) = when (currentTok) {
         is LocalValueToken -> {
             iterator.expect<Equal>("'='")
@@ -515,6 +542,7 @@ class FunctionBlockReader private constructor(private val iterator: TokenIterato
                 GetElementPtr.NAME  -> parseGep(currentTok)
                 Neg.NAME            -> parseNeg(currentTok)
                 Not.NAME            -> parseNot(currentTok)
+                BitOp.NAME          -> parseBitOp(currentTok)
                 IntCompare.NAME     -> parseIcmp(currentTok)
                 FloatCompare.NAME   -> parseFcmp(currentTok)
                 GetFieldPtr.NAME    -> parseGfp(currentTok)
@@ -531,6 +559,7 @@ class FunctionBlockReader private constructor(private val iterator: TokenIterato
             Branch.NAME -> parseBranch()
             Switch.NAME -> parseSwitch()
             Memcpy.NAME -> parseMemcpy()
+            Memset.NAME -> parseMemset()
             else        -> throw ParseErrorException("instruction", currentTok)
         }
         else -> throw ParseErrorException("instruction", currentTok)
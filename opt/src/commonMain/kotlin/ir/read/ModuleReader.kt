@@ -7,7 +7,7 @@ import ir.module.SSAModule
 import ir.read.bulder.*
 import ir.read.tokens.*
 import ir.value.constant.*
-import java.io.FileInputStream
+import common.readTextFile
 
 
 class ModuleReader private constructor(string: String) {
@@ -301,9 +301,7 @@ class ModuleReader private constructor(string: String) {
 
     companion object {
         fun read(name: String): SSAModule {
-            val text = FileInputStream(name).use { inputStream ->
-                inputStream.bufferedReader().use { it.readText() }
-            }
+            val text = readTextFile(name)
 
             try {
                 return ModuleReader(text).read()
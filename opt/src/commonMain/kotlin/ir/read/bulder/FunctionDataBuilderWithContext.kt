@@ -96,6 +96,19 @@ class FunctionDataBuilderWithContext private constructor(
         return memorize(name, Not.not(value))
     }
 
+    fun bitop(name: LocalValueToken, operation: Identifier, valueTok: AnyValueToken, expectedType: IntegerTypeToken): BitOp {
+        val op = when (operation.string) {
+            "popcount" -> BitOpType.Popcount
+            "ctz"      -> BitOpType.CountTrailingZeros
+            "clz"      -> BitOpType.CountLeadingZeros
+            "bswap"    -> BitOpType.ByteSwap
+            else -> throw ParseErrorException("${operation.position()} unknown bit operation: op=${operation.string}")
+        }
+
+        val value = getValue(valueTok, expectedType.type())
+        return memorize(name, BitOp.bitop(op, value))
+    }
+
     private fun arithmeticBinary(name: LocalValueToken, a: AnyValueToken, b: AnyValueToken, expectedType: ArithmeticTypeToken, op: (Value, Value) -> InstBuilder<ArithmeticBinary>): ArithmeticBinary {
         val first  = getValue(a, expectedType.type(moduleBuilder))
         val second = getValue(b, expectedType.type(moduleBuilder))
@@ -370,6 +383,11 @@ class FunctionDataBuilderWithContext private constructor(
         bb.put(Memcpy.memcpy(dst, src, lengthTok))
     }
 
+    fun memset(dstTok: AnyValueToken, dstTypeTok: PointerTypeToken, value: U8Value, lengthTok: UnsignedIntegerConstant) {
+        val dst = getValue(dstTok, dstTypeTok.type())
+        bb.put(Memset.memset(dst, value, lengthTok))
+    }
+
     fun int2ptr(name: LocalValueToken, valueTok: AnyValueToken, intType: IntegerTypeToken): Int2Pointer {
         val value = getValue(valueTok, intType.type())
         return memorize(name, Int2Pointer.int2ptr(value))
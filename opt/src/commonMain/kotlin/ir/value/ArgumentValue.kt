@@ -1,12 +1,11 @@
 package ir.value
 
 import ir.types.*
-import ir.instruction.Instruction
 import ir.attributes.ArgumentValueAttribute
 
 
 class ArgumentValue(private val index: Int, private val tp: NonTrivialType, val attributes: Set<ArgumentValueAttribute>): LocalValue {
-    override var usedIn: MutableList<Instruction> = arrayListOf()
+    final override val uses: UseList = UseList()
     override fun name(): String = "arg$index"
 
     override fun type(): NonTrivialType = tp
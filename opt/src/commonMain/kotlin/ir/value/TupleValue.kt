@@ -8,8 +8,8 @@ interface TupleValue: LocalValue {
     override fun type(): TupleType
 
     fun proj(index: Int): Projection? {
-        for (user in usedIn()) {
-            user as Projection
+        uses.forEach { use ->
+            val user = use.user as Projection
             if (user.index() == index) {
                 return user
             }
@@ -18,9 +18,8 @@ interface TupleValue: LocalValue {
     }
 
     fun proj(visitor: (Projection) -> Unit) {
-        for (user in usedIn()) {
-            user as Projection
-            visitor(user)
+        uses.forEach { use ->
+            visitor(use.user as Projection)
         }
     }
 }
\ No newline at end of file
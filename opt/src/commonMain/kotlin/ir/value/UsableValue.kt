@@ -4,39 +4,24 @@ import ir.instruction.Instruction
 
 
 interface UsableValue: Value {
-    var usedIn: MutableList<Instruction>
-
-    fun addUser(instruction: Instruction) {
-        usedIn.add(instruction)
-    }
-
-    fun killUser(instruction: Instruction) {
-        usedIn.remove(instruction)
-    }
-
-    fun release(): List<Instruction> {
-        val result = usedIn
-        usedIn = arrayListOf()
-        return result
-    }
+    val uses: UseList
 
     fun usedIn(): List<Instruction> {
-        return usedIn
+        return uses.users()
     }
 
     fun<V: Value> updateUsages(replacement: V): V {
-        for (user in release()) {
-            for ((idxUse, use) in user.operands().withIndex()) {
-                if (use !== this) {
-                    continue
-                }
-                // New value can use the old value
-                if (user == replacement) {
-                    continue
-                }
-
-                user.update(idxUse, replacement)
+        if (replacement === this) {
+            return replacement
+        }
+
+        uses.forEach { use ->
+            // New value can use the old value
+            if (use.user == replacement) {
+                return@forEach
             }
+
+            use.user.update(use.index, replacement)
         }
         return replacement
     }
@@ -45,4 +30,4 @@ interface UsableValue: Value {
 
     override fun equals(other: Any?): Boolean
     override fun hashCode(): Int
-}
\ No newline at end of file
+}
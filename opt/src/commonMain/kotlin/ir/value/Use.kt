@@ -0,0 +1,90 @@
+package ir.value
+
+import common.assertion
+import ir.instruction.Instruction
+
+
+/**
+ * Operand slot [index] of [user]. Every slot holding a [UsableValue] is linked into the [UseList] of that value,
+ * so replacing or removing a use doesn't scan the users of the value.
+ */
+class Use internal constructor(val user: Instruction, val index: Int) {
+    internal var prev: Use? = null
+    internal var next: Use? = null
+
+    fun next(): Use? = next
+
+    fun value(): Value = user.operand(index)
+
+    override fun toString(): String = "use($index of ${user.dump()})"
+}
+
+/**
+ * Intrusive doubly linked list of uses of a value. Uses go in the order they were added.
+ */
+class UseList {
+    private var head: Use? = null
+    private var tail: Use? = null
+    private var count = 0
+
+    val size: Int
+        get() = count
+
+    fun first(): Use? = head
+
+    fun isEmpty(): Boolean = head == null
+
+    internal fun add(use: Use) {
+        use.prev = tail
+        use.next = null
+        val last = tail
+        if (last == null) {
+            head = use
+        } else {
+            last.next = use
+        }
+        tail = use
+        count += 1
+    }
+
+    internal fun remove(use: Use) {
+        val prev = use.prev
+        val next = use.next
+        assertion(if (prev == null) head === use else prev.next === use) {
+            "$use is not linked"
+        }
+
+        if (prev == null) {
+            head = next
+        } else {
+            prev.next = next
+        }
+        if (next == null) {
+            tail = prev
+        } else {
+            next.prev = prev
+        }
+
+        use.prev = null
+        use.next = null
+        count -= 1
+    }
+
+    /**
+     * Visits uses without allocation. [action] may remove the visited use from the list.
+     */
+    inline fun forEach(action: (Use) -> Unit) {
+        var use = first()
+        while (use != null) {
+            val next = use.next()
+            action(use)
+            use = next
+        }
+    }
+
+    fun users(): List<Instruction> {
+        val result = ArrayList<Instruction>(count)
+        forEach { result.add(it.user) }
+        return result
+    }
+}
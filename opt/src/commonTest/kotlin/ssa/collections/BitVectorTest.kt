@@ -0,0 +1,43 @@
+package ssa.collections
+
+import common.BitVector
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFalse
+import kotlin.test.assertTrue
+
+
+class BitVectorTest {
+    @Test
+    fun testSetOperations() {
+        val a = BitVector(130)
+        a.set(0)
+        a.set(64)
+        a.set(129)
+        assertTrue(a[64])
+        assertFalse(a[63])
+        assertEquals(3, a.cardinality())
+
+        val b = BitVector(130)
+        b.set(1)
+        b.set(64)
+        assertTrue(b.union(a))
+        assertFalse(b.union(a))
+        assertEquals(listOf(0, 1, 64, 129), bits(b))
+
+        val kill = BitVector(130)
+        kill.set(129)
+        val c = BitVector(130)
+        assertTrue(c.unionDifference(b, kill))
+        assertEquals(listOf(0, 1, 64), bits(c))
+
+        c.clear(1)
+        assertEquals(listOf(0, 64), bits(c))
+    }
+
+    private fun bits(vector: BitVector): List<Int> {
+        val result = arrayListOf<Int>()
+        vector.forEachSetBit { result.add(it) }
+        return result
+    }
+}
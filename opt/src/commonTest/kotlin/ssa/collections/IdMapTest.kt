@@ -0,0 +1,77 @@
+package ssa.collections
+
+import common.IdNumbering
+import common.idMapOf
+import common.idSetOf
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFails
+import kotlin.test.assertFalse
+import kotlin.test.assertNull
+import kotlin.test.assertTrue
+
+
+class IdMapTest {
+    private class Item(val id: Int)
+
+    private object ItemNumbering: IdNumbering<Item> {
+        override fun capacity(): Int = 4
+        override fun id(key: Item): Int = key.id
+    }
+
+    @Test
+    fun testMap() {
+        val a = Item(1)
+        val b = Item(6)
+        val map = idMapOf<Item, String>(ItemNumbering)
+        assertEquals(0, map.size)
+
+        map[a] = "a"
+        map[b] = "b"
+        assertEquals(2, map.size)
+        assertEquals("a", map[a])
+        assertEquals("b", map[b])
+        assertNull(map[Item(1)])
+
+        val keys = arrayListOf<Item>()
+        map.forEachEntry { k, _ -> keys.add(k) }
+        assertEquals(listOf(a, b), keys)
+
+        assertEquals("a", map.remove(a))
+        assertEquals(1, map.size)
+        assertFalse(map.containsKey(a))
+    }
+
+    @Test
+    fun testSet() {
+        val a = Item(0)
+        val b = Item(3)
+        val set = idSetOf(ItemNumbering)
+        assertTrue(set.add(b))
+        assertTrue(set.add(a))
+        assertFalse(set.add(a))
+        assertEquals(listOf(a, b), set.toList())
+
+        val other = idSetOf(ItemNumbering)
+        other.add(b)
+        assertTrue(set.removeAll(other))
+        assertEquals(setOf(a), set)
+        assertFalse(set.contains(Item(0)))
+    }
+
+    @Test
+    fun testIdCollision() {
+        val a = Item(2)
+        val b = Item(2)
+        val map = idMapOf<Item, String>(ItemNumbering)
+        map[a] = "a"
+        map[a] = "a1"
+        assertEquals(1, map.size)
+        assertFails { map[b] = "b" }
+
+        val set = idSetOf(ItemNumbering)
+        set.add(a)
+        assertFalse(set.add(a))
+        assertFails { set.add(b) }
+    }
+}
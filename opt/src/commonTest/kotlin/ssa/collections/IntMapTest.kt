@@ -3,6 +3,8 @@ package ssa.collections
 import common.intMapOf
 import kotlin.test.Test
 import kotlin.test.assertEquals
+import kotlin.test.assertNull
+import kotlin.test.assertTrue
 
 
 class IntMapTest {
@@ -27,4 +29,33 @@ class IntMapTest {
             assertEquals(2, v)
         }
     }
-}
\ No newline at end of file
+
+    @Test
+    fun testViewsFollowMutations() {
+        val map = intMapOf<Int, String>(2) { it }
+        val keys = map.keys
+        map[0] = "a"
+        map[5] = "b"
+        assertEquals(2, map.size)
+        assertEquals(listOf(0, 5), keys.toList())
+        assertNull(map[7])
+
+        val iterator = map.entries.iterator()
+        iterator.next()
+        iterator.remove()
+        assertEquals(1, map.size)
+        assertEquals(listOf("b"), map.values.toList())
+
+        var visited = 0
+        map.forEachEntry { k, v ->
+            assertEquals(5, k)
+            assertEquals("b", v)
+            visited += 1
+        }
+        assertEquals(1, visited)
+
+        map.clear()
+        assertTrue(map.isEmpty())
+        assertTrue(keys.isEmpty())
+    }
+}
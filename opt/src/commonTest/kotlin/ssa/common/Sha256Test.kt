@@ -0,0 +1,50 @@
+package ssa.common
+
+import common.Sha256
+import kotlin.test.Test
+import kotlin.test.assertEquals
+
+
+class Sha256Test {
+    @Test
+    fun testEmpty() {
+        assertEquals("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", Sha256().hexDigest())
+        assertEquals("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", Sha256().update("").hexDigest())
+    }
+
+    @Test
+    fun testOneBlock() {
+        assertEquals("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", Sha256().update("abc").hexDigest())
+    }
+
+    @Test
+    fun testTwoBlocks() {
+        // 56 bytes: the length doesn't fit into the first block after padding.
+        val message = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"
+        assertEquals("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", Sha256().update(message).hexDigest())
+    }
+
+    @Test
+    fun testMillionBytesInChunks() {
+        val chunk = ByteArray(1000) { 'a'.code.toByte() }
+        val sha = Sha256()
+        repeat(1000) {
+            sha.update(chunk)
+        }
+
+        assertEquals("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", sha.hexDigest())
+    }
+
+    @Test
+    fun testSplitUpdates() {
+        val bytes = ByteArray(768) { it.toByte() }
+        val sha = Sha256()
+        sha.update(bytes.copyOfRange(0, 1))
+        sha.update(bytes.copyOfRange(1, 64))
+        sha.update(bytes.copyOfRange(64, 700))
+        sha.update(bytes.copyOfRange(700, 768))
+
+        assertEquals("f3a25aa93aa2fbba28d79260535bbd6a5eb0fc1c24a8b0f04e12b484c1dfe363", sha.hexDigest())
+        assertEquals("f3a25aa93aa2fbba28d79260535bbd6a5eb0fc1c24a8b0f04e12b484c1dfe363", Sha256().update(bytes).hexDigest())
+    }
+}
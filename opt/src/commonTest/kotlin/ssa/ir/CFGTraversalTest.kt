@@ -7,11 +7,13 @@ import ir.module.block.BlockViewer
 import ir.module.builder.impl.ModuleBuilder
 import ir.pass.analysis.VerifySSA
 import ir.pass.analysis.dominance.DominatorTreeFabric
+import ir.pass.analysis.traverse.LinearScanOrderFabric
 import ir.pass.analysis.traverse.PostOrderFabric
 import ir.pass.analysis.traverse.PreOrderFabric
 import ir.types.*
 import kotlin.test.Test
 import kotlin.test.assertEquals
+import kotlin.test.assertFalse
 import kotlin.test.assertTrue
 
 class CFGTraversalTest {
@@ -74,4 +76,32 @@ class CFGTraversalTest {
         assertTrue(domTree.dominates(BlockViewer(0), BlockViewer(2)))
         assertTrue(domTree.dominates(BlockViewer(0), BlockViewer(3)))
     }
-}
\ No newline at end of file
+
+    @Test
+    fun testBlockPositions() {
+        val postorder = withBasicBlocks().analysis(PostOrderFabric)
+        for ((idx, bb) in postorder.withIndex()) {
+            assertEquals(idx, postorder.indexOf(bb))
+            assertTrue(postorder.contains(bb))
+        }
+        assertEquals(-1, postorder.indexOf(BlockViewer(4)))
+    }
+
+    @Test
+    fun testLinearScanOrder() {
+        val fn = withBasicBlocks()
+        val order = fn.analysis(LinearScanOrderFabric)
+        val expectedBegin = listOf(0, 4, 6, 8)
+        val expectedEnd = listOf(3, 5, 7, 9)
+
+        for (bb in fn) {
+            assertEquals(expectedBegin[bb.index], order.begin(bb))
+            assertEquals(expectedEnd[bb.index], order.end(bb))
+            for ((idx, inst) in bb.withIndex()) {
+                assertEquals(order.begin(bb) + idx, order.position(inst))
+            }
+        }
+        assertEquals(10, order.size())
+        assertFalse(fn.analysis(DominatorTreeFabric).dominates(BlockViewer(1), BlockViewer(3)))
+    }
+}
@@ -0,0 +1,51 @@
+package ssa.ir
+
+import ir.attributes.GlobalValueAttribute
+import ir.global.StringLiteralGlobalConstant
+import ir.module.SSAModule
+import ir.module.builder.impl.ModuleBuilder
+import ir.pass.CompileContext
+import ir.pass.PassPipeline
+import ir.pass.transform.DeadGlobalElimination
+import ir.types.*
+import ir.value.constant.I32Value
+import ir.value.constant.PointerLiteral
+import kotlin.test.Test
+import kotlin.test.assertEquals
+
+
+class DeadGlobalEliminationTest {
+    private fun withStaticSymbols(): SSAModule {
+        val moduleBuilder = ModuleBuilder.create()
+        val used = moduleBuilder.addConstant(StringLiteralGlobalConstant(".str0", ArrayType(I8Type, 5), "used"))
+        val unused = moduleBuilder.addConstant(StringLiteralGlobalConstant(".str1", ArrayType(I8Type, 7), "unused"))
+        val counter = moduleBuilder.addGlobalValue("counter", I32Value.of(0), GlobalValueAttribute.INTERNAL)
+        moduleBuilder.addGlobalValue("dead", I32Value.of(0), GlobalValueAttribute.INTERNAL)
+        val message = moduleBuilder.addGlobalValue("message", PointerLiteral.of(used), GlobalValueAttribute.INTERNAL)
+        moduleBuilder.addGlobalValue("pointer", PointerLiteral.of(counter))
+
+        val helper = moduleBuilder.createFunction("helper", PtrType, arrayListOf(), hashSetOf(GlobalValueAttribute.INTERNAL))
+        helper.ret(PtrType, arrayOf(helper.load(PtrType, message)))
+
+        val deadHelper = moduleBuilder.createFunction("deadHelper", PtrType, arrayListOf(), hashSetOf(GlobalValueAttribute.INTERNAL))
+        deadHelper.ret(PtrType, arrayOf(unused))
+
+        val main = moduleBuilder.createFunction("main", I32Type, arrayListOf())
+        val cont = main.createLabel()
+        main.call(helper.prototype(), arrayListOf(), emptySet(), cont)
+        main.switchLabel(cont)
+        main.ret(I32Type, arrayOf(I32Value.of(0)))
+
+        return moduleBuilder.build()
+    }
+
+    @Test
+    fun testRemoveUnreachable() {
+        val pipeline = PassPipeline.create("dge", arrayListOf(DeadGlobalElimination), CompileContext.empty())
+        val module = pipeline.run(withStaticSymbols())
+
+        assertEquals(setOf("main", "helper"), module.functions().map { it.name() }.toSet())
+        assertEquals(setOf(".str0"), module.constantPool.keys)
+        assertEquals(setOf("counter", "message", "pointer"), module.globals.keys)
+    }
+}
@@ -0,0 +1,82 @@
+package ssa.ir
+
+import ir.attributes.GlobalValueAttribute
+import ir.global.GlobalValue
+import ir.global.StringLiteralGlobalConstant
+import ir.instruction.Call
+import ir.link.LinkerException
+import ir.link.ModuleLinker
+import ir.module.FunctionPrototype
+import ir.module.SSAModule
+import ir.module.builder.impl.ModuleBuilder
+import ir.types.*
+import ir.value.constant.I32Value
+import kotlin.test.*
+
+
+class ModuleLinkerTest {
+    private fun withHelper(moduleBuilder: ModuleBuilder) {
+        moduleBuilder.addConstant(StringLiteralGlobalConstant(".str0", ArrayType(I8Type, 6), "hello"))
+        val builder = moduleBuilder.createFunction("helper", I32Type, arrayListOf(), hashSetOf(GlobalValueAttribute.INTERNAL))
+        builder.ret(I32Type, arrayOf(I32Value.of(1)))
+    }
+
+    private fun caller(): SSAModule {
+        val moduleBuilder = ModuleBuilder.create()
+        withHelper(moduleBuilder)
+        val counter = moduleBuilder.addExternValue("counter", I32Type)!!
+        val twice = moduleBuilder.createExternFunction("twice", I32Type, listOf(I32Type), emptySet())
+        val helper = moduleBuilder.findFunction("helper")!!
+
+        val builder = moduleBuilder.createFunction("main", I32Type, arrayListOf())
+        val cont = builder.createLabel()
+        val end = builder.createLabel()
+        val one = builder.call(helper, arrayListOf(), emptySet(), cont)
+        builder.switchLabel(cont)
+        val result = builder.call(twice, arrayListOf(one), emptySet(), end)
+        builder.switchLabel(end)
+        val value = builder.load(I32Type, counter)
+        builder.ret(I32Type, arrayOf(builder.add(result, value)))
+
+        return moduleBuilder.build()
+    }
+
+    private fun callee(): SSAModule {
+        val moduleBuilder = ModuleBuilder.create()
+        withHelper(moduleBuilder)
+        moduleBuilder.addGlobalValue("counter", I32Value.of(2))
+
+        val builder = moduleBuilder.createFunction("twice", I32Type, arrayListOf(I32Type))
+        builder.ret(I32Type, arrayOf(builder.add(builder.argument(0), builder.argument(0))))
+
+        return moduleBuilder.build()
+    }
+
+    @Test
+    fun testResolveExterns() {
+        val linked = ModuleLinker.link(listOf(caller(), callee()))
+
+        assertEquals(setOf("main", "twice", "helper", "helper.1"), linked.functions().map { it.name() }.toSet())
+        assertEquals(setOf(".str0", ".str0.1"), linked.constantPool.keys)
+        assertTrue(linked.externFunctions.isEmpty())
+        assertIs<GlobalValue>(linked.globals["counter"])
+
+        val calls = linked.findFunction("main").flatMap { bb -> bb.filterIsInstance<Call>() }
+        assertEquals(listOf("helper", "twice"), calls.map { it.prototype().name })
+        assertTrue(calls.all { it.prototype() is FunctionPrototype })
+    }
+
+    @Test
+    fun testInternalize() {
+        val linked = ModuleLinker.link(listOf(caller(), callee()), setOf("main"))
+
+        assertFalse(linked.findFunction("main").prototype.attributes.contains(GlobalValueAttribute.INTERNAL))
+        assertTrue(linked.findFunction("twice").prototype.attributes.contains(GlobalValueAttribute.INTERNAL))
+        assertEquals(GlobalValueAttribute.INTERNAL, (linked.globals["counter"] as GlobalValue).attribute())
+    }
+
+    @Test
+    fun testMultipleDefinition() {
+        assertFailsWith<LinkerException> { ModuleLinker.link(listOf(callee(), callee())) }
+    }
+}
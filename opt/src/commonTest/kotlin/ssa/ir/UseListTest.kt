@@ -0,0 +1,85 @@
+package ssa.ir
+
+import ir.module.builder.impl.ModuleBuilder
+import ir.module.builder.impl.FunctionDataBuilder
+import ir.types.*
+import ir.value.Use
+import ir.value.UseList
+import kotlin.test.*
+
+
+class UseListTest {
+    private fun function(): FunctionDataBuilder {
+        val moduleBuilder = ModuleBuilder.create()
+        return moduleBuilder.createFunction("f", I32Type, arrayListOf(I32Type, I32Type))
+    }
+
+    @Test
+    fun testSameValueInSeveralOperands() {
+        val builder = function()
+        val a = builder.argument(0)
+        val sum = builder.add(a, a)
+
+        assertEquals(2, a.uses.size)
+        assertEquals(listOf(sum, sum), a.usedIn())
+        assertEquals(listOf(0, 1), listOf(a.uses.first()!!.index, a.uses.first()!!.next()!!.index))
+        assertNull(a.uses.first()!!.next()!!.next())
+    }
+
+    @Test
+    fun testUpdateOperand() {
+        val builder = function()
+        val a = builder.argument(0)
+        val b = builder.argument(1)
+        val sum = builder.add(a, a)
+
+        sum.update { if (it === a) b else it }
+        assertTrue(a.uses.isEmpty())
+        assertEquals(listOf(sum, sum), b.usedIn())
+        assertEquals(listOf(b, b), sum.operands())
+    }
+
+    @Test
+    fun testUpdateUsages() {
+        val builder = function()
+        val a = builder.argument(0)
+        val b = builder.argument(1)
+        val sum = builder.add(a, a)
+        val product = builder.mul(sum, a)
+
+        a.updateUsages(b)
+        assertTrue(a.uses.isEmpty())
+        assertEquals(0, a.uses.size)
+        assertEquals(listOf(sum, sum, product), b.usedIn())
+        assertEquals(listOf(b, b), sum.operands())
+        assertEquals(listOf(sum, b), product.operands())
+    }
+
+    @Test
+    fun testUnlinkOnRemove() {
+        val builder = function()
+        val a = builder.argument(0)
+        val b = builder.argument(1)
+        val first = builder.add(a, b)
+        val second = builder.add(b, a)
+
+        first.die(first)
+        assertEquals(listOf(second), a.usedIn())
+        assertEquals(listOf(second), b.usedIn())
+
+        second.die(second)
+        assertTrue(a.uses.isEmpty())
+        assertTrue(b.uses.isEmpty())
+    }
+
+    @Test
+    fun testRemoveNotLinkedUse() {
+        val builder = function()
+        val a = builder.argument(0)
+        val sum = builder.add(a, a)
+
+        assertFails { UseList().remove(Use(sum, 0)) }
+        assertFails { a.uses.remove(Use(sum, 0)) }
+        assertEquals(2, a.uses.size)
+    }
+}
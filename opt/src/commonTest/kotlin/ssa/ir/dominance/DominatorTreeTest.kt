@@ -9,6 +9,7 @@ import ir.module.builder.impl.ModuleBuilder
 import ir.pass.CompileContext
 import ir.pass.analysis.VerifySSA
 import ir.pass.analysis.dominance.DominatorTreeFabric
+import ir.pass.transform.CSSAConstructionFabric
 import ir.pass.transform.Mem2RegFabric
 import ir.types.PtrType
 import ir.types.Type
@@ -87,4 +88,34 @@ class DominatorTreeTest {
         //println(originalMem2Reg.toString())
         assertEquals(originalMem2Reg.toString(), copyMem2Reg.toString())
     }
-}
\ No newline at end of file
+
+    @Test
+    fun testPreservedAfterSplitCriticalEdge() {
+        val moduleBuilder = ModuleBuilder.create()
+        val builder = moduleBuilder.createFunction("critical", U16Type, arrayListOf())
+        val b1 = builder.createLabel()
+        val exit = builder.createLabel()
+        val cmp = builder.icmp(I32Value.of(12), IntPredicate.Ne, I32Value.of(43))
+        builder.branchCond(cmp, b1, exit)
+
+        builder.switchLabel(b1)
+        builder.branch(exit)
+
+        builder.switchLabel(exit)
+        builder.ret(U16Type, arrayOf(U16Value.of(0U)))
+        val module = moduleBuilder.build()
+        module.findFunction("critical").analysis(DominatorTreeFabric)
+
+        val transformed = CSSAConstructionFabric.create(module, CompileContext.empty()).runPreserving()
+        val fn = transformed.findFunction("critical")
+        assertEquals(4, fn.size())
+
+        val cached = fn.cache().get(DominatorTreeFabric, fn.marker())!!
+        val expected = fn.analysis(DominatorTreeFabric, useCache = false)
+        for (dominator in fn) {
+            for (target in fn) {
+                assertEquals(expected.dominates(dominator, target), cached.dominates(dominator, target))
+            }
+        }
+    }
+}
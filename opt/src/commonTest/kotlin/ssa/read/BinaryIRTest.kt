@@ -0,0 +1,149 @@
+package ssa.read
+
+import asm.x64.VReg
+import ir.attributes.VarArgAttribute
+import ir.bin.BinaryFormatException
+import ir.bin.ModuleBinaryReader
+import ir.bin.ModuleBinaryWriter
+import ir.global.StringLiteralGlobalConstant
+import ir.instruction.IntPredicate
+import ir.instruction.Intrinsic
+import ir.intrinsic.IntrinsicProvider
+import ir.intrinsic.IntrinsicResolver
+import ir.module.SSAModule
+import ir.module.builder.impl.ModuleBuilder
+import ir.platform.MacroAssembler
+import ir.types.*
+import ir.value.constant.I32Value
+import ir.value.constant.PointerLiteral
+import ir.value.constant.UndefValue
+import kotlin.test.*
+
+
+private class VaStartStub(private val numberOfArgs: Int): IntrinsicProvider("va_start") {
+    override fun <Masm : MacroAssembler> implement(masm: Masm, inputs: List<VReg>) {
+        error("not implemented")
+    }
+
+    override fun parameters(): IntArray = intArrayOf(numberOfArgs)
+}
+
+class BinaryIRTest {
+    private val intrinsics = IntrinsicResolver { name, parameters ->
+        if (name == "va_start" && parameters.size == 1) VaStartStub(parameters[0]) else null
+    }
+
+    private fun withLoop(): SSAModule {
+        val moduleBuilder = ModuleBuilder.create()
+        moduleBuilder.structType("point", listOf(I32Type, I64Type))
+        val message = moduleBuilder.addConstant(StringLiteralGlobalConstant("message", ArrayType(I8Type, 6), "hello"))
+        val global = moduleBuilder.addGlobalValue("pointer", PointerLiteral.of(message))
+        val print = moduleBuilder.createExternFunction("print", VoidType, listOf(PtrType), emptySet())
+
+        val builder = moduleBuilder.createFunction("sum", I32Type, arrayListOf(I32Type))
+        val n = builder.argument(0)
+
+        val header = builder.createLabel()
+        val body = builder.createLabel()
+        val exit = builder.createLabel()
+        val end = builder.createLabel()
+        builder.branch(header)
+
+        builder.switchLabel(header)
+        val i = builder.phi(arrayListOf(I32Value.of(0), UndefValue), I32Type, arrayListOf(builder.begin(), body))
+        val acc = builder.phi(arrayListOf(I32Value.of(0), UndefValue), I32Type, arrayListOf(builder.begin(), body))
+        val cmp = builder.icmp(i, IntPredicate.Lt, n)
+        builder.branchCond(cmp, body, exit)
+
+        builder.switchLabel(body)
+        val nextAcc = builder.add(acc, i)
+        val nextI = builder.add(i, I32Value.of(1))
+        builder.branch(header)
+        i.value(1, nextI)
+        acc.value(1, nextAcc)
+
+        builder.switchLabel(exit)
+        builder.vcall(print, arrayListOf(global), emptySet(), end)
+
+        builder.switchLabel(end)
+        builder.ret(I32Type, arrayOf(acc))
+
+        return moduleBuilder.build()
+    }
+
+    private fun withVarArgs(): SSAModule {
+        val moduleBuilder = ModuleBuilder.create()
+        val printf = moduleBuilder.createExternFunction("printf", I32Type, listOf(PtrType), setOf(VarArgAttribute))
+
+        val builder = moduleBuilder.createFunction("log", I32Type, arrayListOf(PtrType), hashSetOf(VarArgAttribute))
+        val vaList = builder.alloc(ArrayType(I8Type, 24))
+
+        val cont = builder.createLabel()
+        val dead = builder.createLabel()
+        val exit = builder.createLabel()
+        builder.intrinsic(arrayListOf(vaList), VaStartStub(1), cont)
+
+        builder.switchLabel(cont)
+        val printed = builder.call(printf, arrayListOf(builder.argument(0), vaList), setOf(VarArgAttribute), exit)
+
+        builder.switchLabel(dead)
+        builder.branch(exit)
+
+        builder.switchLabel(exit)
+        val result = builder.phi(arrayListOf(printed, I32Value.of(0)), I32Type, arrayListOf(cont, dead))
+        builder.ret(I32Type, arrayOf(result))
+
+        return moduleBuilder.build()
+    }
+
+    @Test
+    fun testRoundTrip() {
+        val module = withLoop()
+        val bytes = ModuleBinaryWriter.write(module)
+        val read = ModuleBinaryReader.read(bytes)
+
+        assertEquals(module.functions().size, read.functions().size)
+        assertEquals(module.globals.keys, read.globals.keys)
+        assertEquals(module.constantPool.keys, read.constantPool.keys)
+        assertEquals(module.externFunctions.keys, read.externFunctions.keys)
+        assertEquals(module.types.keys, read.types.keys)
+
+        val fn = read.findFunction("sum")
+        assertEquals(module.findFunction("sum").prototype, fn.prototype)
+        assertEquals(5, fn.blocks().size())
+
+        assertContentEquals(bytes, ModuleBinaryWriter.write(read))
+        assertEquals(read.toString(), ModuleBinaryReader.read(ModuleBinaryWriter.write(read)).toString())
+    }
+
+    @Test
+    fun testVarArgsRoundTrip() {
+        val module = withVarArgs()
+        val bytes = ModuleBinaryWriter.write(module)
+        val read = ModuleBinaryReader.read(bytes, intrinsics)
+
+        val fn = read.findFunction("log")
+        assertEquals(module.findFunction("log").prototype, fn.prototype)
+        assertEquals(4, fn.blocks().size())
+
+        val intrinsic = fn.begin().last() as Intrinsic
+        assertEquals("va_start", intrinsic.implementor.name)
+        assertContentEquals(intArrayOf(1), intrinsic.implementor.parameters())
+
+        assertContentEquals(bytes, ModuleBinaryWriter.write(read))
+        assertEquals(read.toString(), ModuleBinaryReader.read(ModuleBinaryWriter.write(read), intrinsics).toString())
+    }
+
+    @Test
+    fun testRejectsUnknownIntrinsic() {
+        val bytes = ModuleBinaryWriter.write(withVarArgs())
+        assertFailsWith<BinaryFormatException> { ModuleBinaryReader.read(bytes) }
+    }
+
+    @Test
+    fun testRejectsOtherFormats() {
+        val bytes = ModuleBinaryWriter.write(withLoop())
+        assertFailsWith<BinaryFormatException> { ModuleBinaryReader.read("define void @f()".encodeToByteArray()) }
+        assertFailsWith<BinaryFormatException> { ModuleBinaryReader.read(bytes.copyOf(bytes.size - 1)) }
+    }
+}
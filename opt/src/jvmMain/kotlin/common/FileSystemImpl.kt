@@ -0,0 +1,86 @@
+package common
+
+import java.io.BufferedWriter
+import java.io.File
+import java.nio.file.Files
+import java.nio.file.Path
+import java.nio.file.StandardCopyOption
+import kotlin.io.path.listDirectoryEntries
+
+
+private class JvmTextFileWriter(private val writer: BufferedWriter): TextFileWriter {
+    override fun append(value: Char): Appendable = writer.append(value)
+
+    override fun append(value: CharSequence?): Appendable = writer.append(value)
+
+    override fun append(value: CharSequence?, startIndex: Int, endIndex: Int): Appendable = writer.append(value, startIndex, endIndex)
+
+    override fun close() {
+        writer.close()
+    }
+}
+
+actual fun readTextFile(filename: String): String {
+    return File(filename).readText()
+}
+
+actual fun openTextFile(filename: String): TextFileWriter {
+    return JvmTextFileWriter(File(filename).bufferedWriter())
+}
+
+actual fun readBinaryFile(filename: String): ByteArray {
+    return File(filename).readBytes()
+}
+
+actual fun writeBinaryFile(filename: String, bytes: ByteArray) {
+    File(filename).writeBytes(bytes)
+}
+
+actual fun fileExists(filename: String): Boolean {
+    return File(filename).exists()
+}
+
+actual fun lastModified(filename: String): Long {
+    return File(filename).lastModified()
+}
+
+actual fun touchFile(filename: String) {
+    File(filename).setLastModified(System.currentTimeMillis())
+}
+
+actual fun fileSize(filename: String): Long {
+    return File(filename).length()
+}
+
+actual fun copyFile(src: String, dst: String) {
+    Files.copy(Path.of(src), Path.of(dst), StandardCopyOption.REPLACE_EXISTING)
+}
+
+actual fun renameFile(src: String, dst: String) {
+    Files.move(Path.of(src), Path.of(dst), StandardCopyOption.ATOMIC_MOVE, StandardCopyOption.REPLACE_EXISTING)
+}
+
+actual fun deleteFile(filename: String): Boolean {
+    return Files.deleteIfExists(Path.of(filename))
+}
+
+actual fun deleteRecursively(dirname: String): Boolean {
+    return File(dirname).deleteRecursively()
+}
+
+actual fun createDirectories(dirname: String) {
+    Files.createDirectories(Path.of(dirname))
+}
+
+actual fun listDirectory(dirname: String): List<String> {
+    return Path.of(dirname).listDirectoryEntries().map { it.toString() }
+}
+
+actual fun absolutePath(filename: String): String {
+    return Path.of(filename).toAbsolutePath().normalize().toString()
+}
+
+actual fun createTempFile(prefix: String): String {
+    val tempDir = Path.of(System.getProperty("java.io.tmpdir"))
+    return Files.createTempFile(tempDir, prefix, null).toAbsolutePath().toString()
+}
@@ -0,0 +1,234 @@
+@file:OptIn(ExperimentalForeignApi::class)
+
+package common
+
+import kotlinx.cinterop.*
+import platform.posix.*
+
+
+private const val BUFFER_SIZE = 64 * 1024
+
+private class NativeTextFileWriter(private val file: CPointer<FILE>): TextFileWriter {
+    private val buffer = StringBuilder()
+
+    private fun flushIfFull(): Appendable {
+        if (buffer.length >= BUFFER_SIZE) {
+            flush()
+        }
+
+        return this
+    }
+
+    private fun flush() {
+        if (buffer.isEmpty()) {
+            return
+        }
+
+        val bytes = buffer.toString().encodeToByteArray()
+        bytes.usePinned { pinned ->
+            fwrite(pinned.addressOf(0), 1u, bytes.size.convert(), file)
+        }
+        buffer.clear()
+    }
+
+    override fun append(value: Char): Appendable {
+        buffer.append(value)
+        return flushIfFull()
+    }
+
+    override fun append(value: CharSequence?): Appendable {
+        buffer.append(value)
+        return flushIfFull()
+    }
+
+    override fun append(value: CharSequence?, startIndex: Int, endIndex: Int): Appendable {
+        buffer.append(value, startIndex, endIndex)
+        return flushIfFull()
+    }
+
+    override fun close() {
+        flush()
+        fclose(file)
+    }
+}
+
+private fun openFile(filename: String, mode: String): CPointer<FILE> {
+    return fopen(filename, mode) ?: throw IllegalStateException("Cannot open file '$filename': ${strerror(errno)?.toKString()}")
+}
+
+private fun isDirectory(filename: String): Boolean = memScoped {
+    val st = alloc<stat>()
+    if (stat(filename, st.ptr) != 0) {
+        return false
+    }
+
+    return (st.st_mode and S_IFMT.convert()) == S_IFDIR.convert<UInt>()
+}
+
+actual fun readTextFile(filename: String): String {
+    return readBinaryFile(filename).decodeToString()
+}
+
+actual fun readBinaryFile(filename: String): ByteArray {
+    val file = openFile(filename, "rb")
+    try {
+        fseek(file, 0, SEEK_END)
+        val size = ftell(file).toInt()
+        rewind(file)
+
+        val bytes = ByteArray(size)
+        if (size > 0) {
+            bytes.usePinned { pinned ->
+                fread(pinned.addressOf(0), 1u, size.convert(), file)
+            }
+        }
+        return bytes
+    } finally {
+        fclose(file)
+    }
+}
+
+actual fun writeBinaryFile(filename: String, bytes: ByteArray) {
+    val file = openFile(filename, "wb")
+    try {
+        if (bytes.isNotEmpty()) {
+            bytes.usePinned { pinned ->
+                fwrite(pinned.addressOf(0), 1u, bytes.size.convert(), file)
+            }
+        }
+    } finally {
+        fclose(file)
+    }
+}
+
+actual fun openTextFile(filename: String): TextFileWriter {
+    return NativeTextFileWriter(openFile(filename, "wb"))
+}
+
+actual fun fileExists(filename: String): Boolean {
+    return access(filename, F_OK) == 0
+}
+
+actual fun lastModified(filename: String): Long = memScoped {
+    val st = alloc<stat>()
+    if (stat(filename, st.ptr) != 0) {
+        return 0
+    }
+
+    return st.st_mtim.tv_sec * 1000 + st.st_mtim.tv_nsec / 1_000_000
+}
+
+actual fun touchFile(filename: String) {
+    utimes(filename, null)
+}
+
+actual fun fileSize(filename: String): Long = memScoped {
+    val st = alloc<stat>()
+    if (stat(filename, st.ptr) != 0) {
+        return 0
+    }
+
+    return st.st_size
+}
+
+actual fun copyFile(src: String, dst: String) {
+    val input = openFile(src, "rb")
+    try {
+        val output = openFile(dst, "wb")
+        try {
+            val buffer = ByteArray(BUFFER_SIZE)
+            buffer.usePinned { pinned ->
+                while (true) {
+                    val read = fread(pinned.addressOf(0), 1u, buffer.size.convert(), input)
+                    if (read.toInt() == 0) {
+                        break
+                    }
+
+                    fwrite(pinned.addressOf(0), 1u, read, output)
+                }
+            }
+        } finally {
+            fclose(output)
+        }
+    } finally {
+        fclose(input)
+    }
+}
+
+actual fun renameFile(src: String, dst: String) {
+    if (rename(src, dst) != 0) {
+        throw IllegalStateException("Cannot rename '$src' to '$dst': ${strerror(errno)?.toKString()}")
+    }
+}
+
+actual fun deleteFile(filename: String): Boolean {
+    return unlink(filename) == 0
+}
+
+actual fun deleteRecursively(dirname: String): Boolean {
+    if (!isDirectory(dirname)) {
+        return deleteFile(dirname)
+    }
+
+    for (entry in listDirectory(dirname)) {
+        deleteRecursively(entry)
+    }
+    return rmdir(dirname) == 0
+}
+
+actual fun createDirectories(dirname: String) {
+    val path = StringBuilder()
+    for (segment in absolutePath(dirname).split('/')) {
+        if (segment.isEmpty()) {
+            continue
+        }
+
+        path.append('/').append(segment)
+        if (mkdir(path.toString(), 0x1FFu) != 0 && errno != EEXIST) {
+            throw IllegalStateException("Cannot create directory '$path': ${strerror(errno)?.toKString()}")
+        }
+    }
+}
+
+actual fun listDirectory(dirname: String): List<String> {
+    val dir = opendir(dirname) ?: throw IllegalStateException("Cannot open directory '$dirname'")
+    try {
+        val entries = arrayListOf<String>()
+        while (true) {
+            val entry = readdir(dir) ?: break
+            val name = entry.pointed.d_name.toKString()
+            if (name == "." || name == "..") {
+                continue
+            }
+
+            entries.add(FileUtils.resolve(dirname, name))
+        }
+        return entries
+    } finally {
+        closedir(dir)
+    }
+}
+
+actual fun absolutePath(filename: String): String {
+    if (filename.startsWith('/')) {
+        return FileUtils.normalize(filename)
+    }
+
+    val buffer = ByteArray(PATH_MAX)
+    getcwd(buffer.refTo(0), buffer.size.convert())
+    return FileUtils.normalize(FileUtils.resolve(buffer.toKString(), filename))
+}
+
+actual fun createTempFile(prefix: String): String {
+    val tempDir  = getenv("TMPDIR")?.toKString() ?: "/tmp"
+    val template = FileUtils.resolve(tempDir, "${prefix}XXXXXX").encodeToByteArray() + 0
+    val fd = template.usePinned { pinned ->
+        mkstemp(pinned.addressOf(0))
+    }
+    if (fd == -1) {
+        throw IllegalStateException("Cannot create temporary file in '$tempDir'")
+    }
+
+    close(fd)
+    return template.decodeToString(0, template.size - 1)
+}